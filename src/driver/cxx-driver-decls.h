@@ -36,6 +36,7 @@
 #include "cxx-nodecl-decls.h"
 #include "fortran03-typeenviron-decls.h"
 #include <stddef.h>
+#include <time.h>
 
 MCXX_BEGIN_DECLS
 
@@ -61,6 +62,14 @@ typedef enum source_kind_tag
 } source_kind_t;
 #undef BITMAP
 
+// Format of the Fortran module dependences
+typedef enum fortran_module_deps_tag
+{
+    FORTRAN_MODULE_DEPS_NONE = 0,
+    FORTRAN_MODULE_DEPS_MAKE,
+    FORTRAN_MODULE_DEPS_NINJA,
+} fortran_module_deps_t;
+
 typedef enum source_language_tag
 {
     SOURCE_LANGUAGE_UNKNOWN     = 0,
@@ -98,6 +107,9 @@ struct extensions_table_t
 typedef struct top_level_include_tag
 {
     const char *included_file;
+    // The header as written in the #include, e.g. <stdio.h>, only known
+    // when the preprocessor reports the #include directives
+    const char *included_name;
     char system_include;
 } top_level_include_t;
 
@@ -106,6 +118,11 @@ typedef struct module_to_wrap_info_tag
     const char* module_name;
     const char* native_file;
     const char* mercurium_file;
+
+    // Wrap module being replaced, if any
+    const char* previous_interface_hash;
+    const char* previous_native_hash;
+    time_t previous_mtime;
 } module_to_wrap_info_t;
 
 // Represents one translation unit
@@ -120,9 +137,14 @@ typedef struct translation_unit_tag
 
     int num_top_level_includes;
     top_level_include_t **top_level_include_list;
+    // Maps every file entered through a line marker (a uniquestr) to the
+    // top level include that brought it in
+    dhash_ptr_t *top_level_include_of_file;
 
     // This is a cache of module files actually opened and loaded
     rb_red_blk_tree *module_file_cache;
+    // Intrinsic modules are registered in module_file_cache on demand
+    char intrinsic_modules_registered;
 
     int num_modules_to_wrap;
     module_to_wrap_info_t** modules_to_wrap;
@@ -132,6 +154,10 @@ typedef struct translation_unit_tag
 
     // Opaque pointer used when running compiler phases
     void *dto;
+
+    // Different for every translation unit compiled by this process, so
+    // data kept for a translation unit can be told apart from the current one
+    unsigned int compilation_id;
 } translation_unit_t;
 
 struct compilation_configuration_tag;
@@ -157,6 +183,7 @@ typedef struct debug_options_tag
     char print_scope;
     char enable_debug_code;
     char debug_lexer;
+    char benchmark_lexer;
     char debug_parser;
     char print_nodecl_graphviz;
     char print_nodecl_html;
@@ -179,10 +206,15 @@ typedef struct debug_options_tag
     char print_tdg;
     char tdg_to_json;
     // Others
+    char do_not_cache_tl_source;
     char do_not_codegen;
+    char do_not_index_pragmas;
+    char do_not_skip_phases;
     char show_template_packs;
     char vectorization_verbose;
     char stats_string_table;
+    char stats_koenig_cache;
+    char stats_tl_source;
 } debug_options_t;
 
 extern debug_options_t debug_options;
@@ -277,6 +309,7 @@ typedef struct compilation_process_tag
 
     // Flags
     char parallel_process; // enables features allowing parallel compilation
+    int num_jobs; // maximum number of translation units compiled at the same time
 } compilation_process_t;
 
 typedef struct compilation_configuration_conditional_flags
@@ -511,6 +544,8 @@ typedef struct compilation_configuration_tag
 
     // Enable explicit instantiation
     char explicit_instantiation;
+    // Only instantiate functions whose body must be seen by the compiler
+    char explicit_instantiation_only_needed;
 
     // Disable 'sizeof' computation
     char disable_sizeof;
@@ -581,6 +616,9 @@ typedef struct compilation_configuration_tag
     // same file
     char fortran_no_whole_file;
 
+    // Only print the modules provided and required by every Fortran file
+    fortran_module_deps_t fortran_module_deps;
+
     // Enable IBM XL compatibility
     char xl_compatibility;
 
@@ -589,6 +627,9 @@ typedef struct compilation_configuration_tag
 
     // Emit line markers in the output files
     char line_markers;
+
+    // Emit an #include of the system headers instead of their declarations
+    char include_system_headers;
 } compilation_configuration_t;
 
 struct compiler_phase_loader_tag
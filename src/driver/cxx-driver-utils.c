@@ -62,6 +62,11 @@ typedef struct temporal_file_list_tag
 
 static temporal_file_list_t temporal_file_list = NULL;
 
+void temporal_files_forget(void)
+{
+    temporal_file_list = NULL;
+}
+
 void temporal_files_cleanup(void)
 {
     temporal_file_list_t iter = temporal_file_list;
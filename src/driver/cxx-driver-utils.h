@@ -75,6 +75,10 @@ temporal_file_t new_temporal_file_extension(const char* extension);
 // file is closed and erased.
 void temporal_files_cleanup(void);
 
+// Forgets every temporal file registered so far without removing it.
+// Used by a forked driver so it only removes the files it creates
+void temporal_files_forget(void);
+
 const char* get_extension_filename(const char* filename);
 
 int execute_program(const char* program_name, const char** arguments);
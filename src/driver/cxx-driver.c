@@ -44,6 +44,7 @@
 
 #if !defined(WIN32_BUILD) || defined(__CYGWIN__)
 #include <signal.h>
+#include <sys/wait.h>
 #endif
 
 #ifdef HAVE_MALLINFO
@@ -72,6 +73,7 @@
 #include "cxx-exprtype.h"
 #include "cxx-typededuc.h"
 #include "cxx-overload.h"
+#include "cxx-koenig.h"
 #include "cxx-lexer.h"
 #include "cxx-parser.h"
 #include "c99-parser.h"
@@ -94,6 +96,7 @@
 #include "fortran03-lexer.h"
 #include "fortran03-prettyprint.h"
 #include "fortran03-split.h"
+#include "fortran03-moddeps.h"
 #include "fortran03-buildscope.h"
 #include "fortran03-codegen.h"
 #include "fortran03-typeenviron.h"
@@ -145,6 +148,8 @@
 "  --fpc=<name>             Fortran prescanner <name> will be used\n" \
 "                           for fixed form prescanning\n" \
 "                           This flag is only meaningful for Fortran\n" \
+"                           and it is ignored if fixed form is\n" \
+"                           scanned directly by the Fortran scanner\n" \
 "  --W<flags>,<options>     Pass comma-separated <options> on to\n" \
 "                           the several programs invoked by the driver\n" \
 "                           Flags is a sequence of\n"\
@@ -202,8 +207,13 @@
 "  --help-target-options    Shows valid target options for\n" \
 "                           'target_options' option of configuration\n" \
 "                           file and quits\n" \
-"  --instantiate            Instantiate explicitly templates. This is\n" \
+"  --instantiate[=all]      Instantiate explicitly templates. This is\n" \
 "                           an unsupported experimental feature\n" \
+"  --instantiate=needed     Like --instantiate but only instantiates\n" \
+"                           function templates whose body has to be\n" \
+"                           processed by the compiler (e.g. it\n" \
+"                           contains pragmas). The remaining ones are\n" \
+"                           left to the native compiler\n" \
 "  --pp[=on]                Preprocess files\n"\
 "                           This is the default for files ending with\n"\
 "                           C/C++: .c, .cc, .C, .cp, .cpp, .cxx, .c++\n"\
@@ -282,6 +292,12 @@
 "                           and quits\n" \
 "  --no-whole-file          Fortran front-end does not resolve\n" \
 "                           external procedure calls inside a file\n" \
+"  --fortran-module-deps[=<format>]\n" \
+"                           Do not compile Fortran files. Instead\n" \
+"                           print in the standard output the modules\n" \
+"                           that each file provides and requires.\n" \
+"                           <format> can be 'make' (the default) or\n" \
+"                           'ninja' (a dyndep file)\n" \
 "  --do-not-process-file    The driver will hand the file directly\n" \
 "                           to the native compiler. No further\n" \
 "                           action will be carried by the driver\n" \
@@ -306,10 +322,17 @@
 "  --ifort-compat           Enables some compatibility features\n" \
 "                           required by Intel Fortran\n" \
 "  --line-markers           Adds line markers to the generated file\n" \
+"  --include-system-headers EXPERIMENTAL: in C/C++, emit an #include\n" \
+"                           of the system headers included by the\n" \
+"                           main file instead of their declarations.\n" \
+"                           Requires a preprocessor supporting -dI\n" \
 "  --parallel               EXPERIMENTAL: behave in a way that \n" \
 "                           allows parallel compilation of the same\n" \
 "                           source codes without reusing intermediate\n" \
 "                           filenames\n" \
+"  --jobs=<n>               EXPERIMENTAL: when compiling several C or\n" \
+"                           C++ files with -c, compile up to <n> of\n" \
+"                           them at the same time\n" \
 "  --Xcompiler OPTION       Equivalent to --Wn,OPTION\n" \
 "\n" \
 "Compatibility parameters:\n" \
@@ -400,6 +423,7 @@ typedef enum
     OPTION_FORTRAN_FREE,
     OPTION_FORTRAN_INTEGER_KIND,
     OPTION_FORTRAN_LOGICAL_KIND,
+    OPTION_FORTRAN_MODULE_DEPS,
     OPTION_FORTRAN_NAME_MANGLING,
     OPTION_FORTRAN_PREPROCESSOR,
     OPTION_FORTRAN_PRESCANNER,
@@ -407,7 +431,9 @@ typedef enum
     OPTION_HELP_DEBUG_FLAGS,
     OPTION_HELP_TARGET_OPTIONS,
     OPTION_IFORT_COMPATIBILITY,
+    OPTION_INCLUDE_SYSTEM_HEADERS,
     OPTION_INSTANTIATE_TEMPLATES,
+    OPTION_JOBS,
     OPTION_LINE_MARKERS,
     OPTION_LINKER_NAME,
     OPTION_LIST_ENVIRONMENTS,
@@ -484,7 +510,7 @@ struct command_line_long_options command_line_long_options[] =
     {"opencl", CLP_NO_ARGUMENT, OPTION_ENABLE_OPENCL},
     {"opencl-build-opts",  CLP_REQUIRED_ARGUMENT, OPTION_OPENCL_OPTIONS},
     {"do-not-unload-phases", CLP_NO_ARGUMENT, OPTION_DO_NOT_UNLOAD_PHASES},
-    {"instantiate", CLP_NO_ARGUMENT, OPTION_INSTANTIATE_TEMPLATES},
+    {"instantiate", CLP_OPTIONAL_ARGUMENT, OPTION_INSTANTIATE_TEMPLATES},
     {"pp", CLP_OPTIONAL_ARGUMENT, OPTION_ALWAYS_PREPROCESS},
     {"fpp", CLP_OPTIONAL_ARGUMENT, OPTION_FORTRAN_PREPROCESSOR},
     {"width", CLP_REQUIRED_ARGUMENT, OPTION_FORTRAN_COLUMN_WIDTH},
@@ -513,6 +539,7 @@ struct command_line_long_options command_line_long_options[] =
     {"list-vector-flavors", CLP_NO_ARGUMENT, OPTION_LIST_VECTOR_FLAVORS},
     {"list-vector-flavours", CLP_NO_ARGUMENT, OPTION_LIST_VECTOR_FLAVORS},
     {"no-whole-file", CLP_NO_ARGUMENT, OPTION_NO_WHOLE_FILE },
+    {"fortran-module-deps", CLP_OPTIONAL_ARGUMENT, OPTION_FORTRAN_MODULE_DEPS },
     {"do-not-process-file", CLP_NO_ARGUMENT, OPTION_DO_NOT_PROCESS_FILE },
     {"enable-ms-builtins", CLP_NO_ARGUMENT, OPTION_ENABLE_MS_BUILTIN },
     {"enable-intel-builtins-syntax", CLP_NO_ARGUMENT, OPTION_ENABLE_INTEL_BUILTINS_SYNTAX },
@@ -522,7 +549,9 @@ struct command_line_long_options command_line_long_options[] =
     {"xl-compat", CLP_NO_ARGUMENT, OPTION_XL_COMPATIBILITY },
     {"ifort-compat", CLP_NO_ARGUMENT, OPTION_IFORT_COMPATIBILITY },
     {"line-markers", CLP_NO_ARGUMENT, OPTION_LINE_MARKERS },
+    {"include-system-headers", CLP_NO_ARGUMENT, OPTION_INCLUDE_SYSTEM_HEADERS },
     {"parallel", CLP_NO_ARGUMENT, OPTION_PARALLEL },
+    {"jobs", CLP_REQUIRED_ARGUMENT, OPTION_JOBS },
     {"Xcompiler", CLP_REQUIRED_ARGUMENT, OPTION_XCOMPILER },
     // sentinel
     {NULL, 0, 0}
@@ -563,6 +592,10 @@ static void compiler_phases_pre_execution(
         const char* parsed_filename);
 static const char* preprocess_translation_unit(translation_unit_t* translation_unit, const char* input_filename);
 static void parse_translation_unit(translation_unit_t* translation_unit, const char* parsed_filename);
+static void benchmark_lexer(translation_unit_t* translation_unit, const char* parsed_filename);
+static void fortran_print_module_dependences(translation_unit_t* translation_unit,
+        const char* parsed_filename,
+        char is_fixed_form);
 static void initialize_semantic_analysis(translation_unit_t* translation_unit, const char* parsed_filename);
 static void semantic_analysis(translation_unit_t* translation_unit, const char* parsed_filename);
 static const char* codegen_translation_unit(translation_unit_t* translation_unit, const char* parsed_filename);
@@ -699,6 +732,11 @@ int main(int argc, char* argv[])
         stats_string_table();
     }
 
+    if (debug_options.stats_koenig_cache)
+    {
+        koenig_lookup_cache_stats();
+    }
+
     return compilation_process.execution_result;
 }
 
@@ -1506,7 +1544,25 @@ int parse_arguments(int argc, const char* argv[],
                     }
                 case OPTION_INSTANTIATE_TEMPLATES:
                     {
-                        CURRENT_CONFIGURATION->explicit_instantiation = 1;
+                        if (parameter_info.argument == NULL
+                                || strcmp(parameter_info.argument, "all") == 0)
+                        {
+                            CURRENT_CONFIGURATION->explicit_instantiation = 1;
+                            CURRENT_CONFIGURATION->explicit_instantiation_only_needed = 0;
+                        }
+                        else if (strcmp(parameter_info.argument, "needed") == 0)
+                        {
+                            CURRENT_CONFIGURATION->explicit_instantiation = 1;
+                            CURRENT_CONFIGURATION->explicit_instantiation_only_needed = 1;
+                        }
+                        else
+                        {
+                            fprintf(stderr, "%s: invalid value '%s' for --instantiate. "
+                                    "Valid values are 'all' and 'needed'\n",
+                                    compilation_process.exec_basename,
+                                    parameter_info.argument);
+                            return 1;
+                        }
                         break;
                     }
                 case OPTION_ALWAYS_PREPROCESS:
@@ -1628,6 +1684,30 @@ int parse_arguments(int argc, const char* argv[],
                         CURRENT_CONFIGURATION->fortran_no_whole_file = 1;
                         break;
                     }
+                case OPTION_FORTRAN_MODULE_DEPS:
+                    {
+                        if (parameter_info.argument == NULL
+                                || strcmp(parameter_info.argument, "make") == 0)
+                        {
+                            CURRENT_CONFIGURATION->fortran_module_deps = FORTRAN_MODULE_DEPS_MAKE;
+                        }
+                        else if (strcmp(parameter_info.argument, "ninja") == 0)
+                        {
+                            CURRENT_CONFIGURATION->fortran_module_deps = FORTRAN_MODULE_DEPS_NINJA;
+                        }
+                        else
+                        {
+                            fprintf(stderr, "%s: invalid format '%s' for Fortran module dependences. "
+                                    "Valid formats are 'make' and 'ninja'\n",
+                                    compilation_process.exec_basename,
+                                    parameter_info.argument);
+                            return 1;
+                        }
+                        // Like -E nothing is compiled or linked
+                        CURRENT_CONFIGURATION->do_not_compile = 1;
+                        CURRENT_CONFIGURATION->do_not_link = 1;
+                        break;
+                    }
                 case OPTION_DO_NOT_PROCESS_FILE:
                     {
                         CURRENT_CONFIGURATION->force_source_kind |=
@@ -1654,11 +1734,26 @@ int parse_arguments(int argc, const char* argv[],
                         CURRENT_CONFIGURATION->line_markers = 1;
                         break;
                     }
+                case OPTION_INCLUDE_SYSTEM_HEADERS:
+                    {
+                        CURRENT_CONFIGURATION->include_system_headers = 1;
+                        break;
+                    }
                 case OPTION_PARALLEL:
                     {
                         compilation_process.parallel_process = 1;
                         break;
                     }
+                case OPTION_JOBS:
+                    {
+                        compilation_process.num_jobs = atoi(parameter_info.argument);
+                        if (compilation_process.num_jobs < 1)
+                        {
+                            fprintf(stderr, "Option --jobs requires a positive number. Ignoring\n");
+                            compilation_process.num_jobs = 1;
+                        }
+                        break;
+                    }
                 case OPTION_XCOMPILER:
                     {
                         const char * parameter[] = { uniquestr(parameter_info.argument) };
@@ -3077,6 +3172,9 @@ static void compile_every_translation_unit_aux_(int num_translation_units,
 
         translation_unit_t* translation_unit = CURRENT_COMPILED_FILE;
 
+        static unsigned int num_compilations = 0;
+        translation_unit->compilation_id = ++num_compilations;
+
         // Ensure phases are loaded for current profile
         load_compiler_phases(CURRENT_CONFIGURATION);
 
@@ -3208,7 +3306,17 @@ static void compile_every_translation_unit_aux_(int num_translation_units,
         }
 #endif
 
-        if (!CURRENT_CONFIGURATION->do_not_parse)
+        if (CURRENT_CONFIGURATION->fortran_module_deps != FORTRAN_MODULE_DEPS_NONE)
+        {
+            // * Only scan the file looking for module dependences
+            if (current_extension->source_language == SOURCE_LANGUAGE_FORTRAN
+                    && !CURRENT_CONFIGURATION->pass_through
+                    && !file_not_processed)
+            {
+                fortran_print_module_dependences(translation_unit, parsed_filename, is_fixed_form);
+            }
+        }
+        else if (!CURRENT_CONFIGURATION->do_not_parse)
         {
             if (!CURRENT_CONFIGURATION->pass_through
                     && !file_not_processed)
@@ -3228,6 +3336,11 @@ static void compile_every_translation_unit_aux_(int num_translation_units,
                 // Fill the context with initial information
                 initialize_semantic_analysis(translation_unit, parsed_filename);
 
+                if (debug_options.benchmark_lexer)
+                {
+                    benchmark_lexer(translation_unit, parsed_filename);
+                }
+
                 // * Open file
                 CXX_LANGUAGE()
                 {
@@ -3428,8 +3541,108 @@ static void compile_every_translation_unit_aux_(int num_translation_units,
 #undef return
 }
 
+#if !defined(WIN32_BUILD) || defined(__CYGWIN__)
+// Translation units can only be compiled in different processes if nothing
+// else has to be done with them once compiled: no linking (and so no
+// embedding) and no Fortran, whose modules are shared between files
+static char can_compile_translation_units_in_parallel(void)
+{
+    if (compilation_process.num_jobs <= 1
+            || compilation_process.num_translation_units <= 1
+            || !CURRENT_CONFIGURATION->do_not_link
+            || CURRENT_CONFIGURATION->do_not_parse
+            || CURRENT_CONFIGURATION->fortran_module_deps != FORTRAN_MODULE_DEPS_NONE)
+        return 0;
+
+    int i;
+    for (i = 0; i < compilation_process.num_translation_units; i++)
+    {
+        compilation_file_process_t* file_process = compilation_process.translation_units[i];
+        if (file_process->compilation_configuration->source_language == SOURCE_LANGUAGE_FORTRAN)
+            return 0;
+
+        const char* extension = get_extension_filename(file_process->translation_unit->input_filename);
+        struct extensions_table_t* current_extension = fileextensions_lookup(extension, strlen(extension));
+        if (current_extension == NULL
+                || current_extension->source_language == SOURCE_LANGUAGE_FORTRAN)
+            return 0;
+    }
+
+    return 1;
+}
+
+static void compile_every_translation_unit_in_parallel(void)
+{
+    int num_running = 0;
+    char some_failed = 0;
+
+    int i;
+    for (i = 0; i < compilation_process.num_translation_units; i++)
+    {
+        if (num_running == compilation_process.num_jobs)
+        {
+            int status;
+            if (wait(&status) > 0)
+            {
+                num_running--;
+                if (!WIFEXITED(status)
+                        || WEXITSTATUS(status) != 0)
+                    some_failed = 1;
+            }
+        }
+
+        // Avoid output buffered so far being printed by every child
+        fflush(stdout);
+        fflush(stderr);
+
+        pid_t pid = fork();
+        if (pid < 0)
+        {
+            fatal_error("error: could not fork to compile file '%s' (%s)",
+                    compilation_process.translation_units[i]->translation_unit->input_filename,
+                    strerror(errno));
+        }
+        else if (pid == 0)
+        {
+            // The parent will remove the temporal files registered so far
+            temporal_files_forget();
+
+            compile_every_translation_unit_aux_(1, &compilation_process.translation_units[i]);
+            exit(compilation_process.execution_result);
+        }
+
+        num_running++;
+        compilation_process.translation_units[i]->already_compiled = 1;
+    }
+
+    while (num_running > 0)
+    {
+        int status;
+        if (wait(&status) < 0)
+            break;
+
+        num_running--;
+        if (!WIFEXITED(status)
+                || WEXITSTATUS(status) != 0)
+            some_failed = 1;
+    }
+
+    if (some_failed)
+    {
+        exit(EXIT_FAILURE);
+    }
+}
+#endif
+
 static void compile_every_translation_unit(void)
 {
+#if !defined(WIN32_BUILD) || defined(__CYGWIN__)
+    if (can_compile_translation_units_in_parallel())
+    {
+        compile_every_translation_unit_in_parallel();
+        return;
+    }
+#endif
     compile_every_translation_unit_aux_(compilation_process.num_translation_units,
             compilation_process.translation_units);
 }
@@ -3470,6 +3683,184 @@ static void compiler_phases_execution(
     }
 }
 
+static void benchmark_lexer(translation_unit_t* translation_unit, const char* parsed_filename)
+{
+    int (*open_file_for_scanning)(const char*, const char*) = NULL;
+    int (*lex)(void) = NULL;
+
+    CXX_LANGUAGE()
+    {
+        open_file_for_scanning = mcxx_open_file_for_scanning;
+        lex = mcxxlex;
+    }
+
+    C_LANGUAGE()
+    {
+        open_file_for_scanning = mc99_open_file_for_scanning;
+        lex = mc99lex;
+    }
+
+    if (lex == NULL)
+    {
+        fprintf(stderr, "Lexer benchmark is only available for C/C++\n");
+        return;
+    }
+
+    // The lexer records the top level includes it goes through, keep them
+    // away from the ones recorded when the file is scanned for parsing
+    int saved_num_top_level_includes = translation_unit->num_top_level_includes;
+    top_level_include_t **saved_top_level_include_list = translation_unit->top_level_include_list;
+    dhash_ptr_t *saved_top_level_include_of_file = translation_unit->top_level_include_of_file;
+
+    translation_unit->num_top_level_includes = 0;
+    translation_unit->top_level_include_list = NULL;
+    translation_unit->top_level_include_of_file = NULL;
+
+    timing_t timing_lexer;
+    timing_start(&timing_lexer);
+
+    if (open_file_for_scanning(parsed_filename, translation_unit->input_filename) != 0)
+    {
+        fatal_error("Could not open file '%s'", parsed_filename);
+    }
+
+    unsigned long long num_tokens = 0;
+    while (lex() != 0)
+    {
+        num_tokens++;
+    }
+    // The scanner automatically closes the file
+
+    timing_end(&timing_lexer);
+
+    if (translation_unit->top_level_include_of_file != NULL)
+    {
+        dhash_ptr_destroy(translation_unit->top_level_include_of_file);
+    }
+    int i;
+    for (i = 0; i < translation_unit->num_top_level_includes; i++)
+    {
+        DELETE(translation_unit->top_level_include_list[i]);
+    }
+    DELETE(translation_unit->top_level_include_list);
+
+    translation_unit->num_top_level_includes = saved_num_top_level_includes;
+    translation_unit->top_level_include_list = saved_top_level_include_list;
+    translation_unit->top_level_include_of_file = saved_top_level_include_of_file;
+
+    double elapsed = timing_elapsed(&timing_lexer);
+    fprintf(stderr, "File '%s' ('%s') scanned in %.3f seconds: %llu tokens (%.0f tokens/second)\n",
+            translation_unit->input_filename,
+            parsed_filename,
+            elapsed,
+            num_tokens,
+            elapsed > 0.0 ? (double)num_tokens / elapsed : 0.0);
+}
+
+static void fortran_print_module_files(fortran_module_dependences_t* deps,
+        char provided)
+{
+    int num_modules = provided ? deps->num_provided : deps->num_required;
+    const char** modules = provided ? deps->provided : deps->required;
+    int num_submodules = provided ? deps->num_provided_submodules : deps->num_required_submodules;
+    const char** submodules = provided ? deps->provided_submodules : deps->required_submodules;
+
+    int i;
+    for (i = 0; i < num_modules; i++)
+    {
+        fprintf(stdout, " %s", driver_fortran_get_module_filename(modules[i]));
+    }
+    for (i = 0; i < num_submodules; i++)
+    {
+        fprintf(stdout, " %s", driver_fortran_get_submodule_filename(submodules[i]));
+    }
+}
+
+static void fortran_print_module_dependences(translation_unit_t* translation_unit,
+        const char* parsed_filename,
+        char is_fixed_form)
+{
+    timing_t timing_scan;
+    timing_start(&timing_scan);
+
+    mf03_flex_debug = debug_options.debug_lexer;
+    diagnostics_reset();
+
+    fortran_module_dependences_t deps;
+    fortran_scan_module_dependences(parsed_filename,
+            translation_unit->input_filename,
+            is_fixed_form,
+            &deps);
+
+    // The object file that -c would create
+    const char* object_filename = translation_unit->output_filename;
+    if (object_filename == NULL)
+    {
+        char temp[256];
+        strncpy(temp, give_basename(translation_unit->input_filename), 255);
+        temp[255] = '\0';
+        char* p = strrchr(temp, '.');
+        if (p != NULL)
+        {
+            *p = '\0';
+        }
+        object_filename = strappend(temp, ".o");
+    }
+
+    switch (CURRENT_CONFIGURATION->fortran_module_deps)
+    {
+        case FORTRAN_MODULE_DEPS_MAKE:
+            {
+                // x.o x.mod: x.f90 y.mod
+                fprintf(stdout, "%s", object_filename);
+                fortran_print_module_files(&deps, /* provided */ 1);
+                fprintf(stdout, ": %s", translation_unit->input_filename);
+                fortran_print_module_files(&deps, /* provided */ 0);
+                fprintf(stdout, "\n");
+                break;
+            }
+        case FORTRAN_MODULE_DEPS_NINJA:
+            {
+                // build x.o | x.mod: dyndep | y.mod
+                static char header_printed = 0;
+                if (!header_printed)
+                {
+                    fprintf(stdout, "ninja_dyndep_version = 1\n");
+                    header_printed = 1;
+                }
+
+                fprintf(stdout, "build %s", object_filename);
+                if (deps.num_provided > 0
+                        || deps.num_provided_submodules > 0)
+                {
+                    fprintf(stdout, " |");
+                    fortran_print_module_files(&deps, /* provided */ 1);
+                }
+                fprintf(stdout, ": dyndep");
+                if (deps.num_required > 0
+                        || deps.num_required_submodules > 0)
+                {
+                    fprintf(stdout, " |");
+                    fortran_print_module_files(&deps, /* provided */ 0);
+                }
+                fprintf(stdout, "\n");
+                break;
+            }
+        default:
+            internal_error("Invalid Fortran module dependences format", 0);
+    }
+
+    fortran_free_module_dependences(&deps);
+
+    timing_end(&timing_scan);
+    if (CURRENT_CONFIGURATION->verbose)
+    {
+        fprintf(stderr, "Module dependences of file '%s' found in %.3f seconds\n",
+                translation_unit->input_filename,
+                timing_elapsed(&timing_scan));
+    }
+}
+
 static void parse_translation_unit(translation_unit_t* translation_unit, const char* parsed_filename)
 {
     timing_t timing_parsing;
@@ -4003,6 +4394,9 @@ static const char* preprocess_single_file(const char* input_filename, const char
     // Guarding macros -D_MCC/-D_MCXX/-D_MF03 and -D_MERCURIUM
     num_parameters += 2;
 
+    // -dI
+    num_parameters += 1;
+
     // NULL
     num_parameters += 1;
 
@@ -4038,6 +4432,16 @@ static const char* preprocess_single_file(const char* input_filename, const char
     preprocessor_options[i] = "-D_MERCURIUM";
     i++;
 
+    // Keep the #include directives so the lexer knows how every system
+    // header was included
+    if (CURRENT_CONFIGURATION->include_system_headers
+            && !CURRENT_CONFIGURATION->do_not_parse
+            && !IS_FORTRAN_LANGUAGE)
+    {
+        preprocessor_options[i] = "-dI";
+        i++;
+    }
+
     const char *preprocessed_filename = NULL;
 
     if (!CURRENT_CONFIGURATION->do_not_parse)
@@ -4259,6 +4663,17 @@ static void native_compilation(translation_unit_t* translation_unit,
 
     int num_arguments = num_args_compiler;
 
+    // The system headers included by the generated file must see the same
+    // macros and search directories as when they were preprocessed
+    int num_args_preprocessor = 0;
+    if (CURRENT_CONFIGURATION->include_system_headers
+            && remove_input
+            && !IS_FORTRAN_LANGUAGE)
+    {
+        num_args_preprocessor = count_null_ended_array((void**)CURRENT_CONFIGURATION->preprocessor_options);
+        num_arguments += num_args_preprocessor;
+    }
+
     // This is a directory where we will put the unwrapped native modules
     if (CURRENT_CONFIGURATION->module_native_dir != NULL)
     {
@@ -4349,6 +4764,36 @@ static void native_compilation(translation_unit_t* translation_unit,
         }
     }
 
+    {
+        int i;
+        for (i = 0; i < num_args_preprocessor; i++)
+        {
+            const char* option = CURRENT_CONFIGURATION->preprocessor_options[i];
+            if (strncmp(option, "-D", 2) == 0
+                    || strncmp(option, "-U", 2) == 0
+                    || strncmp(option, "-I", 2) == 0
+                    || strcmp(option, "-isystem") == 0
+                    || strcmp(option, "-idirafter") == 0
+                    || strcmp(option, "-iquote") == 0)
+            {
+                native_compilation_args[ipos] = option;
+                ipos++;
+
+                // The separate argument of -D, -U, -I and -i*
+                if ((strcmp(option, "-D") == 0
+                            || strcmp(option, "-U") == 0
+                            || strcmp(option, "-I") == 0
+                            || option[1] == 'i')
+                        && (i + 1) < num_args_preprocessor)
+                {
+                    i++;
+                    native_compilation_args[ipos] = CURRENT_CONFIGURATION->preprocessor_options[i];
+                    ipos++;
+                }
+            }
+        }
+    }
+
     if (!CURRENT_CONFIGURATION->generate_assembler)
     {
         native_compilation_args[ipos] = uniquestr("-c");
@@ -40,9 +40,13 @@
 #include <fcntl.h>
 
 #include "filename.h"
+#include "fortran03-modules.h"
+
+#include <utime.h>
 
 
 #define ID_FILENAME "MERCURIUM_MODULE"
+#define INTERFACE_FILENAME "MERCURIUM_INTERFACE"
 
 #define LOCK_SUFFIX "_LOCK"
 
@@ -269,52 +273,302 @@ static void unlock_modules(int fd, const char* out_filename)
     unlock_module_name_using_ancillary(fd, out_filename);
 }
 
-static char check_is_mercurium_wrap_module(const char* filename)
+// Wrap modules are tar archives created by wrap_module_file. They are read
+// here directly instead of running tar for every USE
+
+#define TAR_BLOCK_SIZE 512
+
+// Returns 0 to stop walking the archive
+typedef char wrap_module_member_fn(const char* name, FILE* f, unsigned long long size, void *data);
+
+static unsigned long long parse_tar_octal(const char* field, int length)
 {
-    DEBUG_CODE()
+    unsigned long long result = 0;
+    int i;
+    for (i = 0; i < length && field[i] == ' '; i++) { }
+    for (; i < length && field[i] >= '0' && field[i] <= '7'; i++)
     {
-        fprintf(stderr, "DRIVER-FORTRAN: Checking if '%s' is a valid Mercurium wrap module\n",
-                filename);
+        result = result * 8 + (field[i] - '0');
     }
+    return result;
+}
 
-    temporal_file_t temp_file = new_temporal_file();
+static char tar_header_is_valid(const unsigned char* block)
+{
+    unsigned long long checksum = parse_tar_octal((const char*)block + 148, 8);
 
-    const char* arguments[] =
+    unsigned long long sum = 0;
+    int i;
+    for (i = 0; i < TAR_BLOCK_SIZE; i++)
     {
-        "tf",
-        filename,
-        NULL
-    };
+        // The checksum field itself is computed as if it were blanks
+        if (148 <= i && i < 156)
+            sum += ' ';
+        else
+            sum += block[i];
+    }
 
-    if (execute_program_flags("tar", arguments, temp_file->name, NULL) != 0)
-    {
+    return sum == checksum;
+}
+
+// Returns nonzero if the whole archive could be walked
+static char walk_wrap_module(const char* filename, wrap_module_member_fn* fn, void* data)
+{
+    FILE* f = fopen(filename, "rb");
+    if (f == NULL)
         return 0;
+
+    char result = 0;
+    unsigned char block[TAR_BLOCK_SIZE];
+    while (fread(block, TAR_BLOCK_SIZE, 1, f) == 1)
+    {
+        // An empty block marks the end of the archive
+        if (block[0] == '\0')
+        {
+            result = 1;
+            break;
+        }
+
+        if (!tar_header_is_valid(block))
+            break;
+
+        char name[101];
+        memcpy(name, block, 100);
+        name[100] = '\0';
+
+        unsigned long long size = parse_tar_octal((const char*)block + 124, 12);
+        char typeflag = block[156];
+
+        long data_start = ftell(f);
+
+        if (typeflag == '0' || typeflag == '\0')
+        {
+            if (!fn(name, f, size, data))
+            {
+                result = 1;
+                break;
+            }
+        }
+
+        unsigned long long padded_size = ((size + TAR_BLOCK_SIZE - 1) / TAR_BLOCK_SIZE) * TAR_BLOCK_SIZE;
+        if (fseek(f, data_start + padded_size, SEEK_SET) != 0)
+            break;
     }
 
-    FILE* f = fopen(temp_file->name, "r");
-    if (f == NULL)
+    fclose(f);
+
+    return result;
+}
+
+static char find_id_file(const char* name, FILE* f UNUSED_PARAMETER,
+        unsigned long long size UNUSED_PARAMETER, void *data)
+{
+    // Since we use -C . the file will be prepended a "./"
+    if (strcmp(name, "./" ID_FILENAME) == 0)
+    {
+        *(char*)data = 1;
         return 0;
+    }
+    return 1;
+}
+
+static char check_is_mercurium_wrap_module(const char* filename)
+{
+    DEBUG_CODE()
+    {
+        fprintf(stderr, "DRIVER-FORTRAN: Checking if '%s' is a valid Mercurium wrap module\n",
+                filename);
+    }
 
     char result = 0;
+    if (!walk_wrap_module(filename, find_id_file, &result))
+        return 0;
+
+    return result;
+}
+
+static char extract_member(const char* name, FILE* f, unsigned long long size, void *data)
+{
+    const char* directory = (const char*)data;
 
-    char line[256] = { 0 };
-    while (fgets(line, 255, f) != NULL && !result)
+    if (strncmp(name, "./", 2) == 0)
+        name += 2;
+
+    // Only plain files at the top of the archive are expected
+    if (name[0] == '\0'
+            || strchr(name, '/') != NULL)
+        return 1;
+
+    const char* path = strappend(strappend(directory, "/"), name);
+    FILE* out = fopen(path, "wb");
+    if (out == NULL)
     {
-        // Remove endline
-        line[strlen(line) - 1] = '\0';
+        fatal_error("Error when unwrapping module: cannot create '%s'. %s\n", path, strerror(errno));
+    }
 
-        // Since we use -C . the file will be prepended a "./"
-        if (strcmp(line, "./" ID_FILENAME) == 0)
+    char buffer[8192];
+    while (size > 0)
+    {
+        size_t chunk = size < sizeof(buffer) ? (size_t)size : sizeof(buffer);
+        if (fread(buffer, chunk, 1, f) != 1
+                || fwrite(buffer, chunk, 1, out) != 1)
         {
-            result = 1;
+            fatal_error("Error when unwrapping module: cannot extract '%s'\n", path);
         }
+        size -= chunk;
     }
 
+    fclose(out);
+
+    return 1;
+}
+
+void driver_fortran_hash_bytes(uint64_t *hash, const void* data, size_t size)
+{
+    // FNV-1a
+    const unsigned char* p = (const unsigned char*)data;
+    size_t i;
+    for (i = 0; i < size; i++)
+    {
+        *hash ^= p[i];
+        *hash *= 1099511628211ULL;
+    }
+}
+
+const char* driver_fortran_hash_to_str(uint64_t hash)
+{
+    char c[32];
+    snprintf(c, 31, "%016llx", (unsigned long long)hash);
+    c[31] = '\0';
+    return uniquestr(c);
+}
+
+static const char* hash_of_stream(FILE* f, unsigned long long size)
+{
+    uint64_t hash = 14695981039346656037ULL;
+
+    char buffer[8192];
+    while (size > 0)
+    {
+        size_t chunk = size < sizeof(buffer) ? (size_t)size : sizeof(buffer);
+        chunk = fread(buffer, 1, chunk, f);
+        if (chunk == 0)
+            break;
+        driver_fortran_hash_bytes(&hash, buffer, chunk);
+        size -= chunk;
+    }
+
+    return driver_fortran_hash_to_str(hash);
+}
+
+static const char* hash_of_file(const char* filename)
+{
+    FILE* f = fopen(filename, "rb");
+    if (f == NULL)
+        return NULL;
+
+    const char* result = hash_of_stream(f, (unsigned long long)-1);
     fclose(f);
 
     return result;
 }
 
+typedef struct previous_wrap_module_tag
+{
+    const char* native_name;
+    const char* interface_hash;
+    const char* native_hash;
+} previous_wrap_module_t;
+
+static char get_previous_wrap_module_hashes(const char* name, FILE* f, unsigned long long size, void *data)
+{
+    previous_wrap_module_t* previous = (previous_wrap_module_t*)data;
+
+    if (strcmp(name, "./" INTERFACE_FILENAME) == 0)
+    {
+        char c[64] = { 0 };
+        if (size < sizeof(c)
+                && fread(c, size, 1, f) == 1)
+        {
+            previous->interface_hash = uniquestr(c);
+        }
+    }
+    else if (strncmp(name, "./", 2) == 0
+            && strcmp(name + 2, previous->native_name) == 0)
+    {
+        previous->native_hash = hash_of_stream(f, size);
+    }
+
+    return 1;
+}
+
+// Wrap modules already checked or unwrapped in this process. They are
+// keyed by path and are reused while the file is not modified
+typedef struct wrap_module_cache_item_tag
+{
+    time_t mtime;
+    off_t size;
+    char is_wrap_module;
+    const char* mf03_filename;
+} wrap_module_cache_item_t;
+
+static dhash_ptr_t* _wrap_module_cache = NULL;
+
+// Wrap module last unwrapped into each extracted file, as modules with the
+// same name found in different directories are extracted in the same place
+static dhash_ptr_t* _unwrapped_from = NULL;
+
+static wrap_module_cache_item_t* get_wrap_module_cache_item(const char* path)
+{
+    struct stat st;
+    if (stat(path, &st) != 0)
+        return NULL;
+
+    if (_wrap_module_cache == NULL)
+        _wrap_module_cache = dhash_ptr_new(5);
+
+    path = uniquestr(path);
+    wrap_module_cache_item_t* item = (wrap_module_cache_item_t*)dhash_ptr_query(_wrap_module_cache, path);
+    if (item == NULL)
+    {
+        item = NEW0(wrap_module_cache_item_t);
+        dhash_ptr_insert(_wrap_module_cache, path, item);
+    }
+    else if (item->mtime == st.st_mtime
+            && item->size == st.st_size)
+    {
+        return item;
+    }
+
+    DEBUG_CODE()
+    {
+        fprintf(stderr, "DRIVER-FORTRAN: Caching wrap module information of '%s'\n", path);
+    }
+
+    item->mtime = st.st_mtime;
+    item->size = st.st_size;
+    item->is_wrap_module = check_is_mercurium_wrap_module(path);
+    item->mf03_filename = NULL;
+
+    return item;
+}
+
+static void invalidate_wrap_module_cache_item(const char* path)
+{
+    if (_wrap_module_cache == NULL)
+        return;
+
+    wrap_module_cache_item_t* item = (wrap_module_cache_item_t*)dhash_ptr_query(_wrap_module_cache,
+            uniquestr(path));
+    if (item != NULL)
+    {
+        item->mtime = 0;
+        item->size = 0;
+        item->is_wrap_module = 0;
+        item->mf03_filename = NULL;
+    }
+}
+
 static const char *get_path_of_file_in_module_dirs(const char* filename, const char* module_name)
 {
     const char * result = NULL;
@@ -382,7 +636,9 @@ static const char *get_path_of_mercurium_wrap_module(const char* module_name)
 
     if (result != NULL)
     {
-        if (!check_is_mercurium_wrap_module(result))
+        wrap_module_cache_item_t* item = get_wrap_module_cache_item(result);
+        if (item == NULL
+                || !item->is_wrap_module)
         {
             DEBUG_CODE()
             {
@@ -410,6 +666,30 @@ static const char *get_path_of_module_file(const char* module_name, const char*
     }
 }
 
+static const char* get_filename_in_module_out_dir(const char* filename)
+{
+    if (CURRENT_CONFIGURATION->module_out_dir != NULL)
+    {
+        return strappend(
+                strappend(CURRENT_CONFIGURATION->module_out_dir, "/"),
+                filename);
+    }
+    else
+    {
+        return filename;
+    }
+}
+
+const char* driver_fortran_get_module_filename(const char* module_name)
+{
+    return get_filename_in_module_out_dir(strappend(module_name, ".mod"));
+}
+
+const char* driver_fortran_get_submodule_filename(const char* submodule_name)
+{
+    return get_filename_in_module_out_dir(strappend(submodule_name, ".smod"));
+}
+
 static const char *get_path_of_mercurium_own_module(const char* module_name)
 {
     return get_path_of_module_file(module_name, ".mf03");
@@ -422,6 +702,20 @@ static const char *get_path_of_native_module(const char* module_name)
 
 static const char* unwrap_module(const char* wrap_module, const char* module_name)
 {
+    wrap_module_cache_item_t* item = get_wrap_module_cache_item(wrap_module);
+    if (item != NULL
+            && item->mf03_filename != NULL
+            && dhash_ptr_query(_unwrapped_from, item->mf03_filename) == uniquestr(wrap_module)
+            && access(item->mf03_filename, F_OK) == 0)
+    {
+        DEBUG_CODE()
+        {
+            fprintf(stderr, "DRIVER-FORTRAN: Wrap module file '%s' already unwrapped in '%s'\n",
+                    wrap_module, item->mf03_filename);
+        }
+        return item->mf03_filename;
+    }
+
     DEBUG_CODE()
     {
         fprintf(stderr, "DRIVER-FORTRAN: Unwrapping wrap module file '%s' for module name '%s'\n", 
@@ -435,15 +729,6 @@ static const char* unwrap_module(const char* wrap_module, const char* module_nam
         CURRENT_CONFIGURATION->module_native_dir = temp_dir->name;
     }
 
-    const char* arguments[] =
-    {
-        "xf",
-        wrap_module,
-        "-C", temp_dir->name,
-        ".",
-        NULL
-    };
-
     timing_t timing_unwrap;
     timing_start(&timing_unwrap);
 
@@ -451,13 +736,14 @@ static const char* unwrap_module(const char* wrap_module, const char* module_nam
     {
         fprintf(stderr, "Unwrapping module file '%s'\n", wrap_module);
     }
-    timing_end(&timing_unwrap);
 
-    if (execute_program("tar", arguments) != 0)
+    if (!walk_wrap_module(wrap_module, extract_member, (void*)temp_dir->name))
     {
-        fatal_error("Error when unwrapping module. tar failed");
+        fatal_error("Error when unwrapping module '%s'. Invalid wrap module file", wrap_module);
     }
 
+    timing_end(&timing_unwrap);
+
     if (CURRENT_CONFIGURATION->verbose)
     {
         fprintf(stderr, "Unwrapped module file '%s' in %.2f seconds\n",
@@ -478,6 +764,18 @@ static const char* unwrap_module(const char* wrap_module, const char* module_nam
         result = NULL;
     }
 
+    if (result != NULL)
+    {
+        result = uniquestr(result);
+
+        if (_unwrapped_from == NULL)
+            _unwrapped_from = dhash_ptr_new(5);
+        dhash_ptr_insert(_unwrapped_from, result, (void*)uniquestr(wrap_module));
+    }
+
+    if (item != NULL)
+        item->mf03_filename = result;
+
     return result;
 }
 
@@ -496,6 +794,26 @@ static void register_module_for_later_wrap(const char* module_name, const char*
     module_to_wrap->mercurium_file = mf03_filename;
     module_to_wrap->native_file = get_path_of_native_module(module_name);
 
+    // Remember the interface of the wrap module we are about to replace, the
+    // native compiler will overwrite it before we wrap the new one
+    wrap_module_cache_item_t* item = get_wrap_module_cache_item(module_to_wrap->native_file);
+    if (item != NULL
+            && item->is_wrap_module)
+    {
+        previous_wrap_module_t previous;
+        memset(&previous, 0, sizeof(previous));
+        previous.native_name = give_basename(module_to_wrap->native_file);
+
+        if (walk_wrap_module(module_to_wrap->native_file, get_previous_wrap_module_hashes, &previous)
+                && previous.interface_hash != NULL
+                && previous.native_hash != NULL)
+        {
+            module_to_wrap->previous_interface_hash = previous.interface_hash;
+            module_to_wrap->previous_native_hash = previous.native_hash;
+            module_to_wrap->previous_mtime = item->mtime;
+        }
+    }
+
     P_LIST_ADD(CURRENT_COMPILED_FILE->modules_to_wrap,
             CURRENT_COMPILED_FILE->num_modules_to_wrap,
             module_to_wrap);
@@ -545,6 +863,18 @@ static void wrap_module_file(module_to_wrap_info_t* module_to_wrap)
     }
     fclose(f);
 
+    const char* interface_hash = module_file_interface_hash(temp_mercurium);
+    const char* native_hash = hash_of_file(temp_native);
+
+    const char* interface_filename = strappend(strappend(temp_dir->name, "/"), INTERFACE_FILENAME);
+    f = fopen(interface_filename, "w");
+    if (f == NULL)
+    {
+        fatal_error("Error when wrapping a module: creation of interface file failed. %s\n", strerror(errno));
+    }
+    fprintf(f, "%s", interface_hash);
+    fclose(f);
+
     // Now pack the two files using tar
     const char* arguments[] =
     {
@@ -560,6 +890,34 @@ static void wrap_module_file(module_to_wrap_info_t* module_to_wrap)
         fatal_error("Error when wrapping a module: tar failed\n");
     }
 
+    // If neither the interface nor the native module changed, keep the
+    // modification time of the previous module so files using it are not
+    // rebuilt
+    if (module_to_wrap->previous_interface_hash != NULL
+            && module_to_wrap->previous_interface_hash == interface_hash
+            && native_hash != NULL
+            && module_to_wrap->previous_native_hash == native_hash)
+    {
+        if (CURRENT_CONFIGURATION->verbose)
+        {
+            fprintf(stderr, "Module '%s' has not changed, keeping modification time of '%s'\n",
+                    module_to_wrap->module_name,
+                    module_to_wrap->native_file);
+        }
+
+        struct utimbuf times;
+        times.actime = module_to_wrap->previous_mtime;
+        times.modtime = module_to_wrap->previous_mtime;
+        if (utime(module_to_wrap->native_file, &times) != 0)
+        {
+            fprintf(stderr, "Warning: could not restore modification time of '%s'. %s\n",
+                    module_to_wrap->native_file,
+                    strerror(errno));
+        }
+    }
+
+    invalidate_wrap_module_cache_item(module_to_wrap->native_file);
+
     unlock_modules(lock_fd, lock_filename);
 }
 
@@ -27,6 +27,9 @@
 #ifndef CXX_DRIVER_FORTRAN_H
 #define CXX_DRIVER_FORTRAN_H
 
+#include <stddef.h>
+#include <stdint.h>
+
 
 // This function states to the driver that we are going to use the module 'module_name'
 // it returns the path of the mf03 specific module. If such module was wrapped, it returns
@@ -40,6 +43,14 @@ void driver_fortran_register_module(const char* module_name,
         const char **mf03_filename,
         char is_intrinsic);
 
+// This function returns the name of the module file of 'module_name' as it
+// appears in build dependences: in the -J directory, if any
+const char* driver_fortran_get_module_filename(const char* module_name);
+
+// Like driver_fortran_get_module_filename but for the submodule file of
+// 'submodule_name', written as ancestor@submodule
+const char* driver_fortran_get_submodule_filename(const char* submodule_name);
+
 // This function is called by the driver after the native compilation of a Fortran file
 void driver_fortran_wrap_all_modules(void);
 
@@ -52,4 +63,9 @@ void driver_fortran_hide_mercurium_modules(void);
 // This function restores all wrap modules, for subsequent uses
 void driver_fortran_restore_mercurium_modules(void);
 
+// These functions compute the FNV-1a hashes used to tell whether a module
+// has changed. Hashes start with the value 14695981039346656037ULL
+void driver_fortran_hash_bytes(uint64_t *hash, const void* data, size_t size);
+const char* driver_fortran_hash_to_str(uint64_t hash);
+
 #endif // CXX_DRIVER_FORTRAN_H
@@ -44,8 +44,14 @@ struct AST_tag
     // This is a bitmap for the sons
     unsigned int bitmap_sons:MCXX_MAX_AST_CHILDREN;
 
-    // Number of ambiguities of this node
-    int num_ambig;
+    union
+    {
+        // Number of ambiguities of this node (only for AST_AMBIGUITY)
+        int num_ambig;
+        // Number of modifications done to a nodecl tree, nodecl trees are
+        // never ambiguous
+        unsigned int modification_count;
+    };
 
     // Parent node
     struct AST_tag* parent;
@@ -564,6 +570,16 @@ static inline void ast_set_expr_info(AST a, struct nodecl_expr_info_tag* expr_in
     a->expr_info = expr_info;
 }
 
+static inline unsigned int ast_get_modification_count(const_AST a)
+{
+    return a->modification_count;
+}
+
+static inline void ast_set_modification_count(AST a, unsigned int count)
+{
+    a->modification_count = count;
+}
+
 static inline const char* ast_node_type_name(node_t n)
 {
     return ast_node_names[n];
@@ -189,6 +189,10 @@ static inline void ast_fix_parents_inside_intepretation(AST node);
 static inline struct nodecl_expr_info_tag* ast_get_expr_info(const_AST a);
 static inline void ast_set_expr_info(AST a, struct nodecl_expr_info_tag*);
 
+// Modification count of nodecl trees. See nodecl_get_modification_count
+static inline unsigned int ast_get_modification_count(const_AST a);
+static inline void ast_set_modification_count(AST a, unsigned int count);
+
 // Used by memory report
 static inline int ast_node_size(void);
 
@@ -92,8 +92,19 @@ enum multi_value_kind_tag
     MVK_INVALID = 0,
     MVK_ELEMENTS,
     MVK_C_STRING,
+    MVK_PACKED,
 } multi_value_kind_t;
 
+// Scalar elements of the same kind (and size and sign for integers) stored
+// contiguously. Large constant arrays use this representation
+typedef struct const_packed_values_tag
+{
+    const_value_kind_t element_kind;
+    int num_bytes;
+    char sign;
+    void* data;
+} const_packed_values_t;
+
 typedef struct const_multi_value_tag
 {
     type_t* struct_type;
@@ -103,6 +114,7 @@ typedef struct const_multi_value_tag
     union {
         const_value_t** elements;
         const char* c_str;
+        const_packed_values_t* packed;
     };
 } const_multi_value_t;
 
@@ -174,6 +186,8 @@ struct const_value_tag
     || x == CVK_RANGE)
 
 static int const_value_compare_multival_(const_multi_value_t* m1, const_multi_value_t* m2);
+static const_value_t* multi_value_get_element_num(const_multi_value_t* m, int element);
+static cvalue_uint_t packed_get_integer(const const_packed_values_t* packed, int i);
 
 // static int const_value_compare_(const_value_t* val1, const_value_t* val2)
 static int const_value_compare_(const void* p1, const void *p2)
@@ -296,7 +310,43 @@ static int const_value_compare_multival_(const_multi_value_t* m1, const_multi_va
     if (m1->num_elements != m2->num_elements)
         return m1->num_elements > m2->num_elements ? 1 : -1;
 
-    if (m1->kind == MVK_C_STRING
+    if (m1->kind == MVK_PACKED
+            && m2->kind == MVK_PACKED
+            && m1->packed->element_kind == CVK_INTEGER
+            && m2->packed->element_kind == CVK_INTEGER
+            && m1->packed->num_bytes == m2->packed->num_bytes
+            && m1->packed->sign == m2->packed->sign)
+    {
+        // Same as comparing the elements one by one without boxing them
+        int i;
+        int num = m1->num_elements;
+        for (i = 0; i < num; i++)
+        {
+            cvalue_uint_t u1 = packed_get_integer(m1->packed, i);
+            cvalue_uint_t u2 = packed_get_integer(m2->packed, i);
+            if (u1 != u2)
+            {
+                if (m1->packed->sign)
+                    return (cvalue_int_t)u1 > (cvalue_int_t)u2 ? 1 : -1;
+                else
+                    return u1 > u2 ? 1 : -1;
+            }
+        }
+    }
+    else if (m1->kind == MVK_PACKED
+            || m2->kind == MVK_PACKED)
+    {
+        int i;
+        int num = m1->num_elements;
+        for (i = 0; i < num; i++)
+        {
+            int k = const_value_compare_(multi_value_get_element_num(m1, i),
+                    multi_value_get_element_num(m2, i));
+            if (k != 0)
+                return k;
+        }
+    }
+    else if (m1->kind == MVK_C_STRING
             && m2->kind == MVK_C_STRING)
     {
         int k = strcmp(m1->c_str, m2->c_str);
@@ -373,6 +423,12 @@ static void const_value_free(const_value_t* v)
                 if (v->value.m != NULL
                         && v->value.m->kind == MVK_ELEMENTS)
                     DELETE(v->value.m->elements);
+                else if (v->value.m != NULL
+                        && v->value.m->kind == MVK_PACKED)
+                {
+                    DELETE(v->value.m->packed->data);
+                    DELETE(v->value.m->packed);
+                }
                 break;
             }
         case CVK_OBJECT:
@@ -531,25 +587,86 @@ static int multival_get_num_elements(const_value_t* v)
     return v->value.m->num_elements;
 }
 
-static const_value_t* multival_get_element_num(const_value_t* v, int element)
+static int packed_element_size(const const_packed_values_t* packed)
 {
-    ERROR_CONDITION(element >= v->value.m->num_elements, "Invalid index %d in a multi-value constant with up to %d components", 
-            element, v->value.m->num_elements);
+    switch (packed->element_kind)
+    {
+        case CVK_INTEGER:
+            return packed->num_bytes;
+        case CVK_FLOAT:
+            return sizeof(float);
+        case CVK_DOUBLE:
+            return sizeof(double);
+        default:
+            internal_error("Code unreachable", 0);
+    }
+    return 0;
+}
 
-    if (v->value.m->kind == MVK_ELEMENTS)
+static cvalue_uint_t packed_get_integer(const const_packed_values_t* packed, int i)
+{
+    switch (packed->num_bytes)
     {
-        return v->value.m->elements[element];
+#define PACKED_GET_INTEGER(_bits) \
+        case _bits / 8: \
+            { \
+                if (packed->sign) \
+                    return (cvalue_uint_t)(cvalue_int_t)((int##_bits##_t*)packed->data)[i]; \
+                else \
+                    return ((uint##_bits##_t*)packed->data)[i]; \
+            }
+        PACKED_GET_INTEGER(8)
+        PACKED_GET_INTEGER(16)
+        PACKED_GET_INTEGER(32)
+        PACKED_GET_INTEGER(64)
+#undef PACKED_GET_INTEGER
+#ifdef HAVE_INT128
+        case 16:
+            return ((cvalue_uint_t*)packed->data)[i];
+#endif
+        default:
+            internal_error("Invalid size %d of packed integer", packed->num_bytes);
     }
-    else if (v->value.m->kind == MVK_C_STRING)
+    return 0;
+}
+
+static const_value_t* packed_get_element_num(const const_packed_values_t* packed, int element)
+{
+    switch (packed->element_kind)
     {
-        int len = strlen(v->value.m->c_str);
+        case CVK_INTEGER:
+            return const_value_get_integer(packed_get_integer(packed, element),
+                    packed->num_bytes,
+                    packed->sign);
+        case CVK_FLOAT:
+            return const_value_get_float(((float*)packed->data)[element]);
+        case CVK_DOUBLE:
+            return const_value_get_double(((double*)packed->data)[element]);
+        default:
+            internal_error("Code unreachable", 0);
+    }
+    return NULL;
+}
+
+static const_value_t* multi_value_get_element_num(const_multi_value_t* m, int element)
+{
+    ERROR_CONDITION(element >= m->num_elements, "Invalid index %d in a multi-value constant with up to %d components", 
+            element, m->num_elements);
+
+    if (m->kind == MVK_ELEMENTS)
+    {
+        return m->elements[element];
+    }
+    else if (m->kind == MVK_C_STRING)
+    {
+        int len = strlen(m->c_str);
 
-        if (len == v->value.m->num_elements)
+        if (len == m->num_elements)
             return const_value_get_integer(
-                    v->value.m->c_str[element],
+                    m->c_str[element],
                     /* bytes */ 1,
                     /* sign */ 0);
-        else if (len + 1 == v->value.m->num_elements)
+        else if (len + 1 == m->num_elements)
         {
             if (element == len)
             {
@@ -558,12 +675,16 @@ static const_value_t* multival_get_element_num(const_value_t* v, int element)
             else
             {
                 return const_value_get_integer(
-                        v->value.m->c_str[element],
+                        m->c_str[element],
                         /* bytes */ 1,
                         /* sign */ 0);
             }
         }
     }
+    else if (m->kind == MVK_PACKED)
+    {
+        return packed_get_element_num(m->packed, element);
+    }
     else
     {
         internal_error("Code unreachable", 0);
@@ -571,6 +692,11 @@ static const_value_t* multival_get_element_num(const_value_t* v, int element)
     return NULL;
 }
 
+static const_value_t* multival_get_element_num(const_value_t* v, int element)
+{
+    return multi_value_get_element_num(v->value.m, element);
+}
+
 static const_value_t* make_multival(int num_elements, const_value_t **elements)
 {
     const_value_t* result = NEW0(const_value_t);
@@ -592,12 +718,338 @@ static const_value_t* make_multival(int num_elements, const_value_t **elements)
     return result;
 }
 
+// Arrays with fewer elements than this are not worth packing
+enum { MIN_PACKED_ELEMENTS = 16 };
+
+static char integer_fits_in_packed(const_value_t* v)
+{
+    if (!v->sign)
+        return 1;
+
+    switch (v->num_bytes)
+    {
+        case 1: return v->value.si == (cvalue_int_t)(int8_t)v->value.si;
+        case 2: return v->value.si == (cvalue_int_t)(int16_t)v->value.si;
+        case 4: return v->value.si == (cvalue_int_t)(int32_t)v->value.si;
+        case 8: return v->value.si == (cvalue_int_t)(int64_t)v->value.si;
+        default: return 1;
+    }
+}
+
+static char can_be_packed(int num_elements, const_value_t** elements)
+{
+    if (num_elements < MIN_PACKED_ELEMENTS)
+        return 0;
+
+    const_value_t* first = elements[0];
+    if (first->kind == CVK_INTEGER)
+    {
+        if (first->num_bytes != 1
+                && first->num_bytes != 2
+                && first->num_bytes != 4
+                && first->num_bytes != 8
+                && (first->num_bytes != 16
+                    || sizeof(cvalue_uint_t) != 16))
+            return 0;
+    }
+    else if (first->kind != CVK_FLOAT
+            && first->kind != CVK_DOUBLE)
+    {
+        return 0;
+    }
+
+    int i;
+    for (i = 0; i < num_elements; i++)
+    {
+        if (elements[i]->kind != first->kind
+                || elements[i]->num_bytes != first->num_bytes
+                || elements[i]->sign != first->sign)
+            return 0;
+
+        if (first->kind == CVK_INTEGER
+                && !integer_fits_in_packed(elements[i]))
+            return 0;
+    }
+
+    return 1;
+}
+
+static const_packed_values_t* new_packed_values(const_value_kind_t element_kind,
+        int num_bytes, char sign, int num_elements)
+{
+    const_packed_values_t* packed = NEW0(const_packed_values_t);
+    packed->element_kind = element_kind;
+    packed->num_bytes = num_bytes;
+    packed->sign = sign;
+    packed->data = xmalloc(packed_element_size(packed) * (size_t)num_elements);
+
+    return packed;
+}
+
+static void packed_set_integer(const_packed_values_t* packed, int i, cvalue_uint_t value)
+{
+    switch (packed->num_bytes)
+    {
+        case 1: ((uint8_t*)packed->data)[i] = (uint8_t)value; break;
+        case 2: ((uint16_t*)packed->data)[i] = (uint16_t)value; break;
+        case 4: ((uint32_t*)packed->data)[i] = (uint32_t)value; break;
+        case 8: ((uint64_t*)packed->data)[i] = (uint64_t)value; break;
+#ifdef HAVE_INT128
+        case 16: ((cvalue_uint_t*)packed->data)[i] = value; break;
+#endif
+        default:
+            internal_error("Invalid size %d of packed integer", packed->num_bytes);
+    }
+}
+
+static const_value_t* make_packed_multival(int num_elements, const_packed_values_t* packed)
+{
+    const_value_t* result = NEW0(const_value_t);
+
+    result->value.m = NEW0(const_multi_value_t);
+    result->value.m->kind = MVK_PACKED;
+    result->value.m->num_elements = num_elements;
+    result->value.m->packed = packed;
+
+    return result;
+}
+
+// Replaces the elements of an array by a packed representation, if possible
+static const_value_t* pack_array(const_value_t* v)
+{
+    if (v->kind != CVK_ARRAY
+            || v->value.m->kind != MVK_ELEMENTS
+            || !can_be_packed(v->value.m->num_elements, v->value.m->elements))
+        return v;
+
+    int i, num_elements = v->value.m->num_elements;
+    const_value_t** elements = v->value.m->elements;
+
+    const_packed_values_t* packed = new_packed_values(elements[0]->kind,
+            elements[0]->num_bytes, elements[0]->sign, num_elements);
+    for (i = 0; i < num_elements; i++)
+    {
+        switch (packed->element_kind)
+        {
+            case CVK_INTEGER:
+                packed_set_integer(packed, i, elements[i]->value.i);
+                break;
+            case CVK_FLOAT:
+                ((float*)packed->data)[i] = elements[i]->value.f;
+                break;
+            case CVK_DOUBLE:
+                ((double*)packed->data)[i] = elements[i]->value.d;
+                break;
+            default:
+                internal_error("Code unreachable", 0);
+        }
+    }
+
+    DELETE(elements);
+    v->value.m->kind = MVK_PACKED;
+    v->value.m->packed = packed;
+
+    return v;
+}
+
+typedef enum packed_binary_op_tag
+{
+    PACKED_OP_INVALID = 0,
+    PACKED_OP_ADD,
+    PACKED_OP_SUB,
+    PACKED_OP_MUL,
+} packed_binary_op_t;
+
+static packed_binary_op_t get_packed_binary_op(const_value_t* (*fun)(const_value_t*, const_value_t*))
+{
+    if (fun == const_value_add)
+        return PACKED_OP_ADD;
+    else if (fun == const_value_sub)
+        return PACKED_OP_SUB;
+    else if (fun == const_value_mul)
+        return PACKED_OP_MUL;
+    else
+        return PACKED_OP_INVALID;
+}
+
+// Checks that a (packed array or scalar) operand has the given element layout
+static char packed_operand_matches(const_value_t* v,
+        const_value_kind_t element_kind, int num_bytes, char sign)
+{
+    if (v->kind == CVK_ARRAY)
+    {
+        return v->value.m->kind == MVK_PACKED
+            && v->value.m->packed->element_kind == element_kind
+            && v->value.m->packed->num_bytes == num_bytes
+            && v->value.m->packed->sign == sign;
+    }
+    else
+    {
+        return v->kind == element_kind
+            && v->num_bytes == num_bytes
+            && v->sign == sign
+            && (element_kind != CVK_INTEGER
+                    || integer_fits_in_packed(v));
+    }
+}
+
+static cvalue_uint_t packed_operand_get_integer(const_value_t* v, int i)
+{
+    if (v->kind == CVK_ARRAY)
+        return packed_get_integer(v->value.m->packed, i);
+    else
+        return v->value.i;
+}
+
+#define PACKED_OPERAND_GET_FLOAT(_type, _field) \
+static _type packed_operand_get_##_field(const_value_t* v, int i) \
+{ \
+    if (v->kind == CVK_ARRAY) \
+        return ((_type*)v->value.m->packed->data)[i]; \
+    else \
+        return v->value._field; \
+}
+
+PACKED_OPERAND_GET_FLOAT(float, f)
+PACKED_OPERAND_GET_FLOAT(double, d)
+
+#undef PACKED_OPERAND_GET_FLOAT
+
+static char packed_signed_fits(int64_t value, int num_bytes)
+{
+    switch (num_bytes)
+    {
+        case 1: return value == (int8_t)value;
+        case 2: return value == (int16_t)value;
+        case 4: return value == (int32_t)value;
+        case 8: return 1;
+        default: return 0;
+    }
+}
+
+// Folds add, sub and mul of packed arrays (or a packed array and a scalar of
+// the same kind) without boxing every element. Returns NULL if the operands
+// are not suitable, so the caller can fold element by element. The results
+// must match those of const_value_add, const_value_sub and const_value_mul
+static const_value_t* packed_binary_op(const_value_t* (*fun)(const_value_t*, const_value_t*),
+        const_value_t* m1,
+        const_value_t* m2)
+{
+    packed_binary_op_t op = get_packed_binary_op(fun);
+    if (op == PACKED_OP_INVALID)
+        return NULL;
+
+    const_value_t* array = (m1->kind == CVK_ARRAY) ? m1 : m2;
+    if (array->kind != CVK_ARRAY
+            || array->value.m->kind != MVK_PACKED)
+        return NULL;
+
+    int i, num_elements = array->value.m->num_elements;
+    const_packed_values_t* layout = array->value.m->packed;
+    if (!packed_operand_matches(m1, layout->element_kind, layout->num_bytes, layout->sign)
+            || !packed_operand_matches(m2, layout->element_kind, layout->num_bytes, layout->sign))
+        return NULL;
+
+    if (layout->element_kind == CVK_INTEGER
+            && layout->num_bytes > (int)sizeof(uint64_t))
+        return NULL;
+
+    const_packed_values_t* packed = new_packed_values(layout->element_kind,
+            layout->num_bytes, layout->sign, num_elements);
+
+    char ok = 1;
+    switch (layout->element_kind)
+    {
+        case CVK_INTEGER:
+            {
+                if (layout->sign)
+                {
+                    for (i = 0; i < num_elements && ok; i++)
+                    {
+                        int64_t a = (cvalue_int_t)packed_operand_get_integer(m1, i);
+                        int64_t b = (cvalue_int_t)packed_operand_get_integer(m2, i);
+                        int64_t r = 0;
+                        switch (op)
+                        {
+                            case PACKED_OP_ADD: ok = !__builtin_add_overflow(a, b, &r); break;
+                            case PACKED_OP_SUB: ok = !__builtin_sub_overflow(a, b, &r); break;
+                            case PACKED_OP_MUL: ok = !__builtin_mul_overflow(a, b, &r); break;
+                            default: internal_error("Code unreachable", 0);
+                        }
+                        // A result that does not fit cannot be packed
+                        ok = ok && packed_signed_fits(r, layout->num_bytes);
+                        if (ok)
+                            packed_set_integer(packed, i, (cvalue_uint_t)(cvalue_int_t)r);
+                    }
+                }
+                else
+                {
+                    for (i = 0; i < num_elements; i++)
+                    {
+                        uint64_t a = packed_operand_get_integer(m1, i);
+                        uint64_t b = packed_operand_get_integer(m2, i);
+                        uint64_t r = 0;
+                        switch (op)
+                        {
+                            case PACKED_OP_ADD: r = a + b; break;
+                            case PACKED_OP_SUB: r = a - b; break;
+                            case PACKED_OP_MUL: r = a * b; break;
+                            default: internal_error("Code unreachable", 0);
+                        }
+                        packed_set_integer(packed, i, r);
+                    }
+                }
+                break;
+            }
+#define PACKED_FLOAT_LOOP(_type, _field) \
+            { \
+                _type* data = (_type*)packed->data; \
+                switch (op) \
+                { \
+                    case PACKED_OP_ADD: \
+                        for (i = 0; i < num_elements; i++) \
+                            data[i] = packed_operand_get_##_field(m1, i) + packed_operand_get_##_field(m2, i); \
+                        break; \
+                    case PACKED_OP_SUB: \
+                        for (i = 0; i < num_elements; i++) \
+                            data[i] = packed_operand_get_##_field(m1, i) - packed_operand_get_##_field(m2, i); \
+                        break; \
+                    case PACKED_OP_MUL: \
+                        for (i = 0; i < num_elements; i++) \
+                            data[i] = packed_operand_get_##_field(m1, i) * packed_operand_get_##_field(m2, i); \
+                        break; \
+                    default: internal_error("Code unreachable", 0); \
+                } \
+                break; \
+            }
+        case CVK_FLOAT:
+            PACKED_FLOAT_LOOP(float, f)
+        case CVK_DOUBLE:
+            PACKED_FLOAT_LOOP(double, d)
+#undef PACKED_FLOAT_LOOP
+        default:
+            internal_error("Code unreachable", 0);
+    }
+
+    if (!ok)
+    {
+        DELETE(packed->data);
+        DELETE(packed);
+        return NULL;
+    }
+
+    const_value_t* result = make_packed_multival(num_elements, packed);
+    result->kind = CVK_ARRAY;
+
+    return result;
+}
+
 static const_value_t* map_cast_to_bytes_to_structured_value(const_value_t* m1, int bytes, char sign)
 {
     ERROR_CONDITION(!IS_MULTIVALUE(m1->kind), "The value is not a multiple-value constant", 0);
 
     int i, num_elements = multival_get_num_elements(m1);
-    const_value_t* result_arr[num_elements];
+    const_value_t** result_arr = NEW_VEC(const_value_t*, num_elements);
     for (i = 0; i < num_elements; i++)
     {
         result_arr[i] = const_value_cast_to_bytes(multival_get_element_num(m1, i), bytes, sign);
@@ -605,8 +1057,9 @@ static const_value_t* map_cast_to_bytes_to_structured_value(const_value_t* m1, i
 
     const_value_t* mval = make_multival(num_elements, result_arr);
     mval->kind = m1->kind;
+    DELETE(result_arr);
 
-    return mval;
+    return pack_array(mval);
 }
 
 const_value_t* const_value_cast_to_bytes(const_value_t* val, int bytes, char sign)
@@ -644,7 +1097,7 @@ static const_value_t* map_unary_to_structured_value(const_value_t* (*fun)(const_
     ERROR_CONDITION(!IS_MULTIVALUE(m1->kind), "The value is not a multiple-value constant", 0);
 
     int i, num_elements = multival_get_num_elements(m1);
-    const_value_t* result_arr[num_elements];
+    const_value_t** result_arr = NEW_VEC(const_value_t*, num_elements);
     for (i = 0; i < num_elements; i++)
     {
         result_arr[i] = fun(multival_get_element_num(m1, i));
@@ -652,8 +1105,9 @@ static const_value_t* map_unary_to_structured_value(const_value_t* (*fun)(const_
 
     const_value_t* mval = make_multival(num_elements, result_arr);
     mval->kind = m1->kind;
+    DELETE(result_arr);
 
-    return mval;
+    return pack_array(mval);
 }
 
 // Use this to apply a binary function to a couple of multivals
@@ -667,8 +1121,12 @@ static const_value_t* map_binary_to_structured_value(const_value_t* (*fun)(const
             multival_get_num_elements(m1),
             multival_get_num_elements(m2));
 
+    const_value_t* packed_result = packed_binary_op(fun, m1, m2);
+    if (packed_result != NULL)
+        return packed_result;
+
     int i, num_elements = multival_get_num_elements(m1);
-    const_value_t* result_arr[num_elements];
+    const_value_t** result_arr = NEW_VEC(const_value_t*, num_elements);
     for (i = 0; i < num_elements; i++)
     {
         result_arr[i] = fun(multival_get_element_num(m1, i), multival_get_element_num(m2, i));
@@ -676,8 +1134,9 @@ static const_value_t* map_binary_to_structured_value(const_value_t* (*fun)(const
 
     const_value_t* mval = make_multival(num_elements, result_arr);
     mval->kind = m1->kind;
+    DELETE(result_arr);
 
-    return mval;
+    return pack_array(mval);
 }
 
 const_value_t* const_value_cast_to_signed_int_value(const_value_t* val)
@@ -865,7 +1324,7 @@ char const_value_is_one(const_value_t* v)
         int i;
         for (i=0; i<num_elements; i++)
         {
-            if (!const_value_is_one(v->value.m->elements[i]))
+            if (!const_value_is_one(multival_get_element_num(v, i)))
                 return 0;
         }
 
@@ -1570,7 +2029,7 @@ nodecl_t const_value_to_nodecl_(const_value_t* v,
                 int i;
                 for (i = 0; i < v->value.m->num_elements; i++)
                 {
-                    list = nodecl_append_to_list(list, const_value_to_nodecl_(v->value.m->elements[i], basic_type, cached));
+                    list = nodecl_append_to_list(list, const_value_to_nodecl_(multival_get_element_num(v, i), basic_type, cached));
                 }
 
                 // Get the type from the first element
@@ -2167,7 +2626,7 @@ const_value_t* const_value_make_array(int num_elements, const_value_t **elements
     const_value_t* result = make_multival(num_elements, elements);
     result->kind = CVK_ARRAY;
 
-    return const_value_return_unique(result);
+    return const_value_return_unique(pack_array(result));
 }
 
 const_value_t* const_value_make_vector(int num_elements, const_value_t **elements)
@@ -2515,8 +2974,12 @@ static const_value_t* extend_first_operand_to_structured_value(const_value_t* (*
     ERROR_CONDITION(!IS_MULTIVALUE(m1->kind), "The first operand must be a multiple-value constant", 0);
     ERROR_CONDITION(IS_MULTIVALUE(m2->kind), "The second operand must not be a multiple-value constant", 0);
 
+    const_value_t* packed_result = packed_binary_op(fun, m1, m2);
+    if (packed_result != NULL)
+        return packed_result;
+
     int i, num_elements = multival_get_num_elements(m1);
-    const_value_t* result_arr[num_elements];
+    const_value_t** result_arr = NEW_VEC(const_value_t*, num_elements);
     for (i = 0; i < num_elements; i++)
     {
         result_arr[i] = fun(multival_get_element_num(m1, i), m2);
@@ -2524,8 +2987,9 @@ static const_value_t* extend_first_operand_to_structured_value(const_value_t* (*
 
     const_value_t* mval = make_multival(num_elements, result_arr);
     mval->kind = m1->kind;
+    DELETE(result_arr);
 
-    return mval;
+    return pack_array(mval);
 }
 
 static const_value_t* extend_second_operand_to_structured_value(const_value_t* (*fun)(const_value_t*, const_value_t*),
@@ -2535,8 +2999,12 @@ static const_value_t* extend_second_operand_to_structured_value(const_value_t* (
     ERROR_CONDITION(IS_MULTIVALUE(m1->kind), "The first operand must not be a multiple-value constant", 0);
     ERROR_CONDITION(!IS_MULTIVALUE(m2->kind), "The second operand must be a multiple-value constant", 0);
 
+    const_value_t* packed_result = packed_binary_op(fun, m1, m2);
+    if (packed_result != NULL)
+        return packed_result;
+
     int i, num_elements = multival_get_num_elements(m2);
-    const_value_t* result_arr[num_elements];
+    const_value_t** result_arr = NEW_VEC(const_value_t*, num_elements);
     for (i = 0; i < num_elements; i++)
     {
         result_arr[i] = fun(m1, multival_get_element_num(m2, i));
@@ -2544,8 +3012,9 @@ static const_value_t* extend_second_operand_to_structured_value(const_value_t* (
 
     const_value_t* mval = make_multival(num_elements, result_arr);
     mval->kind = m2->kind;
+    DELETE(result_arr);
 
-    return mval;
+    return pack_array(mval);
 }
 
 
@@ -3571,6 +4040,206 @@ static const_value_t* complex_eq(const_value_t*, const_value_t*);
 static const_value_t* complex_neq(const_value_t*, const_value_t*);
 static const_value_t* arith_powz(const_value_t*, const_value_t*);
 
+// Returns an array with the elements of v at the given indexes. The
+// elements of a packed array are copied without boxing them
+const_value_t* const_value_array_gather(const_value_t* v, int num_indexes, const int* indexes)
+{
+    ERROR_CONDITION(v->kind != CVK_ARRAY, "This is not an array", 0);
+
+    int i;
+    if (v->value.m->kind == MVK_PACKED
+            && num_indexes >= MIN_PACKED_ELEMENTS)
+    {
+        const_packed_values_t* source = v->value.m->packed;
+        const_packed_values_t* packed = new_packed_values(source->element_kind,
+                source->num_bytes, source->sign, num_indexes);
+
+        size_t element_size = packed_element_size(packed);
+        for (i = 0; i < num_indexes; i++)
+        {
+            ERROR_CONDITION(indexes[i] < 0 || indexes[i] >= v->value.m->num_elements,
+                    "Invalid index %d in an array with %d elements", indexes[i], v->value.m->num_elements);
+            memcpy((char*)packed->data + i * element_size,
+                    (char*)source->data + indexes[i] * element_size,
+                    element_size);
+        }
+
+        const_value_t* result = make_packed_multival(num_indexes, packed);
+        result->kind = CVK_ARRAY;
+
+        return const_value_return_unique(result);
+    }
+
+    const_value_t** elements = NEW_VEC(const_value_t*, num_indexes);
+    for (i = 0; i < num_indexes; i++)
+    {
+        elements[i] = multival_get_element_num(v, indexes[i]);
+    }
+
+    const_value_t* result = const_value_make_array(num_indexes, elements);
+    DELETE(elements);
+
+    return result;
+}
+
+// Returns an array with the elements of all the given arrays. Packed arrays
+// of the same layout are concatenated without boxing their elements
+const_value_t* const_value_array_concat(int num_arrays, const_value_t** arrays)
+{
+    int i, num_elements = 0;
+    char all_packed = 1;
+    for (i = 0; i < num_arrays; i++)
+    {
+        ERROR_CONDITION(arrays[i]->kind != CVK_ARRAY, "This is not an array", 0);
+
+        num_elements += arrays[i]->value.m->num_elements;
+        all_packed = all_packed
+            && arrays[i]->value.m->kind == MVK_PACKED
+            && arrays[i]->value.m->packed->element_kind == arrays[0]->value.m->packed->element_kind
+            && arrays[i]->value.m->packed->num_bytes == arrays[0]->value.m->packed->num_bytes
+            && arrays[i]->value.m->packed->sign == arrays[0]->value.m->packed->sign;
+    }
+
+    if (num_arrays == 1)
+        return arrays[0];
+
+    if (num_arrays > 0 && all_packed)
+    {
+        const_packed_values_t* first = arrays[0]->value.m->packed;
+        const_packed_values_t* packed = new_packed_values(first->element_kind,
+                first->num_bytes, first->sign, num_elements);
+
+        size_t element_size = packed_element_size(packed);
+        char* p = (char*)packed->data;
+        for (i = 0; i < num_arrays; i++)
+        {
+            size_t size = element_size * (size_t)arrays[i]->value.m->num_elements;
+            memcpy(p, arrays[i]->value.m->packed->data, size);
+            p += size;
+        }
+
+        const_value_t* result = make_packed_multival(num_elements, packed);
+        result->kind = CVK_ARRAY;
+
+        return const_value_return_unique(result);
+    }
+
+    const_value_t** elements = NEW_VEC(const_value_t*, num_elements);
+    const_value_t** current = elements;
+    for (i = 0; i < num_arrays; i++)
+    {
+        int j, n = arrays[i]->value.m->num_elements;
+        for (j = 0; j < n; j++)
+        {
+            *current = multival_get_element_num(arrays[i], j);
+            current++;
+        }
+    }
+
+    const_value_t* result = const_value_make_array(num_elements, elements);
+    DELETE(elements);
+
+    return result;
+}
+
+// Folds the elements of a packed array with const_value_add or
+// const_value_mul in a tight loop. Returns NULL if this is not possible
+static const_value_t* packed_array_reduce(const_value_t* (*combine)(const_value_t*, const_value_t*),
+        const_value_t* v)
+{
+    packed_binary_op_t op = get_packed_binary_op(combine);
+    if (op != PACKED_OP_ADD
+            && op != PACKED_OP_MUL)
+        return NULL;
+
+    const_packed_values_t* packed = v->value.m->packed;
+    int i, num_elements = v->value.m->num_elements;
+
+    switch (packed->element_kind)
+    {
+        case CVK_INTEGER:
+            {
+                if (packed->num_bytes > (int)sizeof(uint64_t))
+                    return NULL;
+
+                // The partial results of const_value_add and const_value_mul
+                // are not truncated, so give up if they do not fit in 64 bits
+                if (packed->sign)
+                {
+                    int64_t r = (cvalue_int_t)packed_get_integer(packed, 0);
+                    for (i = 1; i < num_elements; i++)
+                    {
+                        int64_t a = (cvalue_int_t)packed_get_integer(packed, i);
+                        if (op == PACKED_OP_ADD ? __builtin_add_overflow(r, a, &r)
+                                : __builtin_mul_overflow(r, a, &r))
+                            return NULL;
+                    }
+                    return const_value_get_integer((cvalue_uint_t)(cvalue_int_t)r,
+                            packed->num_bytes, packed->sign);
+                }
+                else
+                {
+                    uint64_t r = packed_get_integer(packed, 0);
+                    for (i = 1; i < num_elements; i++)
+                    {
+                        uint64_t a = packed_get_integer(packed, i);
+                        if (op == PACKED_OP_ADD ? __builtin_add_overflow(r, a, &r)
+                                : __builtin_mul_overflow(r, a, &r))
+                            return NULL;
+                    }
+                    return const_value_get_integer(r, packed->num_bytes, packed->sign);
+                }
+            }
+#define PACKED_FLOAT_REDUCE(_type, _get) \
+            { \
+                const _type* data = (const _type*)packed->data; \
+                _type r = data[0]; \
+                if (op == PACKED_OP_ADD) \
+                    for (i = 1; i < num_elements; i++) \
+                        r = r + data[i]; \
+                else \
+                    for (i = 1; i < num_elements; i++) \
+                        r = r * data[i]; \
+                return _get(r); \
+            }
+        case CVK_FLOAT:
+            PACKED_FLOAT_REDUCE(float, const_value_get_float)
+        case CVK_DOUBLE:
+            PACKED_FLOAT_REDUCE(double, const_value_get_double)
+#undef PACKED_FLOAT_REDUCE
+        default:
+            internal_error("Code unreachable", 0);
+    }
+    return NULL;
+}
+
+// Folds the elements of an array from left to right. Returns NULL if the
+// array is empty
+const_value_t* const_value_array_reduce(const_value_t* (*combine)(const_value_t*, const_value_t*),
+        const_value_t* v)
+{
+    ERROR_CONDITION(v->kind != CVK_ARRAY, "This is not an array", 0);
+
+    int i, num_elements = v->value.m->num_elements;
+    if (num_elements == 0)
+        return NULL;
+
+    if (v->value.m->kind == MVK_PACKED)
+    {
+        const_value_t* result = packed_array_reduce(combine, v);
+        if (result != NULL)
+            return result;
+    }
+
+    const_value_t* result = multival_get_element_num(v, 0);
+    for (i = 1; i < num_elements; i++)
+    {
+        result = combine(result, multival_get_element_num(v, i));
+    }
+
+    return result;
+}
+
 static const_value_t* reduce_lexicographic_lt(
         const_value_t* (*)(const_value_t*, const_value_t*),
         const_value_t*,
@@ -4265,6 +4934,66 @@ const_value_t* const_value_build_from_raw_data(const char* raw_buffer)
     return result;
 }
 
+typedef struct packed_array_raw_header_tag
+{
+    int element_kind;
+    int num_bytes;
+    int sign;
+    int num_elements;
+} packed_array_raw_header_t;
+
+// This function is for supporting Fortran modules
+char const_value_is_packed_array(const_value_t* v)
+{
+    return v->kind == CVK_ARRAY
+        && v->value.m->kind == MVK_PACKED;
+}
+
+// Returns a buffer with the elements of a packed array that must be freed
+// by the caller. This function is for supporting Fortran modules
+char* const_value_packed_array_get_raw_data(const_value_t* v, size_t *size)
+{
+    ERROR_CONDITION(!const_value_is_packed_array(v), "This is not a packed array", 0);
+
+    const_packed_values_t* packed = v->value.m->packed;
+    size_t data_size = packed_element_size(packed) * (size_t)v->value.m->num_elements;
+
+    packed_array_raw_header_t header;
+    memset(&header, 0, sizeof(header));
+    header.element_kind = packed->element_kind;
+    header.num_bytes = packed->num_bytes;
+    header.sign = packed->sign;
+    header.num_elements = v->value.m->num_elements;
+
+    *size = sizeof(header) + data_size;
+    char* result = xmalloc(*size);
+    memcpy(result, &header, sizeof(header));
+    memcpy(result + sizeof(header), packed->data, data_size);
+
+    return result;
+}
+
+// This function is for supporting Fortran modules
+const_value_t* const_value_build_packed_array_from_raw_data(const char* raw_buffer, size_t size)
+{
+    ERROR_CONDITION(size < sizeof(packed_array_raw_header_t), "Invalid raw data of packed array", 0);
+
+    packed_array_raw_header_t header;
+    memcpy(&header, raw_buffer, sizeof(header));
+
+    const_packed_values_t* packed = new_packed_values(header.element_kind,
+            header.num_bytes, header.sign, header.num_elements);
+    size_t data_size = packed_element_size(packed) * (size_t)header.num_elements;
+    ERROR_CONDITION(size != sizeof(header) + data_size, "Invalid raw data of packed array", 0);
+
+    memcpy(packed->data, raw_buffer + sizeof(header), data_size);
+
+    const_value_t* result = make_packed_multival(header.num_elements, packed);
+    result->kind = CVK_ARRAY;
+
+    return const_value_return_unique(result);
+}
+
 static const_value_t* reduce_lexicographic_lt(
         const_value_t* (*fun)(const_value_t*, const_value_t*),
         const_value_t* lhs,
@@ -4605,7 +5334,7 @@ const char* const_value_to_str(const_value_t* cval)
                         result = strappend(result, ", ");
                     }
 
-                    result = strappend(result, const_value_to_str(cval->value.m->elements[i]));
+                    result = strappend(result, const_value_to_str(multival_get_element_num(cval, i)));
                 }
                 result = strappend(result, "]}");
                 break;
@@ -4621,7 +5350,7 @@ const char* const_value_to_str(const_value_t* cval)
                         result = strappend(result, ", ");
                     }
 
-                    result = strappend(result, const_value_to_str(cval->value.m->elements[i]));
+                    result = strappend(result, const_value_to_str(multival_get_element_num(cval, i)));
                 }
                 result = strappend(result, "]}");
                 break;
@@ -4640,7 +5369,7 @@ const char* const_value_to_str(const_value_t* cval)
                         result = strappend(result, ", ");
                     }
 
-                    result = strappend(result, const_value_to_str(cval->value.m->elements[i]));
+                    result = strappend(result, const_value_to_str(multival_get_element_num(cval, i)));
                 }
                 result = strappend(result, "]}");
                 break;
@@ -4659,7 +5388,7 @@ const char* const_value_to_str(const_value_t* cval)
                             result = strappend(result, ", ");
                         }
 
-                        result = strappend(result, const_value_to_str(cval->value.m->elements[i]));
+                        result = strappend(result, const_value_to_str(multival_get_element_num(cval, i)));
                     }
                     result = strappend(result, "]}");
                 }
@@ -4697,7 +5426,7 @@ const char* const_value_to_str(const_value_t* cval)
                         result = strappend(result, ", ");
                     }
 
-                    result = strappend(result, const_value_to_str(cval->value.m->elements[i]));
+                    result = strappend(result, const_value_to_str(multival_get_element_num(cval, i)));
                 }
                 result = strappend(result, "]}");
                 break;
@@ -4713,7 +5442,7 @@ const char* const_value_to_str(const_value_t* cval)
                         result = strappend(result, ", ");
                     }
 
-                    result = strappend(result, const_value_to_str(cval->value.m->elements[i]));
+                    result = strappend(result, const_value_to_str(multival_get_element_num(cval, i)));
                 }
                 result = strappend(result, "]}");
                 break;
@@ -195,6 +195,10 @@ LIBMCXX_EXTERN const_value_t* const_value_make_range(const_value_t* lower, const
 
 LIBMCXX_EXTERN const_value_t* const_value_make_vector_from_scalar(int num_elements, const_value_t* value);
 LIBMCXX_EXTERN const_value_t* const_value_make_array_from_scalar(int num_elements, const_value_t* value);
+LIBMCXX_EXTERN const_value_t* const_value_array_gather(const_value_t* v, int num_indexes, const int* indexes);
+LIBMCXX_EXTERN const_value_t* const_value_array_concat(int num_arrays, const_value_t** arrays);
+LIBMCXX_EXTERN const_value_t* const_value_array_reduce(const_value_t* (*combine)(const_value_t*, const_value_t*),
+        const_value_t* v);
 
 // If you want to create a null ended string with this one you will have to
 // explicitly pass the null value as the last element (i.e. num_elements > 1)
@@ -279,6 +283,9 @@ LIBMCXX_EXTERN const_value_t* const_value_sqrt(const_value_t* val);
 // Fortran module support
 LIBMCXX_EXTERN size_t const_value_get_raw_data_size(void);
 LIBMCXX_EXTERN const_value_t* const_value_build_from_raw_data(const char*);
+LIBMCXX_EXTERN char const_value_is_packed_array(const_value_t* v);
+LIBMCXX_EXTERN char* const_value_packed_array_get_raw_data(const_value_t* v, size_t *size);
+LIBMCXX_EXTERN const_value_t* const_value_build_packed_array_from_raw_data(const char* raw_buffer, size_t size);
 
 // Debugging
 LIBMCXX_EXTERN const char* const_value_to_str(const_value_t*);
@@ -7934,6 +7934,22 @@ static void check_binary_expression_(node_t node_kind,
 }
 
 
+void check_nodecl_binary_expression(node_t node_kind,
+        nodecl_t nodecl_lhs,
+        nodecl_t nodecl_rhs,
+        const decl_context_t* decl_context,
+        const locus_t* locus,
+        nodecl_t* nodecl_output)
+{
+    check_binary_expression_(node_kind,
+            &nodecl_lhs,
+            &nodecl_rhs,
+            decl_context,
+            locus,
+            nodecl_output);
+}
+
+
 static void check_binary_expression(AST expression, const decl_context_t* decl_context, nodecl_t* nodecl_output)
 {
     AST lhs = ASTSon0(expression);
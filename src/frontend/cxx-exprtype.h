@@ -217,6 +217,14 @@ LIBMCXX_EXTERN nodecl_t cxx_nodecl_make_function_call(
         type_t* t,
         const decl_context_t*,
         const locus_t* locus);
+// Checks a binary operation (e.g. NODECL_ADD) of already checked operands
+LIBMCXX_EXTERN void check_nodecl_binary_expression(node_t node_kind,
+        nodecl_t nodecl_lhs,
+        nodecl_t nodecl_rhs,
+        const decl_context_t* decl_context,
+        const locus_t* locus,
+        nodecl_t* nodecl_output);
+
 LIBMCXX_EXTERN nodecl_t cxx_nodecl_make_conversion(nodecl_t expr, type_t* dest_type,
         const decl_context_t* decl_context,
         const locus_t* locus);
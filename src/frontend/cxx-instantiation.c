@@ -2220,11 +2220,32 @@ struct instantiation_item_tag
 static instantiation_item_t** symbols_to_instantiate;
 static int num_symbols_to_instantiate;
 
+// Every symbol ever queued in this translation unit, so we do not have to
+// requeue (and recheck) them
+static dhash_ptr_t* queued_symbols_to_instantiate = NULL;
+
+// Template functions already checked for pragmas in their body, see
+// template_function_body_has_pragmas
+static dhash_ptr_t* template_functions_with_pragmas = NULL;
+static dhash_ptr_t* template_functions_without_pragmas = NULL;
+
 void instantiation_init(void)
 {
     nodecl_instantiation_units = nodecl_null();
     symbols_to_instantiate = NULL;
     num_symbols_to_instantiate = 0;
+
+    if (queued_symbols_to_instantiate != NULL)
+        dhash_ptr_destroy(queued_symbols_to_instantiate);
+    queued_symbols_to_instantiate = dhash_ptr_new(5);
+
+    if (template_functions_with_pragmas != NULL)
+        dhash_ptr_destroy(template_functions_with_pragmas);
+    template_functions_with_pragmas = dhash_ptr_new(5);
+
+    if (template_functions_without_pragmas != NULL)
+        dhash_ptr_destroy(template_functions_without_pragmas);
+    template_functions_without_pragmas = dhash_ptr_new(5);
 }
 
 static void instantiate_every_symbol(scope_entry_t* entry,
@@ -2263,6 +2284,61 @@ static void mark_class_and_bases_as_user_declared(scope_entry_t* sym)
     }
 }
 
+static char nodecl_contains_pragmas(nodecl_t n)
+{
+    if (nodecl_is_null(n))
+        return 0;
+
+    switch (nodecl_get_kind(n))
+    {
+        case NODECL_PRAGMA_CUSTOM_DIRECTIVE:
+        case NODECL_PRAGMA_CUSTOM_STATEMENT:
+        case NODECL_PRAGMA_CUSTOM_DECLARATION:
+            return 1;
+        default:
+            break;
+    }
+
+    int i;
+    for (i = 0; i < MCXX_MAX_AST_CHILDREN; i++)
+    {
+        if (nodecl_contains_pragmas(nodecl_get_child(n, i)))
+            return 1;
+    }
+
+    return 0;
+}
+
+// States if the template body 'entry' is instantiated from contains
+// pragmas. Such instantiations must be seen by the compiler phases
+static char template_function_body_has_pragmas(scope_entry_t* entry)
+{
+    if (is_template_specialized_type(entry->type_information))
+    {
+        entry =
+            named_type_get_symbol(
+                    template_type_get_primary_type(
+                        template_specialized_type_get_related_template_type(entry->type_information)));
+    }
+
+    scope_entry_t* emission_template = symbol_entity_specs_get_emission_template(entry);
+    if (emission_template == NULL)
+        return 0;
+
+    if (dhash_ptr_query(template_functions_with_pragmas, (const char*)emission_template) != NULL)
+        return 1;
+    if (dhash_ptr_query(template_functions_without_pragmas, (const char*)emission_template) != NULL)
+        return 0;
+
+    char has_pragmas = nodecl_contains_pragmas(
+            symbol_entity_specs_get_function_code(emission_template));
+    dhash_ptr_insert(
+            has_pragmas ? template_functions_with_pragmas : template_functions_without_pragmas,
+            (const char*)emission_template, emission_template);
+
+    return has_pragmas;
+}
+
 void instantiation_instantiate_pending_functions(nodecl_t* nodecl_output)
 {
     while (num_symbols_to_instantiate > 0)
@@ -2273,12 +2349,31 @@ void instantiation_instantiate_pending_functions(nodecl_t* nodecl_output)
         num_symbols_to_instantiate = 0;
         symbols_to_instantiate = NULL;
 
+        // Every wave instantiates the functions required by the previous
+        // one, so functions are instantiated after those requiring them
         int i;
         for (i = 0; i < tmp_num_symbols_to_instantiate; i++)
         {
-            instantiate_every_symbol(
-                    tmp_symbols_to_instantiate[i]->symbol,
-                    tmp_symbols_to_instantiate[i]->locus);
+            // Functions required by the compiler itself (like constexpr
+            // functions) have already been instantiated. With
+            // --instantiate=needed the remaining ones are left to the native
+            // compiler unless their body has pragmas the phases must see
+            if (CURRENT_CONFIGURATION->explicit_instantiation_only_needed
+                    && !template_function_body_has_pragmas(tmp_symbols_to_instantiate[i]->symbol))
+            {
+                DEBUG_CODE()
+                {
+                    fprintf(stderr, "INSTANTIATION: Leaving '%s' to the native compiler\n",
+                            get_qualified_symbol_name(tmp_symbols_to_instantiate[i]->symbol,
+                                tmp_symbols_to_instantiate[i]->symbol->decl_context));
+                }
+            }
+            else
+            {
+                instantiate_every_symbol(
+                        tmp_symbols_to_instantiate[i]->symbol,
+                        tmp_symbols_to_instantiate[i]->locus);
+            }
 
 
             DELETE(tmp_symbols_to_instantiate[i]);
@@ -2508,30 +2603,27 @@ void instantiation_instantiate_pending_functions(nodecl_t* nodecl_output)
     DELETE(list);
 }
 
-static char compare_instantiate_items(instantiation_item_t* current_item, instantiation_item_t* new_item)
-{
-    return current_item->symbol == new_item->symbol;
-}
-
 void instantiation_add_symbol_to_instantiate(scope_entry_t* entry,
         const locus_t* locus)
 {
+    if (symbol_entity_specs_get_is_instantiated(entry))
+        return;
+
+    if (queued_symbols_to_instantiate == NULL)
+        queued_symbols_to_instantiate = dhash_ptr_new(5);
+
+    if (dhash_ptr_query(queued_symbols_to_instantiate, (const char*)entry) != NULL)
+        return;
+
+    dhash_ptr_insert(queued_symbols_to_instantiate, (const char*)entry, entry);
+
     instantiation_item_t* item = NEW0(instantiation_item_t);
     item->symbol = entry;
     item->locus = locus;
 
-    int old_num = num_symbols_to_instantiate;
-
-    P_LIST_ADD_ONCE_FUN(symbols_to_instantiate,
+    P_LIST_ADD(symbols_to_instantiate,
             num_symbols_to_instantiate,
-            item,
-            compare_instantiate_items);
-
-    // Crummy way to know if it was added
-    if (old_num == num_symbols_to_instantiate)
-    {
-        DELETE(item);
-    }
+            item);
 }
 
 static char instantiate_true_template_function(scope_entry_t* entry, const locus_t* locus UNUSED_PARAMETER)
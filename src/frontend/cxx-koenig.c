@@ -36,6 +36,7 @@
 #include "cxx-typeutils.h"
 #include "cxx-utils.h"
 #include "cxx-entrylist.h"
+#include "dhash_ptr.h"
 
 // Koenig lookup may need to instantiate something
 #include "cxx-instantiation.h"
@@ -203,6 +204,125 @@ static void compute_associated_scopes(
     compute_associated_scopes_aux(result, num_arguments, argument_type_list, locus);
 }
 
+/*
+ * Cache of associated scopes and classes
+ *
+ * The associated sets of a type only change when one of its associated
+ * classes is completed or gains a base. Sets whose associated classes are all
+ * complete cannot change anymore and are kept forever. The remaining ones are
+ * only valid while no class has been completed or gained a base since they
+ * were computed (tracked by _koenig_cache_generation).
+ */
+typedef
+struct koenig_cache_item_tag
+{
+    koenig_lookup_info_t info;
+    char is_final;
+    unsigned int generation;
+} koenig_cache_item_t;
+
+static dhash_ptr_t* _koenig_cache = NULL;
+static unsigned int _koenig_cache_generation = 0;
+
+static unsigned long long _koenig_cache_hits = 0;
+static unsigned long long _koenig_cache_misses = 0;
+static unsigned long long _koenig_cache_stale = 0;
+
+void koenig_lookup_invalidate_cache(void)
+{
+    _koenig_cache_generation++;
+}
+
+void koenig_lookup_cache_stats(void)
+{
+    unsigned long long total = _koenig_cache_hits + _koenig_cache_misses;
+
+    fprintf(stderr, "Argument dependent lookup cache statistics\n");
+    fprintf(stderr, "==========================================\n\n");
+
+    fprintf(stderr, "Number of queries: %llu\n", total);
+    fprintf(stderr, "Number of hits: %llu\n", _koenig_cache_hits);
+    fprintf(stderr, "Number of misses: %llu\n", _koenig_cache_misses);
+    fprintf(stderr, "Number of misses due to stale entries: %llu\n", _koenig_cache_stale);
+    fprintf(stderr, "Number of invalidations: %u\n", _koenig_cache_generation);
+    fprintf(stderr, "Hit rate: %.2f%%\n",
+            total == 0 ? 0.0 : (100.0 * (double)_koenig_cache_hits / (double)total));
+}
+
+static void add_associated_scope(koenig_lookup_info_t* koenig_info, scope_t* sc);
+static void add_associated_class(koenig_lookup_info_t* koenig_info, scope_entry_t* class_symbol);
+
+static void merge_associated_info(koenig_lookup_info_t* koenig_info,
+        koenig_lookup_info_t* argument_info)
+{
+    int i;
+    for (i = 0; i < argument_info->num_associated_scopes; i++)
+    {
+        P_LIST_ADD_ONCE(koenig_info->associated_scopes,
+                koenig_info->num_associated_scopes,
+                argument_info->associated_scopes[i]);
+    }
+
+    for (i = 0; i < argument_info->num_associated_classes; i++)
+    {
+        add_associated_class(koenig_info, argument_info->associated_classes[i]);
+    }
+}
+
+static char associated_info_is_final(koenig_lookup_info_t* koenig_info)
+{
+    int i;
+    for (i = 0; i < koenig_info->num_associated_classes; i++)
+    {
+        if (!is_complete_type(koenig_info->associated_classes[i]->type_information))
+            return 0;
+    }
+
+    return 1;
+}
+
+static koenig_cache_item_t* get_cached_associated_info(
+        type_t* argument_type,
+        const locus_t* locus)
+{
+    if (_koenig_cache == NULL)
+    {
+        _koenig_cache = dhash_ptr_new(5);
+    }
+
+    koenig_cache_item_t* item =
+        (koenig_cache_item_t*)dhash_ptr_query(_koenig_cache, (const char*)argument_type);
+
+    if (item != NULL)
+    {
+        if (item->is_final
+                || item->generation == _koenig_cache_generation)
+        {
+            _koenig_cache_hits++;
+            return item;
+        }
+
+        _koenig_cache_stale++;
+        DELETE(item->info.associated_scopes);
+        DELETE(item->info.associated_classes);
+    }
+    else
+    {
+        item = NEW(koenig_cache_item_t);
+        dhash_ptr_insert(_koenig_cache, (const char*)argument_type, item);
+    }
+    _koenig_cache_misses++;
+
+    memset(&item->info, 0, sizeof(item->info));
+    compute_associated_scopes_rec(&item->info, argument_type, locus);
+
+    // Computing the sets may have completed (instantiated) classes
+    item->is_final = associated_info_is_final(&item->info);
+    item->generation = _koenig_cache_generation;
+
+    return item;
+}
+
 static void compute_associated_scopes_aux(koenig_lookup_info_t* koenig_info, 
         int num_arguments, type_t** argument_type_list,
         const locus_t* locus)
@@ -210,8 +330,20 @@ static void compute_associated_scopes_aux(koenig_lookup_info_t* koenig_info,
     int i;
     for (i = 0; i < num_arguments; i++)
     {
-        type_t* argument_type = argument_type_list[i];
-        compute_associated_scopes_rec(koenig_info, argument_type, locus);
+        type_t* argument_type = get_unqualified_type(
+                no_ref(advance_over_typedefs(argument_type_list[i])));
+
+        if (is_fundamental_type(argument_type))
+            continue;
+
+        if (is_dependent_type(argument_type))
+        {
+            compute_associated_scopes_rec(koenig_info, argument_type, locus);
+            continue;
+        }
+
+        koenig_cache_item_t* item = get_cached_associated_info(argument_type, locus);
+        merge_associated_info(koenig_info, &item->info);
     }
 }
 
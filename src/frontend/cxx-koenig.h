@@ -44,6 +44,11 @@ LIBMCXX_EXTERN scope_entry_list_t* koenig_lookup(
         nodecl_t nodecl_simple_name,
         const locus_t* locus);
 
+// Must be called whenever a class is completed or gains a base
+LIBMCXX_EXTERN void koenig_lookup_invalidate_cache(void);
+
+LIBMCXX_EXTERN void koenig_lookup_cache_stats(void);
+
 MCXX_END_DECLS
 
 #endif // CXX_KOENIG_H
@@ -166,6 +166,7 @@ static inline const char* nodecl_get_text(nodecl_t n)
 static inline void nodecl_set_text(nodecl_t n, const char *c)
 {
     ast_set_text(n.tree, c);
+    _nodecl_mark_modified(n);
 }
 
 static inline type_t* nodecl_get_type(nodecl_t t)
@@ -176,6 +177,7 @@ static inline type_t* nodecl_get_type(nodecl_t t)
 static inline void nodecl_set_type(nodecl_t t, type_t* type)
 {
     nodecl_expr_set_type(t.tree, type);
+    _nodecl_mark_modified(t);
 }
 
 static inline char nodecl_is_constant(nodecl_t t)
@@ -191,6 +193,7 @@ static inline const_value_t* nodecl_get_constant(nodecl_t t)
 static inline void nodecl_set_constant(nodecl_t t, const_value_t* cval)
 {
     nodecl_expr_set_constant(t.tree, cval);
+    _nodecl_mark_modified(t);
 }
 
 static inline const locus_t* nodecl_get_locus(nodecl_t t)
@@ -280,10 +283,21 @@ static inline scope_entry_t* nodecl_get_symbol(nodecl_t node)
 static inline void nodecl_set_symbol(nodecl_t node, scope_entry_t* entry)
 {
     nodecl_expr_set_symbol(node.tree, entry);
+    _nodecl_mark_modified(node);
 }
 
 static inline nodecl_t nodecl_duplicate(nodecl_t t)
 {
+    switch (nodecl_get_kind(t))
+    {
+        case NODECL_PRAGMA_CUSTOM_DIRECTIVE:
+        case NODECL_PRAGMA_CUSTOM_STATEMENT:
+        case NODECL_PRAGMA_CUSTOM_DECLARATION:
+            nodecl_note_pragma_custom_made();
+            break;
+        default:
+            break;
+    }
     return _nodecl_wrap(ast_duplicate_one_node(nodecl_get_ast(t)));
 }
 
@@ -444,6 +458,30 @@ static inline nodecl_t nodecl_generic_make(node_t kind, const locus_t* location)
 static inline void nodecl_set_child(nodecl_t n, int nc, nodecl_t c)
 {
     ast_set_child(nodecl_get_ast(n), nc, nodecl_get_ast(c));
+    _nodecl_mark_modified(n);
+}
+
+static inline unsigned int nodecl_get_modification_count(nodecl_t n)
+{
+    // Modifications done after this read must be seen by the caller,
+    // so they cannot stop at the nodes already marked in this epoch
+    _nodecl_modification_epoch++;
+    return ast_get_modification_count(nodecl_get_ast(n));
+}
+
+static inline void _nodecl_mark_modified(nodecl_t n)
+{
+    AST a = nodecl_get_ast(n);
+    while (a != NULL)
+    {
+        // The ancestors of a node marked in this epoch have already been
+        // marked, this keeps repeated modifications inside long lists linear
+        if (ast_get_modification_count(a) == _nodecl_modification_epoch)
+            break;
+
+        ast_set_modification_count(a, _nodecl_modification_epoch);
+        a = ast_get_parent(a);
+    }
 }
 
 static inline void nodecl_set_locus(nodecl_t n, const locus_t* locus)
@@ -45,6 +45,21 @@
 //    Implemented in cxx-nodecl-shallow-copy.c
 // }
 
+// Fresh nodes have a modification count of zero, so start after it
+unsigned int _nodecl_modification_epoch = 1;
+
+static unsigned int _num_pragma_custom_made = 0;
+
+unsigned int nodecl_get_num_pragma_custom_made(void)
+{
+    return _num_pragma_custom_made;
+}
+
+void nodecl_note_pragma_custom_made(void)
+{
+    _num_pragma_custom_made++;
+}
+
 #if 0
 char nodecl_is_in_list(nodecl_t n)
 {
@@ -67,8 +82,15 @@ void nodecl_replace(nodecl_t old_node, nodecl_t new_node)
         new_node = nodecl_make_list_1(new_node);
     }
 
+    // Keep the modification count of the replaced node, it is still the same
+    // node for its ancestors
+    _nodecl_mark_modified(old_node);
+    unsigned int modification_count = ast_get_modification_count(old_node.tree);
+
     ast_replace(old_node.tree, new_node.tree);
 
+    ast_set_modification_count(old_node.tree, modification_count);
+
     // If the new node is a placeholder, transfer it to point to old_node
     AST *p = nodecl_get_placeholder(new_node);
     if (p != NULL)
@@ -27,6 +27,7 @@
 #ifndef CXX_NODECL_H
 #define CXX_NODECL_H
 
+#include "libmcxx-common.h"
 #include "cxx-macros.h"
 #include "cxx-cexpr-fwd.h"
 #include "cxx-scope-decls.h"
@@ -63,6 +64,20 @@ static inline void nodecl_set_parent(nodecl_t node, nodecl_t parent);
 // Children
 static inline nodecl_t nodecl_get_child(nodecl_t n, int i);
 
+// Modification count. It changes every time the node or any of its
+// descendants is modified using nodecl_set_child, nodecl_replace or setting
+// its text, type, constant or symbol. The change reaches every ancestor, so
+// the count of a function covers its body and the count of a top level item
+// covers the functions nested in it (e.g. Fortran internal subprograms).
+//
+// The count is not the number of modifications but the modification epoch
+// of the node: only compare it for equality with a value read before.
+// Every read starts a new epoch and marking a node stops at the first
+// ancestor already marked in the current epoch
+static inline unsigned int nodecl_get_modification_count(nodecl_t n);
+static inline void _nodecl_mark_modified(nodecl_t n);
+LIBMCXX_EXTERN unsigned int _nodecl_modification_epoch;
+
 // Constant values
 static inline char nodecl_is_constant(nodecl_t t);
 static inline void nodecl_set_constant(nodecl_t t, const_value_t* cval);
@@ -167,6 +182,11 @@ nodecl_t nodecl_make_from_ast_nodecl_literal(AST);
 AST* nodecl_get_placeholder(nodecl_t n);
 void nodecl_set_placeholder(nodecl_t n, AST* p);
 
+// Number of NODECL_PRAGMA_CUSTOM_{DIRECTIVE,STATEMENT,DECLARATION} nodes
+// created so far
+unsigned int nodecl_get_num_pragma_custom_made(void);
+void nodecl_note_pragma_custom_made(void);
+
 MCXX_END_DECLS
 
 #include "cxx-nodecl-inline.h"
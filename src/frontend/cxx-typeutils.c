@@ -50,6 +50,7 @@
 #include "cxx-intelsupport.h"
 
 #include "cxx-symbol-deep-copy.h"
+#include "cxx-koenig.h"
 
 #include "fortran03-scope.h"
 
@@ -6921,6 +6922,8 @@ extern inline void class_type_add_base_class(type_t* class_type, scope_entry_t*
     class_info_t* class_info = class_type->type->class_info;
     // Only add once
     P_LIST_ADD_ONCE(class_info->base_classes_list, class_info->num_bases, new_base_class);
+
+    koenig_lookup_invalidate_cache();
 }
 
 void class_type_set_inner_context(type_t* class_type, const decl_context_t* decl_context)
@@ -14326,6 +14329,13 @@ extern inline char is_complete_type(type_t* t)
 extern inline void set_is_incomplete_type(type_t* t, char is_incomplete)
 {
     t = canonical_type(t);
+    if (t->info->is_incomplete
+            && !is_incomplete
+            && is_unnamed_class_type(t))
+    {
+        // Associated sets of argument dependent lookup may change
+        koenig_lookup_invalidate_cache();
+    }
     t->info->is_incomplete = is_incomplete;
 }
 
@@ -1507,6 +1507,7 @@ static void build_scope_module_program_unit(AST program_unit,
 
 
     // Keep the module in the file's module cache
+    fortran_register_intrinsic_modules_if_needed();
     rb_tree_insert(CURRENT_COMPILED_FILE->module_file_cache, strtolower(new_entry->symbol_name), new_entry);
 
     // Store the module in a file
@@ -9161,6 +9162,8 @@ scope_entry_t* fortran_load_module(const char* module_name_str, char must_be_int
         fprintf(stderr, "BUILDSCOPE: Loading module '%s'\n", module_name_str);
     }
 
+    fortran_register_intrinsic_modules_if_needed();
+
     rb_red_blk_node* query = rb_tree_query(CURRENT_COMPILED_FILE->module_file_cache, module_name_str);
 
     char must_load = 1;
@@ -10821,29 +10824,15 @@ scope_entry_t* function_get_result_symbol(scope_entry_t* entry)
     return symbol_entity_specs_get_result_var(entry);
 }
 
+// External procedures of the file indexed by their (unique) name
 static scope_entry_t* symbol_name_is_in_external_list(const char *name,
-        scope_entry_list_t* external_function_list)
+        dhash_ptr_t* external_functions)
 {
-    scope_entry_list_iterator_t* it;
-    for (it = entry_list_iterator_begin(external_function_list);
-            !entry_list_iterator_end(it);
-            entry_list_iterator_next(it))
-    {
-        scope_entry_t* current = entry_list_iterator_current(it);
-
-        if (strcmp(current->symbol_name, name) == 0)
-        {
-            entry_list_iterator_free(it);
-            return current;
-        }
-    }
-    entry_list_iterator_free(it);
-
-    return NULL;
+    return (scope_entry_t*)dhash_ptr_query(external_functions, uniquestr(name));
 }
 
 static void resolve_external_calls_rec(nodecl_t node,
-        scope_entry_list_t* external_function_list)
+        dhash_ptr_t* external_functions)
 {
     if (nodecl_is_null(node))
         return;
@@ -10853,7 +10842,7 @@ static void resolve_external_calls_rec(nodecl_t node,
     {
         resolve_external_calls_rec(
                 nodecl_get_child(node, i),
-                external_function_list);
+                external_functions);
     }
 
     // We only fix up function calls, function references in actual arguments are not considered
@@ -10879,7 +10868,7 @@ static void resolve_external_calls_rec(nodecl_t node,
                         entry->symbol_name);
             }
 
-            scope_entry_t* external_symbol = symbol_name_is_in_external_list(entry->symbol_name, external_function_list);
+            scope_entry_t* external_symbol = symbol_name_is_in_external_list(entry->symbol_name, external_functions);
             if (external_symbol != NULL)
             {
                 // Now we should check the types
@@ -10919,13 +10908,13 @@ static void resolve_external_calls_rec(nodecl_t node,
 }
 
 static void resolve_external_calls_inside_a_function(nodecl_t function_code,
-        scope_entry_list_t* external_function_list)
+        dhash_ptr_t* external_functions)
 {
     nodecl_t body = nodecl_get_child(function_code, 0);
 
     nodecl_t internals = nodecl_get_child(function_code, 1);
 
-    resolve_external_calls_rec(body, external_function_list);
+    resolve_external_calls_rec(body, external_functions);
 
     int i, n = 0;
     nodecl_t* list = nodecl_unpack_list(internals, &n);
@@ -10934,7 +10923,7 @@ static void resolve_external_calls_inside_a_function(nodecl_t function_code,
     {
         if (nodecl_get_kind(list[i]) == NODECL_FUNCTION_CODE)
         {
-            resolve_external_calls_inside_a_function(list[i], external_function_list);
+            resolve_external_calls_inside_a_function(list[i], external_functions);
         }
     }
 
@@ -10955,7 +10944,7 @@ static void resolve_external_calls_inside_file(nodecl_t nodecl_program_units)
     int i, n = 0;
     nodecl_t* list = nodecl_unpack_list(nodecl_program_units, &n);
 
-    scope_entry_list_t* external_function_list = NULL;
+    dhash_ptr_t* external_functions = dhash_ptr_new(5);
 
     for (i = 0; i < n; i++)
     {
@@ -10974,7 +10963,10 @@ static void resolve_external_calls_inside_file(nodecl_t nodecl_program_units)
                             nodecl_locus_to_str(list[i]),
                             function->symbol_name);
                 }
-                external_function_list = entry_list_add(external_function_list, function);
+                // If several program units share a name keep the first one
+                const char* name = uniquestr(function->symbol_name);
+                if (dhash_ptr_query(external_functions, name) == NULL)
+                    dhash_ptr_insert(external_functions, name, function);
             }
         }
     }
@@ -10984,11 +10976,12 @@ static void resolve_external_calls_inside_file(nodecl_t nodecl_program_units)
     {
         if (nodecl_get_kind(list[i]) == NODECL_FUNCTION_CODE)
         {
-            resolve_external_calls_inside_a_function(list[i], external_function_list);
+            resolve_external_calls_inside_a_function(list[i], external_functions);
         }
     }
 
     DELETE(list);
+    dhash_ptr_destroy(external_functions);
 
     DEBUG_CODE()
     {
@@ -65,6 +65,29 @@ static void fortran_flatten_array_rec(const_value_t* v, const_value_t*** scalar_
 
 const_value_t* fortran_flatten_array(const_value_t* v)
 {
+    // A packed array has scalar elements, so it is already flat
+    if (const_value_is_packed_array(v))
+        return v;
+
+    if (const_value_is_array(v)
+            && const_value_get_num_elements(v) > 0
+            && const_value_is_array(const_value_get_element_num(v, 0)))
+    {
+        // Concatenate the flattened subarrays, which keeps packed ones packed
+        int i, N = const_value_get_num_elements(v);
+        const_value_t** flattened_subarrays = NEW_VEC(const_value_t*, N);
+        for (i = 0; i < N; i++)
+        {
+            flattened_subarrays[i] = fortran_flatten_array(const_value_get_element_num(v, i));
+        }
+
+        const_value_t* result = const_value_array_concat(N, flattened_subarrays);
+
+        DELETE(flattened_subarrays);
+
+        return result;
+    }
+
     int N = fortran_flatten_array_count_elements(v);
     const_value_t** flattened_items = NEW_VEC0(const_value_t*, N);
 
@@ -133,6 +156,36 @@ const_value_t* fortran_flatten_array_with_mask(const_value_t* v, const_value_t*
     if (mask == NULL)
         return fortran_flatten_array(v);
 
+    if (const_value_is_array(v)
+            && const_value_is_array(mask))
+    {
+        // Select the elements of the flattened array, so the elements of
+        // packed arrays are not boxed
+        const_value_t* flattened_array = fortran_flatten_array(v);
+        const_value_t* flattened_mask = fortran_flatten_array(mask);
+
+        int i, N = const_value_get_num_elements(flattened_array);
+        if (N != const_value_get_num_elements(flattened_mask))
+            return NULL;
+
+        int num_selected = 0;
+        int* selected = NEW_VEC(int, N);
+        for (i = 0; i < N; i++)
+        {
+            if (const_value_is_nonzero(const_value_get_element_num(flattened_mask, i)))
+            {
+                selected[num_selected] = i;
+                num_selected++;
+            }
+        }
+
+        const_value_t* result = const_value_array_gather(flattened_array, num_selected, selected);
+
+        DELETE(selected);
+
+        return result;
+    }
+
     int N = fortran_flatten_array_count_elements_with_mask(v, mask);
     if (N < 0)
         return NULL;
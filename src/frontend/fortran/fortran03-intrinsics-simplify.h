@@ -1234,8 +1234,35 @@ static const_value_t* reshape_array_from_flattened_rec(
     {
         int i;
         int current_rank = N - rank - 1;
-        subscript[current_rank] = 0;
         int size = shape[current_rank];
+
+        if (rank + 1 == N)
+        {
+            // Gather the whole row at once, so the elements of a packed
+            // array are not boxed one by one
+            int num_source_elements = const_value_get_num_elements(flattened_array);
+            int* indexes = NEW_VEC(int, size);
+            char all_in_source = 1;
+            for (i = 0; i < size && all_in_source; i++)
+            {
+                subscript[current_rank] = i;
+                int index_ = 0;
+                determine_lineal_index_of_array_subscript(N, subscript, factors, &index_);
+
+                all_in_source = (0 <= index_ && index_ < num_source_elements);
+                indexes[i] = index_;
+            }
+
+            if (all_in_source)
+            {
+                const_value_t* row = const_value_array_gather(flattened_array, size, indexes);
+                DELETE(indexes);
+                return row;
+            }
+            DELETE(indexes);
+        }
+
+        subscript[current_rank] = 0;
         const_value_t* result[size];
         for (i = 0; i < size; i++)
         {
@@ -1373,6 +1400,66 @@ static nodecl_t simplify_reshape(scope_entry_t* entry UNUSED_PARAMETER, int num_
     return nodecl_null();
 }
 
+static nodecl_t simplify_pack(scope_entry_t* entry UNUSED_PARAMETER, int num_arguments UNUSED_PARAMETER, nodecl_t* arguments)
+{
+    nodecl_t array = arguments[0];
+    nodecl_t mask = arguments[1];
+    nodecl_t vector = arguments[2];
+
+    if (!nodecl_is_constant(array)
+            || !nodecl_is_constant(mask)
+            || (!nodecl_is_null(vector) && !nodecl_is_constant(vector)))
+        return nodecl_null();
+
+    const_value_t* flattened_array = fortran_flatten_array(nodecl_get_constant(array));
+    const_value_t* mask_constant = nodecl_get_constant(mask);
+
+    const_value_t* val;
+    if (!const_value_is_array(mask_constant))
+    {
+        // A scalar mask selects all the elements or none
+        val = const_value_is_nonzero(mask_constant)
+            ? flattened_array
+            : const_value_make_array(0, NULL);
+    }
+    else
+    {
+        val = fortran_flatten_array_with_mask(nodecl_get_constant(array), mask_constant);
+    }
+    if (val == NULL)
+        return nodecl_null();
+
+    if (!nodecl_is_null(vector))
+    {
+        // Elements of VECTOR beyond those selected fill the result
+        const_value_t* flattened_vector = fortran_flatten_array(nodecl_get_constant(vector));
+        int num_selected = const_value_get_num_elements(val);
+        int num_vector = const_value_get_num_elements(flattened_vector);
+        if (num_vector < num_selected)
+            return nodecl_null();
+
+        int i, num_remaining = num_vector - num_selected;
+        int* indexes = NEW_VEC(int, num_remaining);
+        for (i = 0; i < num_remaining; i++)
+        {
+            indexes[i] = num_selected + i;
+        }
+
+        const_value_t* parts[2] = { val,
+            const_value_array_gather(flattened_vector, num_remaining, indexes) };
+        DELETE(indexes);
+
+        val = const_value_array_concat(2, parts);
+    }
+
+    // Empty arrays are not folded
+    if (const_value_get_num_elements(val) == 0)
+        return nodecl_null();
+
+    type_t *base_type = fortran_get_rank0_type(nodecl_get_type(array));
+    return const_value_to_nodecl_with_basic_type(val, base_type);
+}
+
 static nodecl_t simplify_repeat(scope_entry_t* entry UNUSED_PARAMETER, int num_arguments UNUSED_PARAMETER, nodecl_t* arguments)
 {
     if (!nodecl_is_constant(arguments[0])
@@ -1555,17 +1642,9 @@ static const_value_t* simplify_maxminval_aux(scope_entry_t* entry UNUSED_PARAMET
     {
         // Case 1) Reduce all values into a scalar
         const_value_t* values = fortran_flatten_array_with_mask(array_constant, mask_constant);
-        int num_values = const_value_get_num_elements(values);
-        if (num_values > 0)
+        const_value_t* reduced_val = const_value_array_reduce(combine, values);
+        if (reduced_val != NULL)
         {
-            const_value_t* reduced_val = const_value_get_element_num(values, 0);
-            int i;
-            for (i = 1; i < num_values; i++)
-            {
-                const_value_t* current_val = const_value_get_element_num(values, i);
-                reduced_val = combine(reduced_val, current_val);
-            }
-
             return reduced_val;
         }
         else
@@ -1714,6 +1793,40 @@ static nodecl_t simplify_maxval(scope_entry_t* entry UNUSED_PARAMETER, int num_a
             get_max_neuter_for_type(element_type));
 }
 
+static nodecl_t simplify_sum_product(scope_entry_t* entry, int num_arguments, nodecl_t* arguments,
+        const_value_t* (*combine)(const_value_t* a, const_value_t* b),
+        const_value_t* neuter)
+{
+    nodecl_t array = arguments[0];
+
+    type_t* array_type = no_ref(nodecl_get_type(array));
+    type_t* element_type = fortran_get_rank0_type(array_type);
+    int num_dimensions = fortran_get_rank_of_type(array_type);
+
+    if (!is_integer_type(element_type)
+            && !is_floating_type(element_type))
+        return nodecl_null();
+
+    return simplify_maxminval(
+            entry,
+            num_arguments, arguments,
+            num_dimensions,
+            combine,
+            const_value_convert_to_type(neuter, element_type));
+}
+
+static nodecl_t simplify_sum(scope_entry_t* entry UNUSED_PARAMETER, int num_arguments, nodecl_t* arguments)
+{
+    return simplify_sum_product(entry, num_arguments, arguments,
+            const_value_add, const_value_get_signed_int(0));
+}
+
+static nodecl_t simplify_product(scope_entry_t* entry UNUSED_PARAMETER, int num_arguments, nodecl_t* arguments)
+{
+    return simplify_sum_product(entry, num_arguments, arguments,
+            const_value_mul, const_value_get_signed_int(1));
+}
+
 static const_value_t* const_value_compute_min(const_value_t* a, const_value_t* b)
 {
     // a < b
@@ -223,13 +223,13 @@ FORTRAN_GENERIC_INTRINSIC(NULL, not, "I", E, NULL) \
 FORTRAN_GENERIC_INTRINSIC(NULL, norm2, "X,?DIM", T, NULL) \
 FORTRAN_GENERIC_INTRINSIC(NULL, null, "?MOLD", T, simplify_null) \
 FORTRAN_GENERIC_INTRINSIC(NULL, num_images, "", T, NULL) \
-FORTRAN_GENERIC_INTRINSIC(NULL, pack, "ARRAY,MASK,?VECTOR", T, NULL) \
+FORTRAN_GENERIC_INTRINSIC(NULL, pack, "ARRAY,MASK,?VECTOR", T, simplify_pack) \
 FORTRAN_GENERIC_INTRINSIC(NULL, parity, "ARRAY,?MASK", T, NULL) \
 FORTRAN_GENERIC_INTRINSIC(NULL, popcnt, "I", E, NULL) \
 FORTRAN_GENERIC_INTRINSIC(NULL, poppar, "I", E, NULL) \
 FORTRAN_GENERIC_INTRINSIC(NULL, precision, "X", I, simplify_precision) \
 FORTRAN_GENERIC_INTRINSIC(NULL, present, "A", I, NULL) \
-FORTRAN_GENERIC_INTRINSIC_2(NULL, product, "ARRAY,DIM,?MASK", T, NULL, "ARRAY,?MASK", T, NULL) \
+FORTRAN_GENERIC_INTRINSIC_2(NULL, product, "ARRAY,DIM,?MASK", T, simplify_product, "ARRAY,?MASK", T, simplify_product) \
 FORTRAN_GENERIC_INTRINSIC(NULL, radix, "X", I, simplify_radix) \
 FORTRAN_GENERIC_INTRINSIC(NULL, random_number, "HARVEST", S, NULL) \
 FORTRAN_GENERIC_INTRINSIC(NULL, random_seed, "?SIZE,?PUT,?GET", S, NULL) \
@@ -259,7 +259,7 @@ FORTRAN_GENERIC_INTRINSIC(NULL, spacing, "X", E, NULL) \
 FORTRAN_GENERIC_INTRINSIC(NULL, spread, "SOURCE,DIM,NCOPIES", T, NULL) \
 FORTRAN_GENERIC_INTRINSIC(NULL, sqrt, "X", E, simplify_sqrt) \
 FORTRAN_GENERIC_INTRINSIC(NULL, storage_size, "A,?KIND", I, NULL) \
-FORTRAN_GENERIC_INTRINSIC_2(NULL, sum, "ARRAY,DIM,?MASK", T, NULL, "ARRAY,?MASK", T, NULL) \
+FORTRAN_GENERIC_INTRINSIC_2(NULL, sum, "ARRAY,DIM,?MASK", T, simplify_sum, "ARRAY,?MASK", T, simplify_sum) \
 FORTRAN_GENERIC_INTRINSIC(NULL, system_clock, "?COUNT,?COUNT_RATE,?COUNT_MAX", S, NULL) \
 FORTRAN_GENERIC_INTRINSIC(NULL, tan, "X", E, simplify_tan) \
 FORTRAN_GENERIC_INTRINSIC(NULL, tanh, "X", E, simplify_tanh) \
@@ -1304,8 +1304,6 @@ static scope_entry_t* get_intrinsic_symbol_(
 
 static void null_dtor_func(const void *v UNUSED_PARAMETER) { }
 
-static void fortran_init_specific_names(const decl_context_t* decl_context);
-
 static void fortran_create_scope_for_intrinsics(const decl_context_t* decl_context);
 static void fortran_init_intrinsic_modules(const decl_context_t* decl_context);
 static void fortran_finish_intrinsic_modules(const decl_context_t* decl_context);
@@ -1327,13 +1325,168 @@ static char intrinsic_has_been_disabled(const char* c)
     return 0;
 }
 
-void fortran_init_intrinsics(const decl_context_t* decl_context)
+typedef
+struct intrinsic_descriptor_tag
 {
-    fortran_create_scope_for_intrinsics(decl_context);
+    const char* module_name;
+    const char* name;
+    intrinsic_kind_t kind;
+    computed_function_type_t keyword_compute;
+    simplify_function_t simplify;
+} intrinsic_descriptor_t;
+
+static intrinsic_descriptor_t _intrinsic_descriptors[] = {
+#define FORTRAN_GENERIC_INTRINSIC(module_name, name, keywords0, kind0, compute_code) \
+    { module_name, #name, kind0, keyword_compute_intrinsic_##name, compute_code },
+#define FORTRAN_GENERIC_INTRINSIC_2(module_name, name, keywords0, kind0, compute_code0, keywords1, kind1, compute_code1) \
+    FORTRAN_GENERIC_INTRINSIC(module_name, name, keywords0, kind0, compute_code0)
+FORTRAN_INTRINSIC_GENERIC_LIST
+#undef FORTRAN_GENERIC_INTRINSIC
+#undef FORTRAN_GENERIC_INTRINSIC_2
+};
+
+static scope_entry_t* register_generic_intrinsic(const decl_context_t* fortran_intrinsic_context,
+        const intrinsic_descriptor_t* descr)
+{
+    const decl_context_t* relevant_decl_context = fortran_intrinsic_context;
+    scope_entry_t* module_sym = NULL;
+    if (descr->module_name != NULL)
+    {
+        rb_red_blk_node* query = rb_tree_query(CURRENT_COMPILED_FILE->module_file_cache, descr->module_name);
+        ERROR_CONDITION(query == NULL, "Module '%s' has not been registered", descr->module_name);
+        module_sym = (scope_entry_t*)rb_node_get_info(query);
+        relevant_decl_context = module_sym->related_decl_context;
+    }
+    else if (intrinsic_has_been_disabled(descr->name))
+    {
+        return NULL;
+    }
+
+    scope_entry_t* new_intrinsic = new_symbol(relevant_decl_context, relevant_decl_context->current_scope, uniquestr(descr->name));
+    new_intrinsic->locus = make_locus("(fortran-intrinsic)", 0, 0);
+    new_intrinsic->kind = SK_FUNCTION;
+    new_intrinsic->do_not_print = 1;
+    new_intrinsic->type_information = get_computed_function_type(descr->keyword_compute);
+    symbol_entity_specs_set_is_global_hidden(new_intrinsic, (module_sym == NULL));
+    symbol_entity_specs_set_is_builtin(new_intrinsic, 1);
+    symbol_entity_specs_set_is_intrinsic_function(new_intrinsic, 1);
+    if (descr->kind == ES || descr->kind == PS || descr->kind == S)
+    {
+        symbol_entity_specs_set_is_intrinsic_function(new_intrinsic, 0);
+        symbol_entity_specs_set_is_intrinsic_subroutine(new_intrinsic, 1);
+    }
+    else if (descr->kind == M)
+    {
+        symbol_entity_specs_set_is_intrinsic_function(new_intrinsic, 1);
+        symbol_entity_specs_set_is_intrinsic_subroutine(new_intrinsic, 1);
+    }
+    symbol_entity_specs_set_simplify_function(new_intrinsic, descr->simplify);
+    if (module_sym != NULL)
+    {
+        new_intrinsic->locus = module_sym->locus;
+        symbol_entity_specs_set_in_module(new_intrinsic, module_sym);
+        symbol_entity_specs_set_is_module_procedure(new_intrinsic, 1);
+        symbol_entity_specs_add_related_symbols(module_sym,
+                new_intrinsic);
+    }
+
+    return new_intrinsic;
+}
+
+static int intrinsic_descriptor_cmp(const void* a, const void* b)
+{
+    const intrinsic_descriptor_t* d1 = *(const intrinsic_descriptor_t**)a;
+    const intrinsic_descriptor_t* d2 = *(const intrinsic_descriptor_t**)b;
+
+    return strcasecmp(d1->name, d2->name);
+}
+
+// Generic intrinsics not in an intrinsic module, sorted by name
+static const intrinsic_descriptor_t** _sorted_generic_intrinsics = NULL;
+static int _num_sorted_generic_intrinsics = 0;
+
+static const intrinsic_descriptor_t* find_generic_intrinsic_descriptor(const char* name)
+{
+    if (_sorted_generic_intrinsics == NULL)
+    {
+        int num_descriptors = sizeof(_intrinsic_descriptors) / sizeof(_intrinsic_descriptors[0]);
+        _sorted_generic_intrinsics = NEW_VEC(const intrinsic_descriptor_t*, num_descriptors);
+
+        int i;
+        for (i = 0; i < num_descriptors; i++)
+        {
+            if (_intrinsic_descriptors[i].module_name == NULL)
+            {
+                _sorted_generic_intrinsics[_num_sorted_generic_intrinsics] = &_intrinsic_descriptors[i];
+                _num_sorted_generic_intrinsics++;
+            }
+        }
+
+        qsort(_sorted_generic_intrinsics, _num_sorted_generic_intrinsics,
+                sizeof(*_sorted_generic_intrinsics), intrinsic_descriptor_cmp);
+    }
+
+    intrinsic_descriptor_t key;
+    memset(&key, 0, sizeof(key));
+    key.name = name;
+    const intrinsic_descriptor_t* pkey = &key;
+
+    const intrinsic_descriptor_t** result = (const intrinsic_descriptor_t**)bsearch(&pkey,
+            _sorted_generic_intrinsics, _num_sorted_generic_intrinsics,
+            sizeof(*_sorted_generic_intrinsics), intrinsic_descriptor_cmp);
+
+    if (result == NULL)
+        return NULL;
+
+    return *result;
+}
+
+static char register_specific_names_of(const decl_context_t* decl_context, const char* name);
+
+// Intrinsics are not registered upfront. Instead, the first time a name is
+// looked up in the scope of intrinsics we register the generic intrinsic and
+// the specific names with that name. Returns nonzero if something was registered
+char fortran_register_intrinsic_lazily(const decl_context_t* fortran_intrinsic_context, const char* name)
+{
+    char registered = 0;
+
+    const intrinsic_descriptor_t* descr = find_generic_intrinsic_descriptor(name);
+    if (descr != NULL)
+    {
+        registered = (register_generic_intrinsic(fortran_intrinsic_context, descr) != NULL);
+    }
+
+    registered = register_specific_names_of(fortran_intrinsic_context, name) || registered;
+
+    return registered;
+}
+
+// Intrinsic modules are not registered until a module is looked up
+void fortran_register_intrinsic_modules_if_needed(void)
+{
+    if (CURRENT_COMPILED_FILE->intrinsic_modules_registered)
+        return;
+    CURRENT_COMPILED_FILE->intrinsic_modules_registered = 1;
+
+    const decl_context_t* decl_context = CURRENT_COMPILED_FILE->global_decl_context;
     fortran_init_intrinsic_modules(decl_context);
 
     const decl_context_t* fortran_intrinsic_context = fortran_get_context_of_intrinsics(decl_context);
 
+    int i, num_descriptors = sizeof(_intrinsic_descriptors) / sizeof(_intrinsic_descriptors[0]);
+    for (i = 0; i < num_descriptors; i++)
+    {
+        if (_intrinsic_descriptors[i].module_name != NULL)
+            register_generic_intrinsic(fortran_intrinsic_context, &_intrinsic_descriptors[i]);
+    }
+
+    fortran_finish_intrinsic_modules(decl_context);
+}
+
+void fortran_init_intrinsics(const decl_context_t* decl_context)
+{
+    fortran_create_scope_for_intrinsics(decl_context);
+
     if (CURRENT_CONFIGURATION->num_disabled_intrinsics > 0)
     {
         // Sort the list of disabled intrinsics lists
@@ -1343,66 +1496,11 @@ void fortran_init_intrinsics(const decl_context_t* decl_context)
                 (int (*)(const void*, const void*))pstrcasecmp);
     }
 
-#define FORTRAN_GENERIC_INTRINSIC(module_name, name, keywords0, kind0, compute_code) \
-    { \
-        const decl_context_t* relevant_decl_context = fortran_intrinsic_context; \
-        scope_entry_t* module_sym = NULL; \
-        char disabled = 0; \
-        if (module_name != NULL) \
-        { \
-            rb_red_blk_node* query = rb_tree_query(CURRENT_COMPILED_FILE->module_file_cache, module_name); \
-            ERROR_CONDITION(query == NULL, "Module '%s' has not been registered", module_name); \
-            module_sym = (scope_entry_t*)rb_node_get_info(query); \
-            relevant_decl_context = module_sym->related_decl_context; \
-        } \
-        else { \
-            disabled = intrinsic_has_been_disabled(#name); \
-        } \
-        if (!disabled) \
-        { \
-        scope_entry_t* new_intrinsic = new_symbol(relevant_decl_context, relevant_decl_context->current_scope, uniquestr(#name)); \
-        new_intrinsic->locus = make_locus("(fortran-intrinsic)", 0, 0); \
-        new_intrinsic->kind = SK_FUNCTION; \
-        new_intrinsic->do_not_print = 1; \
-        new_intrinsic->type_information = get_computed_function_type(keyword_compute_intrinsic_##name); \
-        symbol_entity_specs_set_is_global_hidden(new_intrinsic, (module_sym == NULL)); \
-        symbol_entity_specs_set_is_builtin(new_intrinsic, 1); \
-        symbol_entity_specs_set_is_intrinsic_function(new_intrinsic, 1); \
-        if (kind0 == ES || kind0 == PS || kind0 == S) \
-        { \
-            symbol_entity_specs_set_is_intrinsic_function(new_intrinsic, 0); \
-            symbol_entity_specs_set_is_intrinsic_subroutine(new_intrinsic, 1); \
-        } \
-        else if (kind0 == M) \
-        { \
-            symbol_entity_specs_set_is_intrinsic_function(new_intrinsic, 1); \
-            symbol_entity_specs_set_is_intrinsic_subroutine(new_intrinsic, 1); \
-        } \
-        symbol_entity_specs_set_simplify_function(new_intrinsic, compute_code); \
-        if (module_sym != NULL) \
-        { \
-            new_intrinsic->locus = module_sym->locus; \
-            symbol_entity_specs_set_in_module(new_intrinsic, module_sym); \
-            symbol_entity_specs_set_is_module_procedure(new_intrinsic, 1); \
-            symbol_entity_specs_add_related_symbols(module_sym, \
-                    new_intrinsic); \
-        } \
-        } \
-    }
-
-#define FORTRAN_GENERIC_INTRINSIC_2(module_name, name, keywords0, kind0, compute_code0, keywords1, kind1, compute_code1) \
-    FORTRAN_GENERIC_INTRINSIC(module_name, name, keywords0, kind0, compute_code0)
-
-    FORTRAN_INTRINSIC_GENERIC_LIST
-#undef FORTRAN_GENERIC_INTRINSIC
-#undef FORTRAN_GENERIC_INTRINSIC_2
-
     intrinsic_map = rb_tree_create(intrinsic_descr_cmp, null_dtor_func, null_dtor_func);
 
-    // Sign in specific names for intrinsics
-    fortran_init_specific_names(fortran_intrinsic_context);
-
-    fortran_finish_intrinsic_modules(decl_context);
+    // Intrinsics are registered on demand, see
+    // fortran_register_intrinsic_lazily and
+    // fortran_register_intrinsic_modules_if_needed
 }
 
 void copy_intrinsic_function_info(scope_entry_t* entry, scope_entry_t* intrinsic)
@@ -1605,126 +1703,213 @@ static scope_entry_t* register_custom_intrinsic(
     return entry;
 }
 
-#define REGISTER_SPECIFIC_INTRINSIC_0(_specific_name, _generic_name) \
-    register_specific_intrinsic_name(decl_context, (_generic_name), (_specific_name), 0, NULL, NULL, NULL, NULL, NULL, NULL, NULL)
-#define REGISTER_SPECIFIC_INTRINSIC_1(_specific_name, _generic_name, t_0) \
-    register_specific_intrinsic_name(decl_context, (_generic_name), (_specific_name), 1, (t_0), NULL, NULL, NULL, NULL, NULL, NULL)
-#define REGISTER_SPECIFIC_INTRINSIC_2(_specific_name, _generic_name, t_0, t_1) \
-    register_specific_intrinsic_name(decl_context, (_generic_name), (_specific_name), 2, (t_0), (t_1), NULL, NULL, NULL, NULL, NULL)
-
-#define REGISTER_CUSTOM_INTRINSIC_0(_specific_name, result_type) \
-    register_custom_intrinsic(decl_context, (_specific_name), result_type, 0, NULL, NULL, NULL)
-#define REGISTER_CUSTOM_INTRINSIC_1(_specific_name, result_type, type_0) \
-    register_custom_intrinsic(decl_context, (_specific_name), result_type, 1, type_0, NULL, NULL)
-#define REGISTER_CUSTOM_INTRINSIC_2(_specific_name, result_type, type_0, type_1) \
-    register_custom_intrinsic(decl_context, (_specific_name), result_type, 2, type_0, type_1, NULL)
-#define REGISTER_CUSTOM_INTRINSIC_3(_specific_name, result_type, type_0, type_1, type_2) \
-    register_custom_intrinsic(decl_context, (_specific_name), result_type, 3, type_0, type_1, type_2)
-
-static void fortran_init_specific_names(const decl_context_t* decl_context)
-{
-    type_t* default_char = get_array_type(fortran_get_default_character_type(), nodecl_null(), decl_context);
-
-    REGISTER_SPECIFIC_INTRINSIC_1("abs", "abs", fortran_get_default_real_type());
-    REGISTER_SPECIFIC_INTRINSIC_1("acos", "acos", fortran_get_default_real_type());
-    REGISTER_SPECIFIC_INTRINSIC_1("aimag", "aimag", get_complex_type(fortran_get_default_real_type()));
-    REGISTER_SPECIFIC_INTRINSIC_2("aint", "aint", fortran_get_default_real_type(), NULL);
-    REGISTER_SPECIFIC_INTRINSIC_1("alog", "log", fortran_get_default_real_type());
-    REGISTER_SPECIFIC_INTRINSIC_1("alog10", "log10", fortran_get_default_real_type());
-    REGISTER_SPECIFIC_INTRINSIC_2("amod", "mod", fortran_get_default_real_type(), fortran_get_default_real_type());
+// Types of the specific names of intrinsics. We cannot build them statically
+typedef
+enum intrinsic_type_code_tag
+{
+    ITC_NONE = 0,
+    ITC_VOID,
+    ITC_DEFAULT_INTEGER,
+    ITC_DEFAULT_REAL,
+    ITC_DOUBLE_PRECISION,
+    ITC_COMPLEX_DEFAULT_REAL,
+    ITC_COMPLEX_DOUBLE_PRECISION,
+    ITC_DEFAULT_CHARACTER,
+    ITC_DEFAULT_CHARACTER_ARRAY,
+} intrinsic_type_code_t;
+
+enum { MAX_SPECIFIC_INTRINSIC_PARAMETERS = 3 };
+
+typedef
+struct specific_intrinsic_descriptor_tag
+{
+    const char* specific_name;
+    // NULL for custom intrinsics, which do not have a generic symbol
+    const char* generic_name;
+    intrinsic_type_code_t result_type;
+    int num_args;
+    intrinsic_type_code_t types[MAX_SPECIFIC_INTRINSIC_PARAMETERS];
+} specific_intrinsic_descriptor_t;
+
+#define SPECIFIC_INTRINSIC_1(_specific_name, _generic_name, t_0) \
+    { (_specific_name), (_generic_name), ITC_NONE, 1, { (t_0) } }
+#define SPECIFIC_INTRINSIC_2(_specific_name, _generic_name, t_0, t_1) \
+    { (_specific_name), (_generic_name), ITC_NONE, 2, { (t_0), (t_1) } }
+
+#define CUSTOM_INTRINSIC_0(_specific_name, result_type) \
+    { (_specific_name), NULL, (result_type), 0, { ITC_NONE } }
+#define CUSTOM_INTRINSIC_1(_specific_name, result_type, type_0) \
+    { (_specific_name), NULL, (result_type), 1, { (type_0) } }
+#define CUSTOM_INTRINSIC_2(_specific_name, result_type, type_0, type_1) \
+    { (_specific_name), NULL, (result_type), 2, { (type_0), (type_1) } }
+
+static specific_intrinsic_descriptor_t _specific_intrinsic_descriptors[] = {
+    SPECIFIC_INTRINSIC_1("abs", "abs", ITC_DEFAULT_REAL),
+    SPECIFIC_INTRINSIC_1("acos", "acos", ITC_DEFAULT_REAL),
+    SPECIFIC_INTRINSIC_1("aimag", "aimag", ITC_COMPLEX_DEFAULT_REAL),
+    SPECIFIC_INTRINSIC_2("aint", "aint", ITC_DEFAULT_REAL, ITC_NONE),
+    SPECIFIC_INTRINSIC_1("alog", "log", ITC_DEFAULT_REAL),
+    SPECIFIC_INTRINSIC_1("alog10", "log10", ITC_DEFAULT_REAL),
+    SPECIFIC_INTRINSIC_2("amod", "mod", ITC_DEFAULT_REAL, ITC_DEFAULT_REAL),
     // 'amax0' 'amax1' 'amin0' 'amin1' are defined as generic intrinsics due to their non-fortranish nature of unbounded number of parameters
-    REGISTER_SPECIFIC_INTRINSIC_2("anint", "anint", fortran_get_default_real_type(), NULL);
-    REGISTER_SPECIFIC_INTRINSIC_1("asin", "asin", fortran_get_default_real_type());
-    REGISTER_SPECIFIC_INTRINSIC_1("atan", "atan", fortran_get_default_real_type());
-    REGISTER_SPECIFIC_INTRINSIC_2("atan2", "atan2", fortran_get_default_real_type(), fortran_get_default_real_type());
-    REGISTER_SPECIFIC_INTRINSIC_1("cabs", "abs", get_complex_type(fortran_get_default_real_type()));
-    REGISTER_SPECIFIC_INTRINSIC_1("ccos", "cos", get_complex_type(fortran_get_default_real_type()));
-    REGISTER_SPECIFIC_INTRINSIC_1("cdcos", "cos", get_complex_type(fortran_get_doubleprecision_type()));
-    REGISTER_SPECIFIC_INTRINSIC_1("cexp", "exp", get_complex_type(fortran_get_default_real_type()));
-    REGISTER_SPECIFIC_INTRINSIC_2("char", "char", fortran_get_default_integer_type(), NULL);
-    REGISTER_SPECIFIC_INTRINSIC_1("clog", "log", get_complex_type(fortran_get_default_real_type()));
-    REGISTER_SPECIFIC_INTRINSIC_1("conjg", "conjg", get_complex_type(fortran_get_default_real_type()));
-    REGISTER_SPECIFIC_INTRINSIC_1("cos", "cos", fortran_get_default_real_type());
-    REGISTER_SPECIFIC_INTRINSIC_1("cosh", "cosh", fortran_get_default_real_type());
-    REGISTER_SPECIFIC_INTRINSIC_1("csin", "sin", get_complex_type(fortran_get_default_real_type()));
-    REGISTER_SPECIFIC_INTRINSIC_1("csqrt", "sqrt", get_complex_type(fortran_get_default_real_type()));
-    REGISTER_SPECIFIC_INTRINSIC_1("dabs", "abs", fortran_get_doubleprecision_type());
-    REGISTER_SPECIFIC_INTRINSIC_1("dacos", "cos", fortran_get_doubleprecision_type());
-    REGISTER_SPECIFIC_INTRINSIC_1("dasin", "asin", fortran_get_doubleprecision_type());
-    REGISTER_SPECIFIC_INTRINSIC_1("datan", "atan", fortran_get_doubleprecision_type());
-    REGISTER_SPECIFIC_INTRINSIC_2("datan2", "atan2", fortran_get_doubleprecision_type(), fortran_get_doubleprecision_type());
-    REGISTER_SPECIFIC_INTRINSIC_1("dcos", "cos", fortran_get_doubleprecision_type());
-    REGISTER_SPECIFIC_INTRINSIC_1("dcosh", "cosh", fortran_get_doubleprecision_type());
-    REGISTER_SPECIFIC_INTRINSIC_2("ddim", "dim", fortran_get_doubleprecision_type(), fortran_get_doubleprecision_type());
-    REGISTER_SPECIFIC_INTRINSIC_1("dexp", "exp", fortran_get_doubleprecision_type());
-    REGISTER_SPECIFIC_INTRINSIC_2("dim", "dim", fortran_get_default_real_type(), fortran_get_default_real_type());
-    REGISTER_SPECIFIC_INTRINSIC_2("dint", "aint", fortran_get_doubleprecision_type(), NULL);
-    REGISTER_SPECIFIC_INTRINSIC_1("dlog", "log", fortran_get_doubleprecision_type());
-    REGISTER_SPECIFIC_INTRINSIC_1("dlog10", "log10", fortran_get_doubleprecision_type());
+    SPECIFIC_INTRINSIC_2("anint", "anint", ITC_DEFAULT_REAL, ITC_NONE),
+    SPECIFIC_INTRINSIC_1("asin", "asin", ITC_DEFAULT_REAL),
+    SPECIFIC_INTRINSIC_1("atan", "atan", ITC_DEFAULT_REAL),
+    SPECIFIC_INTRINSIC_2("atan2", "atan2", ITC_DEFAULT_REAL, ITC_DEFAULT_REAL),
+    SPECIFIC_INTRINSIC_1("cabs", "abs", ITC_COMPLEX_DEFAULT_REAL),
+    SPECIFIC_INTRINSIC_1("ccos", "cos", ITC_COMPLEX_DEFAULT_REAL),
+    SPECIFIC_INTRINSIC_1("cdcos", "cos", ITC_COMPLEX_DOUBLE_PRECISION),
+    SPECIFIC_INTRINSIC_1("cexp", "exp", ITC_COMPLEX_DEFAULT_REAL),
+    SPECIFIC_INTRINSIC_2("char", "char", ITC_DEFAULT_INTEGER, ITC_NONE),
+    SPECIFIC_INTRINSIC_1("clog", "log", ITC_COMPLEX_DEFAULT_REAL),
+    SPECIFIC_INTRINSIC_1("conjg", "conjg", ITC_COMPLEX_DEFAULT_REAL),
+    SPECIFIC_INTRINSIC_1("cos", "cos", ITC_DEFAULT_REAL),
+    SPECIFIC_INTRINSIC_1("cosh", "cosh", ITC_DEFAULT_REAL),
+    SPECIFIC_INTRINSIC_1("csin", "sin", ITC_COMPLEX_DEFAULT_REAL),
+    SPECIFIC_INTRINSIC_1("csqrt", "sqrt", ITC_COMPLEX_DEFAULT_REAL),
+    SPECIFIC_INTRINSIC_1("dabs", "abs", ITC_DOUBLE_PRECISION),
+    SPECIFIC_INTRINSIC_1("dacos", "cos", ITC_DOUBLE_PRECISION),
+    SPECIFIC_INTRINSIC_1("dasin", "asin", ITC_DOUBLE_PRECISION),
+    SPECIFIC_INTRINSIC_1("datan", "atan", ITC_DOUBLE_PRECISION),
+    SPECIFIC_INTRINSIC_2("datan2", "atan2", ITC_DOUBLE_PRECISION, ITC_DOUBLE_PRECISION),
+    SPECIFIC_INTRINSIC_1("dcos", "cos", ITC_DOUBLE_PRECISION),
+    SPECIFIC_INTRINSIC_1("dcosh", "cosh", ITC_DOUBLE_PRECISION),
+    SPECIFIC_INTRINSIC_2("ddim", "dim", ITC_DOUBLE_PRECISION, ITC_DOUBLE_PRECISION),
+    SPECIFIC_INTRINSIC_1("dexp", "exp", ITC_DOUBLE_PRECISION),
+    SPECIFIC_INTRINSIC_2("dim", "dim", ITC_DEFAULT_REAL, ITC_DEFAULT_REAL),
+    SPECIFIC_INTRINSIC_2("dint", "aint", ITC_DOUBLE_PRECISION, ITC_NONE),
+    SPECIFIC_INTRINSIC_1("dlog", "log", ITC_DOUBLE_PRECISION),
+    SPECIFIC_INTRINSIC_1("dlog10", "log10", ITC_DOUBLE_PRECISION),
     // dmax1 dmin1 are defined as generic intrinsics
-    REGISTER_SPECIFIC_INTRINSIC_2("dmod", "mod", fortran_get_doubleprecision_type(), fortran_get_doubleprecision_type());
-    REGISTER_SPECIFIC_INTRINSIC_2("dnint", "anint", fortran_get_doubleprecision_type(), NULL);
-    REGISTER_SPECIFIC_INTRINSIC_2("dprod", "dprod", fortran_get_default_real_type(), fortran_get_default_real_type());
-    REGISTER_SPECIFIC_INTRINSIC_2("dreal", "real", get_complex_type(fortran_get_doubleprecision_type()), NULL);
-    REGISTER_SPECIFIC_INTRINSIC_2("dsign", "sign", fortran_get_doubleprecision_type(), fortran_get_doubleprecision_type());
-    REGISTER_SPECIFIC_INTRINSIC_1("dsin", "sin", fortran_get_doubleprecision_type());
-    REGISTER_SPECIFIC_INTRINSIC_1("dsinh", "sinh", fortran_get_doubleprecision_type());
-    REGISTER_SPECIFIC_INTRINSIC_1("dsqrt", "sqrt", fortran_get_doubleprecision_type());
-    REGISTER_SPECIFIC_INTRINSIC_1("dtan", "tan", fortran_get_doubleprecision_type());
-    REGISTER_SPECIFIC_INTRINSIC_1("dtanh", "tanh", fortran_get_doubleprecision_type());
-    REGISTER_SPECIFIC_INTRINSIC_1("exp", "exp", fortran_get_default_real_type());
-    REGISTER_SPECIFIC_INTRINSIC_1("iabs", "abs", fortran_get_default_integer_type());
-    REGISTER_SPECIFIC_INTRINSIC_2("ichar", "ichar", default_char, NULL);
-    REGISTER_SPECIFIC_INTRINSIC_2("idim", "dim", fortran_get_default_integer_type(), fortran_get_default_integer_type());
-    REGISTER_SPECIFIC_INTRINSIC_2("idint", "int", fortran_get_doubleprecision_type(), NULL);
-    REGISTER_SPECIFIC_INTRINSIC_2("idnint", "nint", fortran_get_doubleprecision_type(), NULL);
-    REGISTER_SPECIFIC_INTRINSIC_2("ifix", "int", fortran_get_default_real_type(), NULL);
-    REGISTER_SPECIFIC_INTRINSIC_2("index", "index", default_char, default_char);
-    REGISTER_SPECIFIC_INTRINSIC_2("int", "int", fortran_get_default_integer_type(), NULL);
-    REGISTER_SPECIFIC_INTRINSIC_2("isign", "sign", fortran_get_default_integer_type(), fortran_get_default_integer_type());
-    REGISTER_SPECIFIC_INTRINSIC_2("len", "len", default_char, NULL);
-    REGISTER_SPECIFIC_INTRINSIC_2("lge", "lge", default_char, default_char);
-    REGISTER_SPECIFIC_INTRINSIC_2("lgt", "lgt", default_char, default_char);
-    REGISTER_SPECIFIC_INTRINSIC_2("lle", "lle", default_char, default_char);
-    REGISTER_SPECIFIC_INTRINSIC_2("llt", "llt", default_char, default_char);
-    REGISTER_SPECIFIC_INTRINSIC_2("mod", "mod", fortran_get_default_integer_type(), fortran_get_default_integer_type());
-    REGISTER_SPECIFIC_INTRINSIC_2("nint", "nint", fortran_get_default_real_type(), NULL);
-    REGISTER_SPECIFIC_INTRINSIC_2("real", "real", fortran_get_default_integer_type(), NULL);
-    REGISTER_SPECIFIC_INTRINSIC_2("sign", "sign", fortran_get_default_real_type(), fortran_get_default_real_type());
-    REGISTER_SPECIFIC_INTRINSIC_1("sin", "sin", fortran_get_default_real_type());
-    //REGISTER_SPECIFIC_INTRINSIC_2("sngl", "real", fortran_get_doubleprecision_type(), NULL);
-    REGISTER_SPECIFIC_INTRINSIC_1("sqrt", "sqrt", fortran_get_default_real_type());
-    REGISTER_SPECIFIC_INTRINSIC_1("tan", "tan", fortran_get_default_real_type());
-    REGISTER_SPECIFIC_INTRINSIC_1("tanh", "tanh", fortran_get_default_real_type());
-
-    REGISTER_SPECIFIC_INTRINSIC_1("sind", "sind", fortran_get_default_real_type());
-    REGISTER_SPECIFIC_INTRINSIC_1("dsind", "sind", fortran_get_doubleprecision_type());
-    REGISTER_SPECIFIC_INTRINSIC_1("csind", "sind", get_complex_type(fortran_get_default_real_type()));
-
-    REGISTER_SPECIFIC_INTRINSIC_1("cosd", "cosd", fortran_get_default_real_type());
-    REGISTER_SPECIFIC_INTRINSIC_1("dcosd", "cosd", fortran_get_doubleprecision_type());
-    REGISTER_SPECIFIC_INTRINSIC_1("ccosd", "cosd", get_complex_type(fortran_get_default_real_type()));
-
-    REGISTER_SPECIFIC_INTRINSIC_1("tand", "tand", fortran_get_default_real_type());
-    REGISTER_SPECIFIC_INTRINSIC_1("dtand", "tand", fortran_get_doubleprecision_type());
-    REGISTER_SPECIFIC_INTRINSIC_1("ctand", "tand", get_complex_type(fortran_get_default_real_type()));
-
-    REGISTER_SPECIFIC_INTRINSIC_2("atan2d", "atan2d", fortran_get_default_real_type(), fortran_get_default_real_type());
-    REGISTER_SPECIFIC_INTRINSIC_2("datan2d", "atan2d", fortran_get_doubleprecision_type(), fortran_get_doubleprecision_type());
+    SPECIFIC_INTRINSIC_2("dmod", "mod", ITC_DOUBLE_PRECISION, ITC_DOUBLE_PRECISION),
+    SPECIFIC_INTRINSIC_2("dnint", "anint", ITC_DOUBLE_PRECISION, ITC_NONE),
+    SPECIFIC_INTRINSIC_2("dprod", "dprod", ITC_DEFAULT_REAL, ITC_DEFAULT_REAL),
+    SPECIFIC_INTRINSIC_2("dreal", "real", ITC_COMPLEX_DOUBLE_PRECISION, ITC_NONE),
+    SPECIFIC_INTRINSIC_2("dsign", "sign", ITC_DOUBLE_PRECISION, ITC_DOUBLE_PRECISION),
+    SPECIFIC_INTRINSIC_1("dsin", "sin", ITC_DOUBLE_PRECISION),
+    SPECIFIC_INTRINSIC_1("dsinh", "sinh", ITC_DOUBLE_PRECISION),
+    SPECIFIC_INTRINSIC_1("dsqrt", "sqrt", ITC_DOUBLE_PRECISION),
+    SPECIFIC_INTRINSIC_1("dtan", "tan", ITC_DOUBLE_PRECISION),
+    SPECIFIC_INTRINSIC_1("dtanh", "tanh", ITC_DOUBLE_PRECISION),
+    SPECIFIC_INTRINSIC_1("exp", "exp", ITC_DEFAULT_REAL),
+    SPECIFIC_INTRINSIC_1("iabs", "abs", ITC_DEFAULT_INTEGER),
+    SPECIFIC_INTRINSIC_2("ichar", "ichar", ITC_DEFAULT_CHARACTER_ARRAY, ITC_NONE),
+    SPECIFIC_INTRINSIC_2("idim", "dim", ITC_DEFAULT_INTEGER, ITC_DEFAULT_INTEGER),
+    SPECIFIC_INTRINSIC_2("idint", "int", ITC_DOUBLE_PRECISION, ITC_NONE),
+    SPECIFIC_INTRINSIC_2("idnint", "nint", ITC_DOUBLE_PRECISION, ITC_NONE),
+    SPECIFIC_INTRINSIC_2("ifix", "int", ITC_DEFAULT_REAL, ITC_NONE),
+    SPECIFIC_INTRINSIC_2("index", "index", ITC_DEFAULT_CHARACTER_ARRAY, ITC_DEFAULT_CHARACTER_ARRAY),
+    SPECIFIC_INTRINSIC_2("int", "int", ITC_DEFAULT_INTEGER, ITC_NONE),
+    SPECIFIC_INTRINSIC_2("isign", "sign", ITC_DEFAULT_INTEGER, ITC_DEFAULT_INTEGER),
+    SPECIFIC_INTRINSIC_2("len", "len", ITC_DEFAULT_CHARACTER_ARRAY, ITC_NONE),
+    SPECIFIC_INTRINSIC_2("lge", "lge", ITC_DEFAULT_CHARACTER_ARRAY, ITC_DEFAULT_CHARACTER_ARRAY),
+    SPECIFIC_INTRINSIC_2("lgt", "lgt", ITC_DEFAULT_CHARACTER_ARRAY, ITC_DEFAULT_CHARACTER_ARRAY),
+    SPECIFIC_INTRINSIC_2("lle", "lle", ITC_DEFAULT_CHARACTER_ARRAY, ITC_DEFAULT_CHARACTER_ARRAY),
+    SPECIFIC_INTRINSIC_2("llt", "llt", ITC_DEFAULT_CHARACTER_ARRAY, ITC_DEFAULT_CHARACTER_ARRAY),
+    SPECIFIC_INTRINSIC_2("mod", "mod", ITC_DEFAULT_INTEGER, ITC_DEFAULT_INTEGER),
+    SPECIFIC_INTRINSIC_2("nint", "nint", ITC_DEFAULT_REAL, ITC_NONE),
+    SPECIFIC_INTRINSIC_2("real", "real", ITC_DEFAULT_INTEGER, ITC_NONE),
+    SPECIFIC_INTRINSIC_2("sign", "sign", ITC_DEFAULT_REAL, ITC_DEFAULT_REAL),
+    SPECIFIC_INTRINSIC_1("sin", "sin", ITC_DEFAULT_REAL),
+    //SPECIFIC_INTRINSIC_2("sngl", "real", ITC_DOUBLE_PRECISION, ITC_NONE),
+    SPECIFIC_INTRINSIC_1("sqrt", "sqrt", ITC_DEFAULT_REAL),
+    SPECIFIC_INTRINSIC_1("tan", "tan", ITC_DEFAULT_REAL),
+    SPECIFIC_INTRINSIC_1("tanh", "tanh", ITC_DEFAULT_REAL),
+
+    SPECIFIC_INTRINSIC_1("sind", "sind", ITC_DEFAULT_REAL),
+    SPECIFIC_INTRINSIC_1("dsind", "sind", ITC_DOUBLE_PRECISION),
+    SPECIFIC_INTRINSIC_1("csind", "sind", ITC_COMPLEX_DEFAULT_REAL),
+
+    SPECIFIC_INTRINSIC_1("cosd", "cosd", ITC_DEFAULT_REAL),
+    SPECIFIC_INTRINSIC_1("dcosd", "cosd", ITC_DOUBLE_PRECISION),
+    SPECIFIC_INTRINSIC_1("ccosd", "cosd", ITC_COMPLEX_DEFAULT_REAL),
+
+    SPECIFIC_INTRINSIC_1("tand", "tand", ITC_DEFAULT_REAL),
+    SPECIFIC_INTRINSIC_1("dtand", "tand", ITC_DOUBLE_PRECISION),
+    SPECIFIC_INTRINSIC_1("ctand", "tand", ITC_COMPLEX_DEFAULT_REAL),
+
+    SPECIFIC_INTRINSIC_2("atan2d", "atan2d", ITC_DEFAULT_REAL, ITC_DEFAULT_REAL),
+    SPECIFIC_INTRINSIC_2("datan2d", "atan2d", ITC_DOUBLE_PRECISION, ITC_DOUBLE_PRECISION),
 
     // Non standard stuff
     // Very old (normally from g77) intrinsics
-    REGISTER_SPECIFIC_INTRINSIC_1("cdabs", "abs", get_complex_type(fortran_get_doubleprecision_type()));
-    REGISTER_SPECIFIC_INTRINSIC_1("zabs", "abs", get_complex_type(fortran_get_doubleprecision_type()));
-    REGISTER_SPECIFIC_INTRINSIC_1("dconjg", "conjg", get_complex_type(fortran_get_doubleprecision_type()));
-    REGISTER_SPECIFIC_INTRINSIC_1("dimag", "aimag", get_complex_type(fortran_get_doubleprecision_type()));
-    REGISTER_SPECIFIC_INTRINSIC_1("derf", "erf", fortran_get_doubleprecision_type());
-    REGISTER_SPECIFIC_INTRINSIC_1("derfc", "erfc", fortran_get_doubleprecision_type());
-
-    REGISTER_CUSTOM_INTRINSIC_2("getenv", get_void_type(), fortran_get_default_character_type(), 
-            fortran_get_default_character_type());
-    REGISTER_CUSTOM_INTRINSIC_1("sngl", fortran_get_default_real_type(), fortran_get_doubleprecision_type());
-    REGISTER_CUSTOM_INTRINSIC_0("iargc", fortran_get_default_integer_type());
+    SPECIFIC_INTRINSIC_1("cdabs", "abs", ITC_COMPLEX_DOUBLE_PRECISION),
+    SPECIFIC_INTRINSIC_1("zabs", "abs", ITC_COMPLEX_DOUBLE_PRECISION),
+    SPECIFIC_INTRINSIC_1("dconjg", "conjg", ITC_COMPLEX_DOUBLE_PRECISION),
+    SPECIFIC_INTRINSIC_1("dimag", "aimag", ITC_COMPLEX_DOUBLE_PRECISION),
+    SPECIFIC_INTRINSIC_1("derf", "erf", ITC_DOUBLE_PRECISION),
+    SPECIFIC_INTRINSIC_1("derfc", "erfc", ITC_DOUBLE_PRECISION),
+
+    CUSTOM_INTRINSIC_2("getenv", ITC_VOID, ITC_DEFAULT_CHARACTER, ITC_DEFAULT_CHARACTER),
+    CUSTOM_INTRINSIC_1("sngl", ITC_DEFAULT_REAL, ITC_DOUBLE_PRECISION),
+    CUSTOM_INTRINSIC_0("iargc", ITC_DEFAULT_INTEGER),
+};
+
+#undef SPECIFIC_INTRINSIC_1
+#undef SPECIFIC_INTRINSIC_2
+#undef CUSTOM_INTRINSIC_0
+#undef CUSTOM_INTRINSIC_1
+#undef CUSTOM_INTRINSIC_2
+
+static type_t* get_intrinsic_type_of_code(const decl_context_t* decl_context, intrinsic_type_code_t code)
+{
+    switch (code)
+    {
+        case ITC_NONE: return NULL;
+        case ITC_VOID: return get_void_type();
+        case ITC_DEFAULT_INTEGER: return fortran_get_default_integer_type();
+        case ITC_DEFAULT_REAL: return fortran_get_default_real_type();
+        case ITC_DOUBLE_PRECISION: return fortran_get_doubleprecision_type();
+        case ITC_COMPLEX_DEFAULT_REAL: return get_complex_type(fortran_get_default_real_type());
+        case ITC_COMPLEX_DOUBLE_PRECISION: return get_complex_type(fortran_get_doubleprecision_type());
+        case ITC_DEFAULT_CHARACTER: return fortran_get_default_character_type();
+        case ITC_DEFAULT_CHARACTER_ARRAY:
+            return get_array_type(fortran_get_default_character_type(), nodecl_null(), decl_context);
+        default:
+            internal_error("Invalid intrinsic type code %d", code);
+    }
+    return NULL;
+}
+
+// Registers, in the order they appear in the table, the specific names
+// called 'name'. Returns nonzero if any was registered
+static char register_specific_names_of(const decl_context_t* decl_context, const char* name)
+{
+    char registered = 0;
+    int i, num_descriptors = sizeof(_specific_intrinsic_descriptors) / sizeof(_specific_intrinsic_descriptors[0]);
+    for (i = 0; i < num_descriptors; i++)
+    {
+        specific_intrinsic_descriptor_t* descr = &_specific_intrinsic_descriptors[i];
+        if (strcasecmp(descr->specific_name, name) != 0)
+            continue;
+
+        type_t* t[MAX_SPECIFIC_INTRINSIC_PARAMETERS];
+        int j;
+        for (j = 0; j < MAX_SPECIFIC_INTRINSIC_PARAMETERS; j++)
+        {
+            t[j] = get_intrinsic_type_of_code(decl_context, descr->types[j]);
+        }
+
+        scope_entry_t* entry = NULL;
+        if (descr->generic_name != NULL)
+        {
+            entry = register_specific_intrinsic_name(decl_context,
+                    descr->generic_name, descr->specific_name, descr->num_args,
+                    t[0], t[1], t[2], NULL, NULL, NULL, NULL);
+        }
+        else
+        {
+            entry = register_custom_intrinsic(decl_context,
+                    descr->specific_name,
+                    get_intrinsic_type_of_code(decl_context, descr->result_type),
+                    descr->num_args,
+                    t[0], t[1], t[2]);
+        }
+
+        registered = registered || (entry != NULL);
+    }
+
+    return registered;
 }
 
 static type_t* no_ptr(type_t* t)
@@ -35,6 +35,8 @@ MCXX_BEGIN_DECLS
 LIBMF03_EXTERN void copy_intrinsic_function_info(scope_entry_t* dest, scope_entry_t* intrinsic);
 
 void fortran_init_intrinsics(const decl_context_t* decl_context);
+char fortran_register_intrinsic_lazily(const decl_context_t* fortran_intrinsic_context, const char* name);
+void fortran_register_intrinsic_modules_if_needed(void);
 
 scope_entry_t* fortran_solve_generic_intrinsic_call(scope_entry_t* symbol, 
         nodecl_t* nodecl_actual_arguments,
@@ -0,0 +1,295 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2013 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+  
+  This file is part of Mercurium C/C++ source-to-source compiler.
+  
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+  
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+  
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+
+
+#ifdef HAVE_CONFIG_H
+ #include <config.h>
+#endif
+
+#include <string.h>
+#include <ctype.h>
+#include "fortran03-moddeps.h"
+#include "fortran03-lexer.h"
+#include "fortran03-parser-internal.h"
+#include "cxx-utils.h"
+#include "cxx-process.h"
+
+extern int mf03lex(void);
+
+/*
+   Module dependences are found by looking only at the tokens of the file.
+
+   We recognize the following statements, everything else is skipped until
+   the end of the statement
+
+     [label] MODULE name
+     [label] USE [[, module-nature] ::] name [...]
+     [label] SUBMODULE ( ancestor [: parent] ) name
+ */
+
+// Intrinsic modules used without an explicit module nature
+static const char* intrinsic_module_names[] =
+{
+    "ieee_arithmetic",
+    "ieee_exceptions",
+    "ieee_features",
+    "iso_c_binding",
+    "iso_fortran_env",
+    NULL,
+};
+
+static char is_intrinsic_module_name(const char* name)
+{
+    int i;
+    for (i = 0; intrinsic_module_names[i] != NULL; i++)
+    {
+        if (strcmp(intrinsic_module_names[i], name) == 0)
+            return 1;
+    }
+    return 0;
+}
+
+// Keywords are not reserved in Fortran so any word may be a name
+static const char* token_as_name(int token)
+{
+    if (token == 0
+            || token == EOS)
+        return NULL;
+
+    const char* text = mf03lval.token_atrib.token_text;
+    if (text == NULL
+            || !(isalpha(text[0]) || text[0] == '_'))
+        return NULL;
+
+    return strtolower(text);
+}
+
+static int skip_statement(int token)
+{
+    while (token != 0
+            && token != EOS)
+    {
+        token = mf03lex();
+    }
+    return token;
+}
+
+static int scan_module_stmt(fortran_module_dependences_t* deps)
+{
+    int token = mf03lex();
+    const char* name = token_as_name(token);
+    if (name == NULL)
+        return skip_statement(token);
+
+    // MODULE PROCEDURE, MODULE FUNCTION, ... are not module statements
+    token = mf03lex();
+    if (token == EOS
+            || token == 0)
+    {
+        P_LIST_ADD_ONCE(deps->provided, deps->num_provided, name);
+    }
+
+    return skip_statement(token);
+}
+
+static int scan_use_stmt(fortran_module_dependences_t* deps)
+{
+    char is_intrinsic = 0;
+    char is_non_intrinsic = 0;
+
+    int token = mf03lex();
+    if (token == ',')
+    {
+        token = mf03lex();
+        const char* nature = token_as_name(token);
+        if (nature == NULL)
+            return skip_statement(token);
+
+        is_intrinsic = (strcmp(nature, "intrinsic") == 0);
+        is_non_intrinsic = (strcmp(nature, "non_intrinsic") == 0);
+
+        token = mf03lex();
+    }
+
+    if (token == ':')
+    {
+        token = mf03lex();
+        if (token != ':')
+            return skip_statement(token);
+
+        token = mf03lex();
+    }
+
+    const char* name = token_as_name(token);
+    if (name != NULL
+            && !is_intrinsic
+            && (is_non_intrinsic || !is_intrinsic_module_name(name)))
+    {
+        P_LIST_ADD_ONCE(deps->required, deps->num_required, name);
+    }
+
+    return skip_statement(token);
+}
+
+static const char* submodule_name(const char* ancestor, const char* name)
+{
+    return uniquestr(strappend(strappend(ancestor, "@"), name));
+}
+
+static int scan_submodule_stmt(fortran_module_dependences_t* deps)
+{
+    int token = mf03lex();
+    if (token != '(')
+        return skip_statement(token);
+
+    token = mf03lex();
+    const char* ancestor = token_as_name(token);
+    if (ancestor == NULL)
+        return skip_statement(token);
+
+    P_LIST_ADD_ONCE(deps->required, deps->num_required, ancestor);
+
+    token = mf03lex();
+    if (token == ':')
+    {
+        token = mf03lex();
+        const char* parent = token_as_name(token);
+        if (parent == NULL)
+            return skip_statement(token);
+
+        const char* parent_submodule = submodule_name(ancestor, parent);
+        P_LIST_ADD_ONCE(deps->required_submodules, deps->num_required_submodules,
+                parent_submodule);
+
+        token = mf03lex();
+    }
+
+    if (token != ')')
+        return skip_statement(token);
+
+    token = mf03lex();
+    const char* name = token_as_name(token);
+    if (name != NULL)
+    {
+        const char* submodule = submodule_name(ancestor, name);
+        P_LIST_ADD_ONCE(deps->provided_submodules, deps->num_provided_submodules,
+                submodule);
+    }
+
+    return skip_statement(token);
+}
+
+// Removes from required those names that are also in provided
+static void remove_provided(const char** required, int* num_required,
+        const char** provided, int num_provided)
+{
+    int i, num_kept = 0;
+    for (i = 0; i < *num_required; i++)
+    {
+        char is_provided = 0;
+        int j;
+        for (j = 0; j < num_provided && !is_provided; j++)
+        {
+            is_provided = (required[i] == provided[j]);
+        }
+
+        if (!is_provided)
+        {
+            required[num_kept] = required[i];
+            num_kept++;
+        }
+    }
+    *num_required = num_kept;
+}
+
+void fortran_scan_module_dependences(const char* scanned_filename,
+        const char* input_filename,
+        char is_fixed_form,
+        fortran_module_dependences_t* deps)
+{
+    memset(deps, 0, sizeof(*deps));
+
+    if (mf03_open_file_for_scanning(scanned_filename, input_filename, is_fixed_form) != 0)
+    {
+        fatal_error("Could not open file '%s'", scanned_filename);
+    }
+
+    int token = mf03lex();
+    while (token != 0)
+    {
+        // Skip the label of the statement, if any
+        if (token == DECIMAL_LITERAL)
+        {
+            token = mf03lex();
+        }
+
+        switch (token)
+        {
+            case TOKEN_MODULE:
+                {
+                    token = scan_module_stmt(deps);
+                    break;
+                }
+            case TOKEN_USE:
+                {
+                    token = scan_use_stmt(deps);
+                    break;
+                }
+            case TOKEN_SUBMODULE:
+                {
+                    token = scan_submodule_stmt(deps);
+                    break;
+                }
+            default:
+                {
+                    token = skip_statement(token);
+                    break;
+                }
+        }
+
+        if (token == EOS)
+        {
+            token = mf03lex();
+        }
+    }
+    // The scanner automatically closes the file
+
+    // A module used in the same file where it is defined is not required
+    remove_provided(deps->required, &deps->num_required,
+            deps->provided, deps->num_provided);
+    remove_provided(deps->required_submodules, &deps->num_required_submodules,
+            deps->provided_submodules, deps->num_provided_submodules);
+}
+
+void fortran_free_module_dependences(fortran_module_dependences_t* deps)
+{
+    DELETE(deps->provided);
+    DELETE(deps->required);
+    DELETE(deps->provided_submodules);
+    DELETE(deps->required_submodules);
+    memset(deps, 0, sizeof(*deps));
+}
@@ -0,0 +1,71 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2013 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+  
+  This file is part of Mercurium C/C++ source-to-source compiler.
+  
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+  
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+  
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+
+
+#ifndef FORTRAN03_MODDEPS_H
+#define FORTRAN03_MODDEPS_H
+
+#include "cxx-macros.h"
+#include "libmf03-common.h"
+
+MCXX_BEGIN_DECLS
+
+// Modules defined and used by a Fortran file. Names are lowercase unique
+// strings. Required modules do not include intrinsic modules nor the
+// modules defined in the same file
+//
+// Submodules are named like their submodule files, ancestor@submodule.
+// A submodule provides its own name and requires the one of its parent
+// when the parent is another submodule
+typedef
+struct fortran_module_dependences_tag
+{
+    int num_provided;
+    const char** provided;
+
+    int num_required;
+    const char** required;
+
+    int num_provided_submodules;
+    const char** provided_submodules;
+
+    int num_required_submodules;
+    const char** required_submodules;
+} fortran_module_dependences_t;
+
+// Scans (but does not parse) the file and returns its module dependences.
+// The file is opened for scanning like mf03_open_file_for_scanning does
+LIBMF03_EXTERN void fortran_scan_module_dependences(const char* scanned_filename,
+        const char* input_filename,
+        char is_fixed_form,
+        fortran_module_dependences_t* deps);
+
+LIBMF03_EXTERN void fortran_free_module_dependences(fortran_module_dependences_t* deps);
+
+MCXX_END_DECLS
+
+#endif // FORTRAN03_MODDEPS_H
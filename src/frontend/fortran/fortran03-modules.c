@@ -54,7 +54,7 @@
  #error Q cannot be defined here
 #endif
 
-enum { CURRENT_MODULE_VERSION = 22 };
+enum { CURRENT_MODULE_VERSION = 23 };
 
 // Uncomment the next line to let you GCC help in wrong types in formats of sqlite3_mprintf
 // #define DEBUG_SQLITE3_MPRINTF 1
@@ -69,6 +69,7 @@ enum { CURRENT_MODULE_VERSION = 22 };
 #endif
 
 static void create_storage(sqlite3**, scope_entry_t*);
+static void run_query(sqlite3* handle, const char* query);
 static void init_storage(sqlite3*);
 static void dispose_storage(sqlite3*);
 static void prepare_statements(sqlite3*);
@@ -204,6 +205,7 @@ enum const_kind_table_tag
     CKT_ARRAY,
     CKT_VECTOR,
     CKT_RANGE,
+    CKT_PACKED_ARRAY,
 } const_kind_table_t;
 
 struct module_info_tag
@@ -420,6 +422,23 @@ static void load_storage(sqlite3** handle, const char* filename)
     _oid_map = rb_tree_create(int64cmp_vptr, null_dtor_func, null_dtor_func);
 }
 
+// Modules are only read when loading them, so open them read only and let
+// SQLite map the file in memory instead of reading it page by page
+static void load_storage_read_only(sqlite3** handle, const char* filename)
+{
+    sqlite3_uint64 result = sqlite3_open_v2(filename, handle, SQLITE_OPEN_READONLY, NULL);
+
+    if (result != SQLITE_OK)
+    {
+        fatal_error("Error while opening module database '%s' (%s)\n", filename, sqlite3_errmsg(*handle));
+    }
+
+    // This is ignored by versions of SQLite without memory mapped I/O
+    run_query(*handle, "PRAGMA mmap_size = 268435456;");
+
+    _oid_map = rb_tree_create(int64cmp_vptr, null_dtor_func, null_dtor_func);
+}
+
 void load_module_info(const char* module_name, scope_entry_t** module)
 {
     DEBUG_CODE()
@@ -460,7 +479,7 @@ void load_module_info(const char* module_name, scope_entry_t** module)
 
     sqlite3* handle = NULL;
 
-    load_storage(&handle, filename);
+    load_storage_read_only(&handle, filename);
 
     module_info_t minfo;
     memset(&minfo, 0, sizeof(minfo));
@@ -679,6 +698,7 @@ static sqlite3_uint64 run_insert_statement(sqlite3* handle, sqlite3_stmt* stmt)
     PREPARED_STATEMENT(_pre_insert_decl_context_stmt) \
     PREPARED_STATEMENT(_insert_decl_context_stmt) \
     PREPARED_STATEMENT(_insert_const_value_stmt) \
+    PREPARED_STATEMENT(_insert_packed_const_value_stmt) \
     PREPARED_STATEMENT(_insert_raw_const_value_stmt) \
     PREPARED_STATEMENT(_check_raw_const_value_stmt) \
     PREPARED_STATEMENT(_insert_multi_const_value_stmt) \
@@ -796,6 +816,8 @@ static void prepare_statements(sqlite3* handle)
     // Const value
     DO_PREPARE_STATEMENT(_insert_const_value_stmt, "INSERT INTO const_value(oid, raw_oid) "
             "VALUES ($OID, $RAWOID);");
+    DO_PREPARE_STATEMENT(_insert_packed_const_value_stmt, "INSERT INTO const_value(oid, kind, raw_oid) "
+            "VALUES ($OID, $KIND, $RAWOID);");
 
     // Raw values
     DO_PREPARE_STATEMENT(_insert_raw_const_value_stmt, "INSERT INTO raw_const_value(raw_bytes) "
@@ -2003,6 +2025,92 @@ static nodecl_t load_nodecl(sqlite3* handle, sqlite3_uint64 oid);
 static scope_t* load_scope(sqlite3* handle, sqlite3_uint64 oid);
 static sqlite3_uint64 get_current_scope_oid_of_decl_context_oid(sqlite3* handle, sqlite3_uint64 decl_context_oid);
 
+// Index of the members of a module by lowercase name. Looking up the
+// already loaded members of a module is otherwise linear in the number of
+// members, which makes loading modules that reexport many others quadratic.
+// Members are only appended while loading, so the index is completed
+// lazily with the members added since the last lookup
+typedef
+struct module_members_index_tag
+{
+    int num_indexed_members;
+    dhash_ptr_t* members_by_name;
+} module_members_index_t;
+
+typedef
+struct module_members_with_name_tag
+{
+    int num_members;
+    scope_entry_t** members;
+} module_members_with_name_t;
+
+static dhash_ptr_t* _module_members_index = NULL;
+
+static void free_module_members_with_name(const char* key UNUSED_PARAMETER,
+        void* info,
+        void* walk_info UNUSED_PARAMETER)
+{
+    module_members_with_name_t* members_with_name = (module_members_with_name_t*)info;
+    DELETE(members_with_name->members);
+    DELETE(members_with_name);
+}
+
+static void free_module_members_index(const char* key UNUSED_PARAMETER,
+        void* info,
+        void* walk_info UNUSED_PARAMETER)
+{
+    module_members_index_t* index = (module_members_index_t*)info;
+    dhash_ptr_walk(index->members_by_name, free_module_members_with_name, NULL);
+    dhash_ptr_destroy(index->members_by_name);
+    DELETE(index);
+}
+
+static void clear_module_members_index(void)
+{
+    if (_module_members_index == NULL)
+        return;
+
+    dhash_ptr_walk(_module_members_index, free_module_members_index, NULL);
+    dhash_ptr_destroy(_module_members_index);
+    _module_members_index = NULL;
+}
+
+static module_members_with_name_t* get_module_members_with_name(scope_entry_t* module, const char* name)
+{
+    if (_module_members_index == NULL)
+        _module_members_index = dhash_ptr_new(5);
+
+    module_members_index_t* index = (module_members_index_t*)dhash_ptr_query(
+            _module_members_index, (const char*)module);
+    if (index == NULL)
+    {
+        index = NEW0(module_members_index_t);
+        index->members_by_name = dhash_ptr_new(5);
+        dhash_ptr_insert(_module_members_index, (const char*)module, index);
+    }
+
+    int num_members = symbol_entity_specs_get_num_related_symbols(module);
+    int i;
+    for (i = index->num_indexed_members; i < num_members; i++)
+    {
+        scope_entry_t* member = symbol_entity_specs_get_related_symbols_num(module, i);
+        const char* member_name = strtolower(member->symbol_name);
+
+        module_members_with_name_t* members_with_name = (module_members_with_name_t*)dhash_ptr_query(
+                index->members_by_name, member_name);
+        if (members_with_name == NULL)
+        {
+            members_with_name = NEW0(module_members_with_name_t);
+            dhash_ptr_insert(index->members_by_name, member_name, members_with_name);
+        }
+
+        P_LIST_ADD(members_with_name->members, members_with_name->num_members, member);
+    }
+    index->num_indexed_members = num_members;
+
+    return (module_members_with_name_t*)dhash_ptr_query(index->members_by_name, strtolower(name));
+}
+
 static int get_symbol(void *datum, 
         int ncols,
         char **values, 
@@ -2036,6 +2144,7 @@ static int get_symbol(void *datum,
     // Early checks to use already loaded symbols
     if (symbol_kind == SK_MODULE)
     {
+        fortran_register_intrinsic_modules_if_needed();
         rb_red_blk_node* query = rb_tree_query(CURRENT_COMPILED_FILE->module_file_cache, strtolower(name));
         // Check if this symbol is in the cache and reuse it 
         if (query != NULL)
@@ -2076,13 +2185,16 @@ static int get_symbol(void *datum,
             }
         }
 
+        module_members_with_name_t* members_with_name = NULL;
         if (in_module != NULL)
+            members_with_name = get_module_members_with_name(in_module, name);
+
+        if (members_with_name != NULL)
         {
-            for (i = 0; i < symbol_entity_specs_get_num_related_symbols(in_module); i++)
+            for (i = 0; i < members_with_name->num_members; i++)
             {
-                scope_entry_t* member = symbol_entity_specs_get_related_symbols_num(in_module, i);
-                if (strcasecmp(member->symbol_name, name) == 0
-                        && member->kind == (enum cxx_symbol_kind)symbol_kind
+                scope_entry_t* member = members_with_name->members[i];
+                if (member->kind == (enum cxx_symbol_kind)symbol_kind
                         && symbol_entity_specs_get_from_module(member) == from_module
                         && symbol_entity_specs_get_alias_to(member) == alias_to)
                 {
@@ -2879,17 +2991,17 @@ static type_t* load_type(sqlite3* handle, sqlite3_uint64 oid)
     return type_handle.type;
 }
 
-static sqlite3_uint64 insert_single_const_value(sqlite3* handle, const_value_t* v)
+static sqlite3_uint64 insert_raw_const_value(sqlite3* handle, const void* raw_bytes, size_t size)
 {
     // Check if the blob is already there
-    sqlite3_bind_blob(_check_raw_const_value_stmt, 1, v, const_value_get_raw_data_size(), SQLITE_STATIC);
+    sqlite3_bind_blob(_check_raw_const_value_stmt, 1, raw_bytes, size, SQLITE_STATIC);
 
     sqlite3_uint64 raw_oid = 0;
 
     int result_check = sqlite3_step(_check_raw_const_value_stmt);
     if (result_check == SQLITE_DONE)
     {
-        sqlite3_bind_blob(_insert_raw_const_value_stmt, 1, v, const_value_get_raw_data_size(), SQLITE_STATIC);
+        sqlite3_bind_blob(_insert_raw_const_value_stmt, 1, raw_bytes, size, SQLITE_STATIC);
         raw_oid = run_insert_statement(handle, _insert_raw_const_value_stmt);
     }
     else if (result_check == SQLITE_ROW)
@@ -2904,6 +3016,13 @@ static sqlite3_uint64 insert_single_const_value(sqlite3* handle, const_value_t*
 
     ERROR_CONDITION(raw_oid == 0, "Invalid OID\n", 0);
 
+    return raw_oid;
+}
+
+static sqlite3_uint64 insert_single_const_value(sqlite3* handle, const_value_t* v)
+{
+    sqlite3_uint64 raw_oid = insert_raw_const_value(handle, v, const_value_get_raw_data_size());
+
     sqlite3_bind_int64(_insert_const_value_stmt, 1, P2ULL(v));
     sqlite3_bind_int64(_insert_const_value_stmt, 2, raw_oid);
 
@@ -2912,6 +3031,23 @@ static sqlite3_uint64 insert_single_const_value(sqlite3* handle, const_value_t*
     return result;
 }
 
+// Packed arrays are stored as a single blob rather than one row per element
+static sqlite3_uint64 insert_packed_const_value(sqlite3* handle, const_value_t* v)
+{
+    size_t size = 0;
+    char* raw_bytes = const_value_packed_array_get_raw_data(v, &size);
+    sqlite3_uint64 raw_oid = insert_raw_const_value(handle, raw_bytes, size);
+    DELETE(raw_bytes);
+
+    sqlite3_bind_int64(_insert_packed_const_value_stmt, 1, P2ULL(v));
+    sqlite3_bind_int  (_insert_packed_const_value_stmt, 2, CKT_PACKED_ARRAY);
+    sqlite3_bind_int64(_insert_packed_const_value_stmt, 3, raw_oid);
+
+    sqlite3_uint64 result = run_insert_statement(handle, _insert_packed_const_value_stmt);
+
+    return result;
+}
+
 static sqlite3_uint64 insert_multiple_const_value(sqlite3* handle, const_value_t* v, const_kind_table_t kind, type_t* struct_type)
 {
     sqlite3_uint64 struct_type_id = insert_type(handle, struct_type);
@@ -2965,6 +3101,10 @@ static sqlite3_uint64 insert_const_value(sqlite3* handle, const_value_t* value)
         type_t* struct_type = const_value_get_struct_type(value);
         return insert_multiple_const_value(handle, value, CKT_STRUCT, struct_type);
     }
+    else if (const_value_is_packed_array(value))
+    {
+        return insert_packed_const_value(handle, value);
+    }
     else if (const_value_is_array(value))
     {
         return insert_multiple_const_value(handle, value, CKT_ARRAY, NULL);
@@ -3007,7 +3147,10 @@ static const_value_t* load_const_value(sqlite3* handle, sqlite3_uint64 oid)
         // Single values have a raw_oid
         if (column_type == SQLITE_INTEGER)
         {
-            // Single value
+            // Single value or packed array
+            char is_packed_array =
+                (sqlite3_column_type(_select_const_value_stmt, 1) == SQLITE_INTEGER
+                 && sqlite3_column_int(_select_const_value_stmt, 1) == CKT_PACKED_ARRAY);
             sqlite_uint64 raw_oid = sqlite3_column_int64(_select_const_value_stmt, 2);
             sqlite3_reset(_select_const_value_stmt);
 
@@ -3016,7 +3159,12 @@ static const_value_t* load_const_value(sqlite3* handle, sqlite3_uint64 oid)
 
             if (result_query == SQLITE_ROW)
             {
-                result = const_value_build_from_raw_data(sqlite3_column_blob(_select_raw_const_value_stmt, 0));
+                if (is_packed_array)
+                    result = const_value_build_packed_array_from_raw_data(
+                            sqlite3_column_blob(_select_raw_const_value_stmt, 0),
+                            sqlite3_column_bytes(_select_raw_const_value_stmt, 0));
+                else
+                    result = const_value_build_from_raw_data(sqlite3_column_blob(_select_raw_const_value_stmt, 0));
                 sqlite3_reset(_select_raw_const_value_stmt);
             }
             else
@@ -3147,6 +3295,8 @@ static const_value_t* load_const_value(sqlite3* handle, sqlite3_uint64 oid)
 
 static void dispose_storage(sqlite3* handle)
 {
+    clear_module_members_index();
+
     int i;
     for (i = 0; _prepared_statements_registry[i] != NULL; i++)
     {
@@ -3426,8 +3576,258 @@ void extend_module_info(scope_entry_t* module, const char* domain, int num_items
     dispose_storage(handle);
 }
 
+// Tables whose oids are the addresses of the objects written. They change
+// in every run, so these rows are hashed in the order they are reached
+// from the module and their oids are replaced by that order
+static const char* _module_file_address_tables[] =
+{
+    "symbol",
+    "type",
+    "ast",
+    "decl_context",
+    "scope",
+    "const_value",
+    NULL
+};
+
+// The rows of these tables are numbered in the order they were inserted,
+// which does not depend on addresses
+static const char* _module_file_sequential_tables[] =
+{
+    "info",
+    "string_table",
+    "attributes",
+    "raw_const_value",
+    "multi_const_value",
+    "module_extra_name",
+    "module_extra_data",
+    NULL
+};
+
+typedef struct module_file_oid_tag
+{
+    int table;
+    sqlite3_int64 canonical_id;
+} module_file_oid_t;
+
+typedef struct module_file_hash_tag
+{
+    sqlite3* handle;
+    const char* filename;
+    uint64_t hash;
+
+    // Maps the oid of every row of an address table to a module_file_oid_t
+    rb_red_blk_tree* oids;
+    sqlite3_int64 next_canonical_id;
+
+    // Rows reached but not hashed yet
+    int num_pending;
+    sqlite3_int64* pending;
+} module_file_hash_t;
+
+static void free_module_file_oid_key(const void* p)
+{
+    DELETE((void*)p);
+}
+
+static sqlite3_stmt* prepare_module_file_hash_query(module_file_hash_t* data, const char* query)
+{
+    sqlite3_stmt* stmt = NULL;
+    if (sqlite3_prepare_v2(data->handle, query, -1, &stmt, NULL) != SQLITE_OK)
+    {
+        internal_error("Could not prepare query '%s' (%s)", query, sqlite3_errmsg(data->handle));
+    }
+    return stmt;
+}
+
+static void finish_module_file_hash_query(module_file_hash_t* data, sqlite3_stmt* stmt, int result_query)
+{
+    if (result_query != SQLITE_DONE)
+    {
+        internal_error("Unexpected error %d when hashing module file '%s' (%s)",
+                result_query, data->filename, sqlite3_errmsg(data->handle));
+    }
+    sqlite3_finalize(stmt);
+}
+
+// Hashes an integer value. If it is the oid of a row of an address table,
+// its canonical id is hashed instead and the row is hashed later
+static void hash_module_file_integer(module_file_hash_t* data, sqlite3_int64 value)
+{
+    rb_red_blk_node* n = rb_tree_query(data->oids, &value);
+    if (n == NULL)
+    {
+        driver_fortran_hash_bytes(&data->hash, "I", 1);
+        driver_fortran_hash_bytes(&data->hash, &value, sizeof(value));
+        return;
+    }
+
+    module_file_oid_t* oid = (module_file_oid_t*)rb_node_get_info(n);
+    if (oid->canonical_id == 0)
+    {
+        oid->canonical_id = ++data->next_canonical_id;
+        P_LIST_ADD(data->pending, data->num_pending, value);
+    }
+
+    driver_fortran_hash_bytes(&data->hash, "R", 1);
+    driver_fortran_hash_bytes(&data->hash, &oid->canonical_id, sizeof(oid->canonical_id));
+}
+
+// Lists of types and symbols are stored as text like "oid1,oid2"
+static char is_module_file_oid_list(const unsigned char* text, int size)
+{
+    if (size == 0)
+        return 0;
+
+    int i;
+    for (i = 0; i < size; i++)
+    {
+        if (!(('0' <= text[i] && text[i] <= '9') || text[i] == ','))
+            return 0;
+    }
+    return 1;
+}
+
+static void hash_module_file_row(module_file_hash_t* data, sqlite3_stmt* stmt)
+{
+    int ncols = sqlite3_column_count(stmt);
+    int j;
+    for (j = 0; j < ncols; j++)
+    {
+        // Neither the date nor the lines of the declarations are
+        // part of the interface of the module
+        const char* column_name = sqlite3_column_name(stmt, j);
+        if (strcmp(column_name, "date") == 0
+                || strcmp(column_name, "line") == 0)
+            continue;
+
+        int column_type = sqlite3_column_type(stmt, j);
+        if (column_type == SQLITE_INTEGER)
+        {
+            hash_module_file_integer(data, sqlite3_column_int64(stmt, j));
+        }
+        else if (column_type == SQLITE_TEXT
+                && is_module_file_oid_list(sqlite3_column_text(stmt, j), sqlite3_column_bytes(stmt, j)))
+        {
+            const char* text = (const char*)sqlite3_column_text(stmt, j);
+            driver_fortran_hash_bytes(&data->hash, "L", 1);
+            while (*text != '\0')
+            {
+                char* next = NULL;
+                sqlite3_int64 value = strtoll(text, &next, 10);
+                hash_module_file_integer(data, value);
+                text = (*next == ',') ? next + 1 : next;
+            }
+        }
+        else
+        {
+            const void* value = sqlite3_column_blob(stmt, j);
+            int size = sqlite3_column_bytes(stmt, j);
+
+            driver_fortran_hash_bytes(&data->hash, &column_type, sizeof(column_type));
+            driver_fortran_hash_bytes(&data->hash, &size, sizeof(size));
+            driver_fortran_hash_bytes(&data->hash, value, size);
+        }
+    }
+}
+
+static void hash_pending_module_file_rows(module_file_hash_t* data)
+{
+    // Rows are hashed in the order of their canonical ids
+    int i;
+    for (i = 0; i < data->num_pending; i++)
+    {
+        sqlite3_int64 value = data->pending[i];
+        module_file_oid_t* oid = (module_file_oid_t*)rb_node_get_info(rb_tree_query(data->oids, &value));
+
+        char* query = sqlite3_mprintf("SELECT * FROM %s WHERE oid = %lld;",
+                _module_file_address_tables[oid->table], value);
+        sqlite3_stmt* stmt = prepare_module_file_hash_query(data, query);
+        sqlite3_free(query);
+
+        driver_fortran_hash_bytes(&data->hash, &oid->table, sizeof(oid->table));
+
+        int result_query;
+        while ((result_query = sqlite3_step(stmt)) == SQLITE_ROW)
+        {
+            hash_module_file_row(data, stmt);
+        }
+        finish_module_file_hash_query(data, stmt, result_query);
+    }
+
+    DELETE(data->pending);
+    data->pending = NULL;
+    data->num_pending = 0;
+}
+
+const char* module_file_interface_hash(const char* filename)
+{
+    module_file_hash_t data;
+    memset(&data, 0, sizeof(data));
+    data.filename = filename;
+    data.hash = 14695981039346656037ULL;
+    data.oids = rb_tree_create(int64cmp_vptr, free_module_file_oid_key, free_module_file_oid_key);
+
+    if (sqlite3_open_v2(filename, &data.handle, SQLITE_OPEN_READONLY, NULL) != SQLITE_OK)
+    {
+        fatal_error("Error while opening module database '%s' (%s)\n", filename, sqlite3_errmsg(data.handle));
+    }
+
+    int i;
+    for (i = 0; _module_file_address_tables[i] != NULL; i++)
+    {
+        char* query = sqlite3_mprintf("SELECT oid FROM %s;", _module_file_address_tables[i]);
+        sqlite3_stmt* stmt = prepare_module_file_hash_query(&data, query);
+        sqlite3_free(query);
+
+        int result_query;
+        while ((result_query = sqlite3_step(stmt)) == SQLITE_ROW)
+        {
+            sqlite3_int64* key = NEW(sqlite3_int64);
+            *key = sqlite3_column_int64(stmt, 0);
+
+            module_file_oid_t* oid = NEW0(module_file_oid_t);
+            oid->table = i;
+
+            rb_tree_insert(data.oids, key, oid);
+        }
+        finish_module_file_hash_query(&data, stmt, result_query);
+    }
+
+    // Everything is reached from the root symbol in the info table. Rows
+    // referenced only from the other sequential tables are hashed after them
+    for (i = 0; _module_file_sequential_tables[i] != NULL; i++)
+    {
+        char* query = sqlite3_mprintf("SELECT * FROM %s ORDER BY rowid;", _module_file_sequential_tables[i]);
+        sqlite3_stmt* stmt = prepare_module_file_hash_query(&data, query);
+        sqlite3_free(query);
+
+        driver_fortran_hash_bytes(&data.hash, _module_file_sequential_tables[i],
+                strlen(_module_file_sequential_tables[i]) + 1);
+
+        int result_query;
+        while ((result_query = sqlite3_step(stmt)) == SQLITE_ROW)
+        {
+            hash_module_file_row(&data, stmt);
+        }
+        finish_module_file_hash_query(&data, stmt, result_query);
+
+        hash_pending_module_file_rows(&data);
+    }
+
+    if (sqlite3_close(data.handle) != SQLITE_OK)
+    {
+        fatal_error("Error while closing database (%s)\n", sqlite3_errmsg(data.handle));
+    }
+
+    rb_tree_destroy(data.oids);
+
+    return driver_fortran_hash_to_str(data.hash);
+}
+
 scope_entry_t* get_module_in_cache(const char* module_name)
 {
+    fortran_register_intrinsic_modules_if_needed();
     rb_red_blk_node* query = rb_tree_query(CURRENT_COMPILED_FILE->module_file_cache, module_name);
     ERROR_CONDITION(query == NULL, "Module '%s' has not been registered", module_name);
     scope_entry_t* module_sym = (scope_entry_t*)rb_node_get_info(query);
@@ -37,6 +37,10 @@ void load_module_info(const char* module_name, scope_entry_t** module);
 
 scope_entry_t* get_module_in_cache(const char* module_name);
 
+// Hash of the contents of a module file that other files depend on. It
+// does not change when the same interface is written again
+const char* module_file_interface_hash(const char* filename);
+
 // This is used in TL
 void extend_module_info(scope_entry_t* module, const char* domain, int num_items, tl_type_t* info);
 
@@ -458,7 +458,13 @@ scope_entry_t* fortran_query_intrinsic_name_str(const decl_context_t* decl_conte
 {
     const decl_context_t* global_context = fortran_get_context_of_intrinsics(decl_context);
 
-    scope_entry_list_t* global_list = query_in_scope_str(global_context, strtolower(unqualified_name), NULL);
+    const char* name = strtolower(unqualified_name);
+    scope_entry_list_t* global_list = query_in_scope_str(global_context, name, NULL);
+    if (global_list == NULL
+            && fortran_register_intrinsic_lazily(global_context, name))
+    {
+        global_list = query_in_scope_str(global_context, name, NULL);
+    }
 
     scope_entry_list_t* result_list = filter_symbol_using_predicate(global_list,
             symbol_is_intrinsic_function_not_from_module, NULL);
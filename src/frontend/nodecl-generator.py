@@ -716,6 +716,103 @@ NodeclBase nb(::_nodecl_wrap(elem)); this->walk(nb); } break; }
     print "} /* namespace Nodecl */"
     print "#endif // TL_NODECL_VISITOR_CPP"
 
+def generate_static_visitor_class_header(rule_map):
+    print "/* Autogenerated file. DO NOT MODIFY. */"
+    print "/* Changes in nodecl-generator.py or cxx-nodecl.def will overwrite this file */"
+    print "#ifndef TL_NODECL_STATIC_VISITOR_HPP"
+    print "#define TL_NODECL_STATIC_VISITOR_HPP"
+    print ""
+    print "#include <tl-nodecl.hpp>"
+    print "#include \"cxx-utils.h\""
+    print ""
+    print "namespace Nodecl {"
+    print ""
+    print "//! Visitor of nodecl trees with static dispatch"
+    print "/*!"
+    print " * _Derived is the visitor class deriving from this one. walk calls"
+    print " * directly, without virtual calls, the member function visit of _Derived"
+    print " * for the kind of the node. If it is not defined for that kind,"
+    print " * unhandled_node is called instead."
+    print " *"
+    print " * _Derived must make visible the visit member functions of this class with"
+    print " * 'using StaticNodeclVisitor<_Derived>::visit;' unless it handles every"
+    print " * kind of node itself"
+    print " */"
+    classes = get_all_class_names_and_namespaces(rule_map)
+    print "template <typename _Derived>"
+    print "class StaticNodeclVisitor"
+    print "{"
+    print "   protected:"
+    print "     _Derived& derived() { return *static_cast<_Derived*>(this); }"
+    print "   public:"
+    print "     typedef void Ret;"
+    print "     void walk(const NodeclBase&);"
+    print "     void unhandled_node(const Nodecl::NodeclBase &) { }"
+    for (namespaces, class_name) in classes:
+        qualified_name = get_qualified_name(namespaces, class_name)
+        print "     void visit(const Nodecl::%s & n) { this->derived().unhandled_node(n); }" % (qualified_name)
+    print "};"
+    print ""
+    print "//! Visitor of nodecl trees with static dispatch that visits all the nodes"
+    print "/*!"
+    print " * Like ExhaustiveVisitor<void> but visit_pre returns whether the children"
+    print " * of the node have to be visited. If it returns false neither the children"
+    print " * nor visit_post of the node are visited."
+    print " *"
+    print " * _Derived overriding visit_pre or visit_post for some kinds of node must"
+    print " * make visible the generic ones of this class with"
+    print " * 'using StaticExhaustiveVisitor<_Derived>::visit_pre;' (or visit_post)"
+    print " */"
+    print "template <typename _Derived>"
+    print "class StaticExhaustiveVisitor : public StaticNodeclVisitor<_Derived>"
+    print "{"
+    print "   public:"
+    print "     typedef void Ret;"
+    print "     template <typename _Node>"
+    print "     bool visit_pre(const _Node &) { return true; }"
+    print "     template <typename _Node>"
+    print "     void visit_post(const _Node &) { }"
+    classes_and_children = get_all_class_names_and_children_names_namespaces_and_modules(rule_map)
+    for ((namespaces, class_name), children_name, tree_kind, nodecl_class, module_name) in classes_and_children:
+         qualified_name = get_qualified_name(namespaces, class_name)
+         print "     void visit(const Nodecl::%s & n)" % (qualified_name)
+         print "     {"
+         print "        if (!this->derived().visit_pre(n))"
+         print "            return;"
+         for child_name in children_name:
+              print "        this->walk(n.get_%s());" % (child_name)
+         print "        this->derived().visit_post(n);"
+         print "     }"
+    print "};"
+    print ""
+    print "template <typename _Derived>"
+    print "void StaticNodeclVisitor<_Derived>::walk(const NodeclBase& n)"
+    print "{"
+    print """
+    if (n.is_null())
+        return;
+    switch ((int)n.get_kind())
+    {
+        case AST_NODE_LIST: { AST tree = nodecl_get_ast(n.get_internal_nodecl()); AST it; for_each_element(tree, it) { AST elem = ASTSon1(it);
+NodeclBase nb(::_nodecl_wrap(elem)); this->walk(nb); } break; }
+"""
+    node_kind = set([])
+    for rule_name in rule_map:
+        rule_rhs = rule_map[rule_name]
+        for rhs in rule_rhs:
+            if rhs.__class__ == NodeclStructure:
+                node_kind.add((rhs.name_to_underscore(), from_underscore_to_camel_case_namespaces(rhs.base_name().lower())))
+    for (kind_name, (namespaces, class_name)) in node_kind:
+        print "       case %s: { this->derived().visit(static_cast<const Nodecl::%s &>(n)); break; }" % (kind_name, get_qualified_name(namespaces, class_name))
+    print """
+       default:
+           { internal_error("Unexpected tree kind '%s'\\n", ast_print_node_type(n.get_kind())); }
+    }
+"""
+    print "}"
+    print "} /* namespace Nodecl */"
+    print "#endif // TL_NODECL_STATIC_VISITOR_HPP"
+
 def generate_copy_visitor_class_header(rule_map):
     print "/* Autogenerated file. DO NOT MODIFY. */"
     print "/* Changes in nodecl-generator.py or cxx-nodecl.def will overwrite this file */"
@@ -1116,6 +1213,11 @@ def generate_routines_impl(rule_map):
            print "  nodecl_set_template_parameters(result, template_parameters);"
        if rhs_rule.needs_decl_context:
            print "  nodecl_set_decl_context(result, decl_context);"
+       if rhs_rule.name_to_underscore() in ["NODECL_PRAGMA_CUSTOM_DIRECTIVE",
+               "NODECL_PRAGMA_CUSTOM_STATEMENT",
+               "NODECL_PRAGMA_CUSTOM_DECLARATION"]:
+           # Keeps TL::PragmaIndex up to date
+           print "  nodecl_note_pragma_custom_made();"
 
        print "  return result;"
        print "}"
@@ -1548,6 +1650,8 @@ elif op_mode == "cxx_visitor_decl":
     generate_visitor_class_header(rule_map)
 elif op_mode == "cxx_visitor_impl":
     generate_visitor_class_impl(rule_map)
+elif op_mode == "cxx_static_visitor_decl":
+    generate_static_visitor_class_header(rule_map)
 elif op_mode == "cxx_copy_visitor_decl":
     generate_copy_visitor_class_header(rule_map)
 elif op_mode == "cxx_copy_visitor_impl":
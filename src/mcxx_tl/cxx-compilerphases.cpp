@@ -50,6 +50,7 @@
 #include "tl-objectlist.hpp"
 #include "tl-builtin.hpp"
 #include "tl-nodecl.hpp"
+#include "tl-source.hpp"
 #include "codegen-phase.hpp"
 
 namespace TL
@@ -142,6 +143,44 @@ namespace TL
                 }
             }
 
+            // Kinds of all the nodes of the tree
+            static void compute_present_kinds(nodecl_t root, std::set<node_t>& present_kinds)
+            {
+                present_kinds.clear();
+
+                // Lists can be very long, so do not recurse
+                std::vector<AST> pending;
+                pending.push_back(nodecl_get_ast(root));
+                while (!pending.empty())
+                {
+                    AST a = pending.back();
+                    pending.pop_back();
+
+                    if (a == NULL)
+                        continue;
+
+                    present_kinds.insert(ASTKind(a));
+                    for (int i = 0; i < MCXX_MAX_AST_CHILDREN; i++)
+                    {
+                        pending.push_back(ast_get_child(a, i));
+                    }
+                }
+            }
+
+            static bool phase_is_triggered(TL::CompilerPhase* phase,
+                    const std::set<node_t>& present_kinds)
+            {
+                const std::set<node_t>& trigger_kinds = phase->get_trigger_kinds();
+                for (std::set<node_t>::const_iterator it = trigger_kinds.begin();
+                        it != trigger_kinds.end();
+                        it++)
+                {
+                    if (present_kinds.find(*it) != present_kinds.end())
+                        return true;
+                }
+                return false;
+            }
+
             static void start_compiler_phase_execution(compilation_configuration_t* config, translation_unit_t* translation_unit)
             {
                 if (compiler_phases.find(config) == compiler_phases.end())
@@ -152,6 +191,21 @@ namespace TL
 
                 compiler_phases_list_t &compiler_phases_list = compiler_phases[config];
 
+                TL::Source::clear_parse_cache();
+                TL::Source::reset_num_parsed_fragments();
+                if (debug_options.stats_tl_source)
+                {
+                    fprintf(stderr, "TL::Source fragments parsed in '%s'\n",
+                            translation_unit->input_filename);
+                }
+
+                // Kinds of the nodes of the tree, computed again only when
+                // the tree has been modified since
+                std::set<node_t> present_kinds;
+                bool present_kinds_are_valid = false;
+                unsigned int present_kinds_modification_count = 0;
+                TL::ObjectList<std::string> skipped_phases;
+
                 for (compiler_phases_list_t::iterator it = compiler_phases_list.begin();
                         it != compiler_phases_list.end();
                         it++)
@@ -171,13 +225,49 @@ namespace TL
 
                     TL::CompilerPhase* phase = (*it);
 
+                    if (!phase->get_trigger_kinds().empty()
+                            && !debug_options.do_not_skip_phases)
+                    {
+                        if (!present_kinds_are_valid
+                                || nodecl_get_modification_count(translation_unit->nodecl) != present_kinds_modification_count)
+                        {
+                            compute_present_kinds(translation_unit->nodecl, present_kinds);
+                            present_kinds_are_valid = true;
+                            present_kinds_modification_count = nodecl_get_modification_count(translation_unit->nodecl);
+                        }
+
+                        if (!phase_is_triggered(phase, present_kinds))
+                        {
+                            DEBUG_CODE()
+                            {
+                                fprintf(stderr, "COMPILERPHASES: Skipping phase '%s' since the tree has no node it handles\n",
+                                        phase->get_phase_name().c_str());
+                            }
+                            skipped_phases.append(phase->get_phase_name());
+
+                            phase->phase_cleanup(dto);
+                            continue;
+                        }
+                    }
+
                     DEBUG_CODE()
                     {
                         fprintf(stderr, "COMPILERPHASES: Running phase '%s'\n", phase->get_phase_name().c_str());
                     }
 
+                    unsigned int num_parsed_fragments = TL::Source::get_num_parsed_fragments();
+                    unsigned int num_reused_fragments = TL::Source::get_num_reused_fragments();
+
                     phase->run(dto);
 
+                    if (debug_options.stats_tl_source)
+                    {
+                        fprintf(stderr, "    %-40s %u (%u reused)\n",
+                                phase->get_phase_name().c_str(),
+                                TL::Source::get_num_parsed_fragments() - num_parsed_fragments,
+                                TL::Source::get_num_reused_fragments() - num_reused_fragments);
+                    }
+
                     if (phase->get_phase_status() != CompilerPhase::PHASE_STATUS_OK)
                     {
                         // Ideas to improve this are welcome :)
@@ -241,6 +331,21 @@ namespace TL
                     }
                 }
 
+                if (CURRENT_CONFIGURATION->verbose
+                        && !skipped_phases.empty())
+                {
+                    fprintf(stderr, "Phases not run on '%s' since it has nothing they handle: %s\n",
+                            translation_unit->input_filename,
+                            concat_strings(skipped_phases, ", ").c_str());
+                }
+
+                if (debug_options.stats_tl_source)
+                {
+                    fprintf(stderr, "    %-40s %u (%u reused)\n", "Total",
+                            TL::Source::get_num_parsed_fragments(),
+                            TL::Source::get_num_reused_fragments());
+                }
+
                 // Run cleanup after the whole pipeline has been run
                 for (compiler_phases_list_t::iterator it = compiler_phases_list.begin();
                         it != compiler_phases_list.end();
@@ -711,6 +816,12 @@ extern "C"
         {
             fprintf(stderr, "COMPILERPHASES: Starting the compiler phase pipeline\n");
         }
+        if (config->codegen_phase != NULL)
+        {
+            // Codegen may want to know how the tree was before the phases
+            Codegen::CodegenPhase* codegen_phase = reinterpret_cast<Codegen::CodegenPhase*>(config->codegen_phase);
+            codegen_phase->pre_phases_execution(*reinterpret_cast<TL::DTO*>(translation_unit->dto));
+        }
         TL::CompilerPhaseRunner::start_compiler_phase_execution(config, translation_unit);
     }
 
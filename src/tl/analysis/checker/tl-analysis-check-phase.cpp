@@ -386,7 +386,7 @@ namespace {
             // Dead variables checking behaves a bit different, since we don't have a 'dead' set associated to each node
             if (current->has_dead_assertion())
             {
-                for (NodeclSet::iterator it = assert_dead.begin(); it != assert_dead.end(); ++it)
+                for (NodeclSet::const_iterator it = assert_dead.begin(); it != assert_dead.end(); ++it)
                 {
                     if (Utils::nodecl_set_contains_nodecl(*it, live_in))
                     {
@@ -306,7 +306,7 @@ namespace Utils {
             NodeclSet fake_set;
             fake_set.insert(n);
             
-            for(NodeclSet::iterator it = set.begin(); it != set.end(); ++it)
+            for(NodeclSet::const_iterator it = set.begin(); it != set.end(); ++it)
             {
                 if(!nodecl_set_contains_enclosing_nodecl(*it, fake_set).is_null())
                     result.append(it->shallow_copy());
@@ -423,10 +423,8 @@ ptd_nodecl_found:   ;
     
     NodeclSet nodecl_set_union(const NodeclSet& s1, const NodeclSet& s2)
     {
-        NodeclSet result;
-        std::set_union(s1.begin(), s1.end(), s2.begin(), s2.end(),
-                       std::inserter(result, result.begin()), 
-                       Nodecl::Utils::Nodecl_structural_less());
+        NodeclSet result(s1);
+        result.insert(s2.begin(), s2.end());
         return result;
     }
     
@@ -458,9 +456,9 @@ ptd_nodecl_found:   ;
     NodeclSet nodecl_set_difference(const NodeclSet& s1, const NodeclSet& s2)
     {
         NodeclSet result;
-        std::set_difference(s1.begin(), s1.end(), s2.begin(), s2.end(),
-                            std::inserter(result, result.begin()), 
-                            Nodecl::Utils::Nodecl_structural_less());
+        for (NodeclSet::const_iterator it = s1.begin(); it != s1.end(); ++it)
+            if (s2.find(*it) == s2.end())
+                result.insert(*it);
         return result;
     }
     
@@ -475,16 +473,13 @@ ptd_nodecl_found:   ;
     
     bool nodecl_set_equivalence(const NodeclSet& s1, const NodeclSet& s2)
     {
-        if(s1.size() == s2.size())
-        {
-            NodeclSet intersection;
-            std::set_intersection(s1.begin(), s1.end(), s2.begin(), s2.end(),
-                                  std::inserter(intersection, intersection.begin()), 
-                                  Nodecl::Utils::Nodecl_structural_less());
-            if(intersection.size() == s1.size())
-                return true;
-        }
-        return false;
+        if (s1.size() != s2.size())
+            return false;
+
+        for (NodeclSet::const_iterator it = s1.begin(); it != s1.end(); ++it)
+            if (s2.find(*it) == s2.end())
+                return false;
+        return true;
     }
     
     bool nodecl_map_equivalence(const NodeclMap& m1, const NodeclMap& m2)
@@ -492,28 +487,27 @@ ptd_nodecl_found:   ;
         if (m1.size() != m2.size())
             return false;
         
-        NodeclMap::const_iterator it1 = m1.begin();
-        NodeclMap::const_iterator it2 = m2.begin();
         std::pair <NodeclMap::const_iterator, NodeclMap::const_iterator> range1, range2;
-        for ( ; it1 != m1.end(); )
+        for (NodeclMap::const_iterator it1 = m1.begin(); it1 != m1.end(); it1 = range1.second)
         {
+            // Equal keys are adjacent, so this visits each key of m1 once
+            range1 = m1.equal_range(it1->first);
+            range2 = m2.equal_range(it1->first);
+
             // 1.- If the number of entries for a given key is different in the two sets, the maps are different
-            if (m1.count(it1->first) != m2.count(it2->first))
+            if (std::distance(range1.first, range1.second) != std::distance(range2.first, range2.second))
                 return false;
 
             // 2.- Compare all entries regardless of the order
-            range1 = m1.equal_range(it1->first);
-            range2 = m2.equal_range(it2->first);
-            for (NodeclMap::const_iterator itr1 = range1.first; itr1 != range1.second; )
+            for (NodeclMap::const_iterator itr1 = range1.first; itr1 != range1.second; ++itr1)
             {
-                for (NodeclMap::const_iterator itr2 = range2.first; itr2 != range2.second; ++itr2)
+                bool found = false;
+                for (NodeclMap::const_iterator itr2 = range2.first; itr2 != range2.second && !found; ++itr2)
                 {
-                    if (Nodecl::Utils::structurally_equal_nodecls(itr1->first, itr2->first, /*skip_conversions*/true)
-                            && Nodecl::Utils::structurally_equal_nodecls(itr1->second.first, itr2->second.first, /*skip_conversions*/true))
-                        goto next_it;
+                    found = Nodecl::Utils::structurally_equal_nodecls(itr1->second.first, itr2->second.first, /*skip_conversions*/true);
                 }
-                return false;
-next_it:        ++itr1, ++it1, ++it2;
+                if (!found)
+                    return false;
             }
         }
         return true;
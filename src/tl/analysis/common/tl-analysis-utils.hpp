@@ -35,6 +35,8 @@
 
 #include <set>
 #include <map>
+#include <unordered_set>
+#include <unordered_map>
 
 #define VERBOSE (debug_options.analysis_verbose || \
                  debug_options.enable_debug_code)
@@ -50,9 +52,16 @@ namespace Analysis {
 
     typedef Nodecl::NodeclBase NBase;
     typedef ObjectList<NBase> NodeclList;
-    typedef std::set<NBase, Nodecl::Utils::Nodecl_structural_less> NodeclSet;
+    // Sets and maps of trees compared structurally skipping conversions.
+    // std::unordered_* keep the hash of each element, so the hash of a tree
+    // is computed only once when inserting it
+    typedef std::unordered_set<NBase,
+            Nodecl::Utils::Nodecl_structural_hash,
+            Nodecl::Utils::Nodecl_structural_equal_skip_conversions> NodeclSet;
     typedef std::pair<NBase, NBase> NodeclPair;
-    typedef std::multimap<NBase, NodeclPair, Nodecl::Utils::Nodecl_structural_less> NodeclMap; 
+    typedef std::unordered_multimap<NBase, NodeclPair,
+            Nodecl::Utils::Nodecl_structural_hash,
+            Nodecl::Utils::Nodecl_structural_equal_skip_conversions> NodeclMap;
     typedef std::map<Nodecl::NodeclBase, tribool, Nodecl::Utils::Nodecl_structural_less> NodeclTriboolMap;
 
 namespace Utils {
@@ -139,8 +139,8 @@ namespace Utils {
             return false;
 
         // Compare the LBs
-        NodeclSet::iterator it = _lb.begin();
-        NodeclSet::iterator it_iv = iv._lb.begin();
+        NodeclSet::const_iterator it = _lb.begin();
+        NodeclSet::const_iterator it_iv = iv._lb.begin();
         for (; it != _lb.end() && equal_bounds; ++it, ++it_iv)
             equal_bounds = equal_bounds || Nodecl::Utils::structurally_equal_nodecls(*it, *it_iv);
 
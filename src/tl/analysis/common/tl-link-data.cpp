@@ -25,6 +25,7 @@
 --------------------------------------------------------------------*/
 
 #include "tl-link-data.hpp"
+#include "cxx-utils.h"
 
 namespace TL {
 namespace Analysis {
@@ -48,10 +49,10 @@ namespace Analysis {
         (*_num_copies)--;
         if (*_num_copies == 0)
         {
-            for (Dict::iterator it = _data_list->begin();
-                 it != _data_list->end(); it ++)
+            for (std::vector<data_info>::iterator it = _data_list->data.begin();
+                 it != _data_list->data.end(); it ++)
             {
-                data_info d = it->second;
+                data_info d = *it;
                 d.destructor(d.data);
             }
 
@@ -60,6 +61,24 @@ namespace Analysis {
         }
     }
 
+    LinkData::data_info& LinkData::lookup_or_insert(const int key)
+    {
+        data_info* d = lookup(key);
+        if (d != NULL)
+            return *d;
+
+        std::vector<unsigned char>& slots = _data_list->slots;
+        if ((unsigned int)key >= slots.size())
+            slots.resize(key + 1, 0);
+
+        ERROR_CONDITION(_data_list->data.size() >= 255,
+                "Too many data linked to the same object", 0);
+
+        _data_list->data.push_back(data_info());
+        slots[key] = _data_list->data.size();
+        return _data_list->data.back();
+    }
+
     LinkData::~LinkData()
     {
         release_code();
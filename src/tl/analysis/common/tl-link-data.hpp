@@ -29,7 +29,7 @@
 
 #include "tl-common.hpp"
 #include <cstring>  // NULL
-#include <tr1/unordered_map>
+#include <vector>
 
 namespace TL {
 namespace Analysis {
@@ -40,6 +40,13 @@ namespace Analysis {
      * it will not duplicate its contents but increase a number of copies
      * counter. In destruction this number is decreased, when it reaches zero
      * the whole structure will be deleted.
+     *
+     * Keys are expected to be small integers (like the values of
+     * PCFGAttribute) because they directly index a table of slots. Each
+     * slot is a byte, so at most 255 different keys can be linked to the
+     * same object. The data itself is still allocated separately and
+     * type-erased; classes that need direct access to some of their
+     * attributes keep them as members instead (see Node).
      */
     class LIBTL_CLASS LinkData
     {
@@ -59,13 +66,33 @@ namespace Analysis {
             {}
         };
         
+        //! Data linked to the object
+        /*!
+         * slots[key] is the position + 1 in data of the data with key,
+         * or 0 if there is no data with that key
+         */
+        struct Dict
+        {
+            std::vector<unsigned char> slots;
+            std::vector<data_info> data;
+        };
+
         // This is a pointer so this class can be copied
-        typedef std::tr1::unordered_map<int, data_info> Dict;
         Dict *_data_list;
         int *_num_copies;
 
         void release_code();
 
+        data_info* lookup(const int key) const
+        {
+            if ((unsigned int)key >= _data_list->slots.size()
+                    || _data_list->slots[key] == 0)
+                return NULL;
+            return &_data_list->data[_data_list->slots[key] - 1];
+        }
+
+        data_info& lookup_or_insert(const int key);
+
     public:
 
         //! Creates a new LinkData object.
@@ -107,22 +134,15 @@ namespace Analysis {
         template <typename _T>
         _T& get_data(const int key, const _T& t = _T())
         {
-            _T* result = NULL;
-            if (_data_list->find(key) == _data_list->end())
+            data_info* d = lookup(key);
+            if (d == NULL)
             {
-                result = new _T(t);
-
-                data_info d;
-                d.data = result;
-                d.destructor = destroy_adapter<_T>;
-
-                (*_data_list)[key] = d;
+                d = &lookup_or_insert(key);
+                d->data = new _T(t);
+                d->destructor = destroy_adapter<_T>;
             }
 
-            data_info d = (*_data_list)[key];
-            result = reinterpret_cast<_T*>(d.data);
-
-            return *result;
+            return *reinterpret_cast<_T*>(d->data);
         }
 
         //! Retrieves the data with key
@@ -138,7 +158,7 @@ namespace Analysis {
         template <typename _T>
         void set_data(const int key, const _T& data)
         {
-            data_info &d = (*_data_list)[key];
+            data_info &d = lookup_or_insert(key);
             d.destructor(d.data);
 
             d.data = new _T(data);
@@ -147,9 +167,14 @@ namespace Analysis {
 
         LinkData& operator=(const LinkData&);
 
-        bool has_key(const int key) const
+        //! Returns true when there is data with key
+        /*!
+         * Derived classes keeping some attributes as members override it,
+         * so it gives the same answer when called through a LinkData
+         */
+        virtual bool has_key(const int key) const
         {
-            return (_data_list->find(key) != _data_list->end());
+            return (lookup(key) != NULL);
         }
 
         //! Destroy object
@@ -157,7 +182,7 @@ namespace Analysis {
          * This destructor decreases the number of copies counter.
          * If it reaches zero, all data information is properly freed.
          */
-        ~LinkData();
+        virtual ~LinkData();
     };
 }
 }
@@ -47,7 +47,7 @@ namespace TL {
 namespace Analysis {
 
     AnalysisBase::AnalysisBase(bool is_ompss_enabled)
-            : _pcfgs(), _tdgs(), _all_functions(), _is_ompss_enabled(is_ompss_enabled),
+            : _pcfgs(), _tdgs(), _all_functions(), _callee_pcfgs(), _is_ompss_enabled(is_ompss_enabled),
               _pcfg(false), /*_constants_propagation(false),*/ _canonical(false),
               _use_def(false), _liveness(false), _loops(false),
               _reaching_definitions(false), _induction_variables(false),
@@ -72,6 +72,11 @@ namespace Analysis {
         return result;
     }
 
+    void AnalysisBase::set_callee_pcfgs(const ObjectList<ExtensibleGraph*>& callee_pcfgs)
+    {
+        _callee_pcfgs = callee_pcfgs;
+    }
+
     TaskDependencyGraph* AnalysisBase::get_tdg(std::string name) const
     {
         TaskDependencyGraph* tdg = NULL;
@@ -182,8 +187,10 @@ namespace Analysis {
                 for (ObjectList<NBase>::iterator it = _all_functions.begin();
                         it != _all_functions.end(); ++it)
                 {
-                    std::string func_name = it->get_symbol().get_name();
-                    if (functions.find(func_name) != functions.end())
+                    // SimdFunction and TaskCall do not have a symbol
+                    Symbol func_sym = it->get_symbol();
+                    if (func_sym.is_valid()
+                            && functions.find(func_sym.get_name()) != functions.end())
                         unique_asts.append(*it);
                 }
             }
@@ -286,13 +293,22 @@ namespace Analysis {
 
         std::set<Symbol> visited_funcs;
         ObjectList<ExtensibleGraph*> pcfgs = get_pcfgs();
+
+        // The PCFGs of the callees analyzed elsewhere are only looked up, never analyzed here
+        ObjectList<ExtensibleGraph*> known_pcfgs = pcfgs;
+        for (ObjectList<ExtensibleGraph*>::iterator it = _callee_pcfgs.begin(); it != _callee_pcfgs.end(); ++it)
+        {
+            visited_funcs.insert((*it)->get_function_symbol());
+            known_pcfgs.append(*it);
+        }
+
         for (ObjectList<ExtensibleGraph*>::iterator it = pcfgs.begin(); it != pcfgs.end(); ++it)
         {
             if (!(*it)->usage_is_computed())
             {
                 PointerSize ps(*it);
                 ps.compute_pointer_vars_size();
-                use_def_rec((*it)->get_function_symbol(), propagate_graph_nodes, visited_funcs, pcfgs);
+                use_def_rec((*it)->get_function_symbol(), propagate_graph_nodes, visited_funcs, known_pcfgs);
             }
         }
 
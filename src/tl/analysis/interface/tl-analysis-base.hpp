@@ -94,6 +94,7 @@ namespace Analysis {
         Name_to_pcfg_map _pcfgs;
         Name_to_tdg_map _tdgs;
         ObjectList<NBase> _all_functions;
+        ObjectList<ExtensibleGraph*> _callee_pcfgs; //!<PCFGs of called functions analyzed by another AnalysisBase
 
         bool _is_ompss_enabled;
         
@@ -152,6 +153,13 @@ namespace Analysis {
         
         // *** Modifiers *** //
 
+        /*!Sets the PCFGs of functions called from the code analyzed here that have already been
+         * analyzed by another AnalysisBase. Use-def takes the information of these functions from
+         * them instead of analyzing them again
+         * Call this method before computing any analysis and build the PCFGs with call_graph = false
+         */
+        void set_callee_pcfgs(const ObjectList<ExtensibleGraph*>& callee_pcfgs);
+
         /*!This analysis creates one Parallel Control Flow Graph per each function contained in \ast
          * If \ast contains no function, then the method creates a PCFG for the whole code in \ast
          * The memento is modified containing the PCFGs and a flag is set indicating the PCFG analysis has been performed
@@ -0,0 +1,266 @@
+/*--------------------------------------------------------------------
+ (C) Copyright 2006-2014 Barcelona Supercomputing Center             *
+ Centro Nacional de Supercomputacion
+
+ This file is part of Mercurium C/C++ source-to-source compiler.
+
+ See AUTHORS file in the top level directory for information
+ regarding developers and contributors.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ Mercurium C/C++ source-to-source compiler is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the
+ implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with Mercurium C/C++ source-to-source compiler; if
+ not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+ Cambridge, MA 02139, USA.
+
+ --------------------------------------------------------------------*/
+
+
+#include "cxx-driver-decls.h"
+
+#include "tl-analysis-manager.hpp"
+#include "tl-analysis-utils.hpp"
+
+namespace TL {
+namespace Analysis {
+
+    AnalysisManager::AnalysisEntry::AnalysisEntry(
+            AnalysisBase* analysis,
+            const NBase& analyzed_ast)
+        : _analysis(analysis), _analyzed_ast(analyzed_ast),
+          _computed(WhichAnalysis::NONE), _functions(), _callee_functions(), _in_progress(false)
+    {}
+
+    AnalysisManager::AnalysisManager()
+        : _analyses(), _top_level(), _compilation_id(0)
+    {}
+
+    AnalysisManager::~AnalysisManager()
+    {
+        clear();
+    }
+
+    AnalysisManager& AnalysisManager::get_manager()
+    {
+        static AnalysisManager manager;
+        return manager;
+    }
+
+namespace {
+    //!Returns the functions analyzed separately in \ast
+    ObjectList<NBase> get_functions(const NBase& ast)
+    {
+        if (!ast.is<Nodecl::TopLevel>())
+            return ObjectList<NBase>(1, ast);
+
+        Utils::TopLevelVisitor tlv;
+        tlv.walk_functions(ast);
+        return tlv.get_functions();
+    }
+
+    //!Returns the PCFGs of \analysis built for the function \func
+    ObjectList<ExtensibleGraph*> get_function_pcfgs(const AnalysisBase& analysis, const NBase& func)
+    {
+        ObjectList<ExtensibleGraph*> result;
+        const ObjectList<ExtensibleGraph*>& pcfgs = analysis.get_pcfgs();
+        for (ObjectList<ExtensibleGraph*>::const_iterator it = pcfgs.begin(); it != pcfgs.end(); ++it)
+        {
+            if ((*it)->get_nodecl() == func)
+                result.append(*it);
+        }
+        return result;
+    }
+}
+
+    AnalysisManager::Modification_counts AnalysisManager::get_modification_counts(
+            const ObjectList<ExtensibleGraph*>& pcfgs)
+    {
+        Modification_counts result;
+        for (ObjectList<ExtensibleGraph*>::const_iterator it = pcfgs.begin(); it != pcfgs.end(); ++it)
+        {
+            NBase func = (*it)->get_nodecl();
+            result.push_back(std::make_pair(func, nodecl_get_modification_count(func.get_internal_nodecl())));
+        }
+        return result;
+    }
+
+    bool AnalysisManager::is_up_to_date(const Modification_counts& functions)
+    {
+        for (Modification_counts::const_iterator it = functions.begin(); it != functions.end(); ++it)
+        {
+            if (nodecl_get_modification_count(it->first.get_internal_nodecl()) != it->second)
+                return false;
+        }
+        return true;
+    }
+
+    bool AnalysisManager::is_in_translation_unit(const NBase& n) const
+    {
+        NBase current = n;
+        while (!current.get_parent().is_null())
+            current = current.get_parent();
+        return current == _top_level;
+    }
+
+    ObjectList<ExtensibleGraph*> AnalysisManager::get_callee_pcfgs(
+            const ObjectList<ExtensibleGraph*>& pcfgs,
+            bool is_ompss_enabled,
+            Modification_counts& callee_functions)
+    {
+        ObjectList<ExtensibleGraph*> result;
+        for (ObjectList<ExtensibleGraph*>::const_iterator it = pcfgs.begin(); it != pcfgs.end(); ++it)
+        {
+            Symbol func_sym = (*it)->get_function_symbol();
+            ObjectList<Symbol> called_funcs = (*it)->get_function_calls();
+            for (ObjectList<Symbol>::iterator itf = called_funcs.begin(); itf != called_funcs.end(); ++itf)
+            {
+                // Recursive calls are handled by the analysis of the function itself
+                if (*itf == func_sym)
+                    continue;
+
+                NBase func_code = itf->get_function_code();
+                if (func_code.is_null())     // The code of the function is not reachable
+                    continue;
+                if (_analyses.find(std::make_pair(func_code, is_ompss_enabled)) == _analyses.end()
+                        && !is_in_translation_unit(func_code))
+                    continue;
+
+                // A callee being computed (the call graph has a cycle) has only its PCFG yet,
+                // as it happens when analyzing the whole TopLevel at once
+                AnalysisEntry& callee = get_function_analysis(func_code, WhichAnalysis::USAGE_ANALYSIS, is_ompss_enabled);
+                const ObjectList<ExtensibleGraph*>& callee_pcfgs = get_function_pcfgs(*callee._analysis, func_code);
+                result.insert(callee_pcfgs);
+
+                const Modification_counts& counts = get_modification_counts(callee_pcfgs);
+                callee_functions.insert(callee_functions.end(), counts.begin(), counts.end());
+                callee_functions.insert(callee_functions.end(), callee._functions.begin(), callee._functions.end());
+            }
+        }
+        return result;
+    }
+
+    AnalysisManager::AnalysisEntry& AnalysisManager::get_function_analysis(
+            const NBase& func,
+            WhichAnalysis analysis_mask,
+            bool is_ompss_enabled)
+    {
+        std::pair<NBase, bool> key(func, is_ompss_enabled);
+        Nodecl_to_analysis_map::iterator it = _analyses.find(key);
+        if (it != _analyses.end()
+                && !it->second._in_progress
+                && !is_up_to_date(it->second._functions))
+        {
+            if (VERBOSE)
+                std::cerr << "Analyses of '" << func.get_locus_str() << "' are out of date" << std::endl;
+            delete it->second._analysis;
+            _analyses.erase(it);
+            it = _analyses.end();
+        }
+
+        if (it == _analyses.end())
+        {
+            // The functions it calls are found by get_callee_pcfgs, so the function is analyzed alone
+            it = _analyses.insert(
+                    std::make_pair(key, AnalysisEntry(new AnalysisBase(is_ompss_enabled), func))).first;
+        }
+
+        AnalysisEntry& entry = it->second;
+        int missing = analysis_mask._which_analysis & ~entry._computed._which_analysis;
+        if (missing == WhichAnalysis::NONE
+                || entry._in_progress)
+            return entry;
+        entry._in_progress = true;
+
+        // Only the PCFG of the function itself is built, the functions it calls are
+        // analyzed in their own entries
+        AnalysisBase& analysis = *entry._analysis;
+        const NBase& ast = entry._analyzed_ast;
+        analysis.parallel_control_flow_graph(ast);
+        if ((missing & ~WhichAnalysis::PCFG_ANALYSIS)
+                && (entry._computed._which_analysis & ~WhichAnalysis::PCFG_ANALYSIS) == WhichAnalysis::NONE)
+        {
+            analysis.set_callee_pcfgs(
+                    get_callee_pcfgs(analysis.get_pcfgs(), is_ompss_enabled, entry._callee_functions));
+        }
+
+        // Do it in such an order that the first is the most complete analysis and the last is the simplest one
+        if (missing & WhichAnalysis::AUTO_SCOPING)
+            analysis.auto_scoping(ast);
+        if (missing & WhichAnalysis::RANGE_ANALYSIS)
+            analysis.range_analysis(ast);
+        if (missing & WhichAnalysis::REACHING_DEFS_ANALYSIS)
+            analysis.reaching_definitions(ast, /*propagate_graph_nodes*/ true);
+        if (missing & WhichAnalysis::INDUCTION_VARS_ANALYSIS)
+            analysis.induction_variables(ast, /*propagate_graph_nodes*/ true);
+        if (missing & WhichAnalysis::LIVENESS_ANALYSIS)
+            analysis.liveness(ast, /*propagate_graph_nodes*/ true);
+        if (missing & (WhichAnalysis::USAGE_ANALYSIS | WhichAnalysis::CONSTANTS_ANALYSIS))
+            analysis.use_def(ast, /*propagate_graph_nodes*/ true);
+
+        entry._computed = entry._computed | analysis_mask;
+        // Taken after computing, in case the analyses modified the tree
+        entry._functions = get_modification_counts(analysis.get_pcfgs());
+        entry._functions.insert(entry._functions.end(),
+                entry._callee_functions.begin(), entry._callee_functions.end());
+        entry._in_progress = false;
+
+        return entry;
+    }
+
+    ObjectList<ExtensibleGraph*> AnalysisManager::get_pcfgs(
+            const NBase& ast,
+            WhichAnalysis analysis_mask,
+            bool is_ompss_enabled)
+    {
+        // Analyses of previous translation units are of no use
+        if (CURRENT_COMPILED_FILE->compilation_id != _compilation_id)
+        {
+            clear();
+            _top_level = CURRENT_COMPILED_FILE->nodecl;
+            _compilation_id = CURRENT_COMPILED_FILE->compilation_id;
+        }
+
+        ObjectList<ExtensibleGraph*> result;
+        const ObjectList<NBase>& functions = get_functions(ast);
+        for (ObjectList<NBase>::const_iterator it = functions.begin(); it != functions.end(); ++it)
+        {
+            AnalysisEntry& entry = get_function_analysis(*it, analysis_mask, is_ompss_enabled);
+            result.append(get_function_pcfgs(*entry._analysis, *it));
+        }
+        return result;
+    }
+
+    void AnalysisManager::clear()
+    {
+        for (Nodecl_to_analysis_map::iterator it = _analyses.begin(); it != _analyses.end(); ++it)
+            delete it->second._analysis;
+        _analyses.clear();
+    }
+
+    void AnalysisManager::print_pcfgs(const NBase& ast, bool is_ompss_enabled)
+    {
+        const ObjectList<NBase>& functions = get_functions(ast);
+        for (ObjectList<NBase>::const_iterator it = functions.begin(); it != functions.end(); ++it)
+        {
+            Nodecl_to_analysis_map::iterator ita = _analyses.find(std::make_pair(*it, is_ompss_enabled));
+            if (ita == _analyses.end())
+                continue;
+
+            AnalysisBase& analysis = *ita->second._analysis;
+            const ObjectList<ExtensibleGraph*>& pcfgs = get_function_pcfgs(analysis, *it);
+            for (ObjectList<ExtensibleGraph*>::const_iterator itp = pcfgs.begin(); itp != pcfgs.end(); ++itp)
+                analysis.print_pcfg((*itp)->get_name());
+        }
+    }
+}
+}
@@ -0,0 +1,156 @@
+/*--------------------------------------------------------------------
+ (C) Copyright 2006-2014 Barcelona Supercomputing Center             *
+ Centro Nacional de Supercomputacion
+
+ This file is part of Mercurium C/C++ source-to-source compiler.
+
+ See AUTHORS file in the top level directory for information
+ regarding developers and contributors.
+
+ This library is free software; you can redistribute it and/or
+ modify it under the terms of the GNU Lesser General Public
+ License as published by the Free Software Foundation; either
+ version 3 of the License, or (at your option) any later version.
+
+ Mercurium C/C++ source-to-source compiler is distributed in the hope
+ that it will be useful, but WITHOUT ANY WARRANTY; without even the
+ implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ PURPOSE.  See the GNU Lesser General Public License for more
+ details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with Mercurium C/C++ source-to-source compiler; if
+ not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+ Cambridge, MA 02139, USA.
+ --------------------------------------------------------------------*/
+
+
+#ifndef TL_ANALYSIS_MANAGER_HPP
+#define TL_ANALYSIS_MANAGER_HPP
+
+#include <map>
+#include <vector>
+
+#include "tl-analysis-base.hpp"
+
+namespace TL {
+namespace Analysis {
+
+    // ************************************************************************************ //
+    // ********** Class keeping the analyses shared among the compiler phases ************* //
+
+    //! This class implements a Meyers Singleton that keeps the analyses computed so far
+    //! over the translation unit being compiled, so different phases can share them
+    /*!
+     * Analyses are kept per function of the translation unit (a FunctionCode, or a
+     * SimdFunction or TaskCall at the top level). The use-def analysis of a FunctionCode
+     * takes the information of the functions it calls from their own analyses, so
+     * interprocedural information is as precise as when analyzing the whole TopLevel at
+     * once but every function is analyzed only once. The results for a TopLevel are
+     * assembled from the analyses of each of its functions.
+     *
+     * Every analysis records the modification count of the functions it covers (the
+     * function itself and the functions it calls, directly or not). It is discarded and
+     * computed again when any of these functions has been modified, so modifying a
+     * function only invalidates the analyses of that function and of those calling it.
+     * Modifications outside the functions (e.g., the initializer of a global variable)
+     * are not taken into account.
+     */
+    class LIBTL_CLASS AnalysisManager
+    {
+    private:
+
+        // ************** Private attributes ************** //
+        typedef std::vector<std::pair<NBase, unsigned int> > Modification_counts;
+
+        struct AnalysisEntry
+        {
+            AnalysisBase* _analysis;
+            NBase _analyzed_ast;                    //!<Nodecl passed to the analyses
+            WhichAnalysis _computed;                //!<Analyses computed so far
+            Modification_counts _functions;         //!<Modification count of the analyzed functions
+            Modification_counts _callee_functions;  //!<Modification count of the callees whose analyses are used
+            bool _in_progress;                      //!<True while computing, for recursive calls
+
+            AnalysisEntry(AnalysisBase* analysis, const NBase& analyzed_ast);
+        };
+
+        //! Analyses are different for OmpSs and OpenMP, so the mode is part of the key
+        typedef std::map<std::pair<NBase, bool>, AnalysisEntry> Nodecl_to_analysis_map;
+
+        Nodecl_to_analysis_map _analyses;
+        NBase _top_level;                           //!<Translation unit the analyses belong to
+        unsigned int _compilation_id;               //!<Compilation id of that translation unit
+
+        // *************** Private methods **************** //
+
+        //!Returns the modification count of the functions analyzed in \pcfgs
+        static Modification_counts get_modification_counts(const ObjectList<ExtensibleGraph*>& pcfgs);
+
+        //!Returns true when none of the functions in \functions has been modified
+        static bool is_up_to_date(const Modification_counts& functions);
+
+        //!Returns true when \n belongs to the tree of the translation unit of the analyses
+        bool is_in_translation_unit(const NBase& n) const;
+
+        //!Returns the PCFGs of the functions called from \pcfgs, with use-def computed unless they are being computed
+        //!Their modification counts are appended to \callee_functions
+        ObjectList<ExtensibleGraph*> get_callee_pcfgs(
+                const ObjectList<ExtensibleGraph*>& pcfgs,
+                bool is_ompss_enabled,
+                Modification_counts& callee_functions);
+
+        //!Returns the analyses of the function \func, computing first those in \analysis_mask not computed yet
+        AnalysisEntry& get_function_analysis(
+                const NBase& func,
+                WhichAnalysis analysis_mask,
+                bool is_ompss_enabled);
+
+        //!Only get_manager creates the manager
+        AnalysisManager();
+
+        //!Prevents copy construction.
+        AnalysisManager(const AnalysisManager& manager){};
+
+        //!Prevents assignment.
+        void operator=(const AnalysisManager& manager){};
+
+    public:
+
+        // *** Getters *** //
+
+        //!Returns the only instance of the manager
+        static AnalysisManager& get_manager();
+
+        /*!Returns the PCFGs of the functions in \ast, computing first the analyses in \analysis_mask
+         * that are not computed yet
+         * Analyses are computed propagating the information to the graph nodes
+         * The returned PCFGs may be discarded by a later call to this method, so do not keep them
+         * \param ast FunctionCode or TopLevel to be analyzed
+         * \param analysis_mask Analyses required
+         * \param is_ompss_enabled True when the analyses must be computed in OmpSs mode
+         */
+        ObjectList<ExtensibleGraph*> get_pcfgs(
+                const NBase& ast,
+                WhichAnalysis analysis_mask,
+                bool is_ompss_enabled);
+
+        // *** Modifiers *** //
+
+        //!Discards all the analyses computed so far
+        void clear();
+
+        // *** Utils *** //
+
+        //!Prints to dot files the PCFGs returned by get_pcfgs for the same arguments
+        void print_pcfgs(const NBase& ast, bool is_ompss_enabled);
+
+        ~AnalysisManager();
+    };
+
+    // ******** END class keeping the analyses shared among the compiler phases *********** //
+    // ************************************************************************************ //
+}
+}
+
+#endif      // TL_ANALYSIS_MANAGER_HPP
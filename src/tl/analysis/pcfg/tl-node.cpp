@@ -43,7 +43,8 @@ namespace Analysis {
     Node::Node(unsigned int& id, NodeType type, Node* outer_node)
             : _id(++id), _num(), _type(type), _outer_node(outer_node),
               _entry_edges(), _exit_edges(), _has_assertion(false),
-              _visited(false), _visited_aux(false), _visited_extgraph(false), _visited_extgraph_aux(false)
+              _visited(false), _visited_aux(false), _visited_extgraph(false), _visited_extgraph_aux(false),
+              _present_var_sets(0)
     {
         if (type == __Graph)
         {
@@ -56,7 +57,8 @@ namespace Analysis {
     Node::Node(unsigned int& id, NodeType type, Node* outer_node, const NodeclList& nodecls)
             : _id(++id), _num(),_type(type), _outer_node(outer_node),
               _entry_edges(), _exit_edges(), _has_assertion(false),
-              _visited(false), _visited_aux(false), _visited_extgraph(false), _visited_extgraph_aux(false)
+              _visited(false), _visited_aux(false), _visited_extgraph(false), _visited_extgraph_aux(false),
+              _present_var_sets(0)
     {
         set_data(_NODE_STMTS, nodecls);
     }
@@ -64,7 +66,8 @@ namespace Analysis {
     Node::Node(unsigned int& id, NodeType type, Node* outer_node, const NBase& nodecl)
             : _id(++id), _num(),_type(type), _outer_node(outer_node),
               _entry_edges(), _exit_edges(), _has_assertion(false),
-              _visited(false), _visited_aux(false), _visited_extgraph(false), _visited_extgraph_aux(false)
+              _visited(false), _visited_aux(false), _visited_extgraph(false), _visited_extgraph_aux(false),
+              _present_var_sets(0)
     {
         set_data(_NODE_STMTS, NodeclList(1, nodecl));
     }
@@ -82,6 +85,13 @@ namespace Analysis {
         return (_id == node._id);
     }
 
+    bool Node::has_key(const int key) const
+    {
+        if (is_var_set(key))
+            return (_present_var_sets & (1U << (key - _UPPER_EXPOSED))) != 0;
+        return LinkData::has_key(key);
+    }
+
     unsigned int Node::get_id() const
     {
         return _id;
@@ -1244,11 +1254,38 @@ namespace Analysis {
     // ****************************************************************************** //
     // ****************************** Private methods ******************************* //
 
+    bool Node::is_var_set(int attr)
+    {
+        return (attr >= _UPPER_EXPOSED && attr <= _LIVE_OUT);
+    }
+
+    NodeclSet& Node::get_var_set(PCFGAttribute attr)
+    {
+        ERROR_CONDITION(!is_var_set(attr), "Attribute %d is not a use-definition or liveness set", attr);
+
+        _present_var_sets |= (1U << (attr - _UPPER_EXPOSED));
+        return _var_sets[attr - _UPPER_EXPOSED];
+    }
+
+    template <typename T>
+    T& Node::get_container(PCFGAttribute attr)
+    {
+        return get_data<T>(attr);
+    }
+
+    template <>
+    NodeclSet& Node::get_container<NodeclSet>(PCFGAttribute attr)
+    {
+        if (is_var_set(attr))
+            return get_var_set(attr);
+        return get_data<NodeclSet>(attr);
+    }
+
     template <typename T>
     T Node::get_vars(PCFGAttribute attr)
     {
         if (has_key(attr))
-            return get_data<T>(attr);
+            return get_container<T>(attr);
 
         return T();
     }
@@ -1256,7 +1293,7 @@ namespace Analysis {
     template <typename T>
     void Node::add_var_to_container(const NBase& var, PCFGAttribute attr)
     {
-        T& c = get_data<T>(attr);
+        T& c = get_container<T>(attr);
         if (Utils::nodecl_set_contains_enclosing_nodecl(var, c).is_null())
         {
             const Nodecl::List& subparts = Utils::nodecl_set_contains_enclosed_nodecl(var, c);
@@ -1275,7 +1312,7 @@ namespace Analysis {
     {
         if (vars.empty())
         {   // ensure that, in case no attribute called #attr was attached to the node, now it will be attached
-            /*T& c = */get_data<T>(attr);
+            /*T& c = */get_container<T>(attr);
         }
         else
         {
@@ -1311,7 +1348,7 @@ namespace Analysis {
 
     void Node::remove_var_from_set(const NBase& var, PCFGAttribute attr)
     {
-        get_data<NodeclSet>(attr);
+        get_container<NodeclSet>(attr);
     }
 
     // **************************** END private methods ***************************** //
@@ -1325,7 +1362,7 @@ namespace Analysis {
     // **** Upwards exposed *** //
     NodeclSet& Node::get_ue_vars()
     {
-        return get_data<NodeclSet>(_UPPER_EXPOSED);
+        return get_var_set(_UPPER_EXPOSED);
     }
 
     void Node::add_ue_var(const NBase& new_ue_var)
@@ -1340,7 +1377,7 @@ namespace Analysis {
 
     void Node::set_ue_var(const NodeclSet& new_ue_vars)
     {
-        set_data(_UPPER_EXPOSED, new_ue_vars);
+        get_var_set(_UPPER_EXPOSED) = new_ue_vars;
     }
     
     void Node::remove_ue_var(const NBase& old_ue_var)
@@ -1350,7 +1387,7 @@ namespace Analysis {
 
     NodeclSet& Node::get_private_ue_vars()
     {
-        return get_data<NodeclSet>(_PRIVATE_UPPER_EXPOSED);
+        return get_var_set(_PRIVATE_UPPER_EXPOSED);
     }
 
     void Node::add_private_ue_var(const NodeclSet& new_private_ue_vars)
@@ -1360,13 +1397,13 @@ namespace Analysis {
 
     void Node::set_private_ue_var(const NodeclSet& new_private_ue_vars)
     {
-        set_data(_PRIVATE_UPPER_EXPOSED, new_private_ue_vars);
+        get_var_set(_PRIVATE_UPPER_EXPOSED) = new_private_ue_vars;
     }
 
     // **** Killed *** //
     NodeclSet& Node::get_killed_vars()
     {
-        return get_data<NodeclSet>(_KILLED);
+        return get_var_set(_KILLED);
     }
 
     void Node::add_killed_var(const NBase& new_killed_var)
@@ -1381,7 +1418,7 @@ namespace Analysis {
 
     void Node::set_killed_var(const NodeclSet& new_killed_vars)
     {
-        set_data(_KILLED, new_killed_vars);
+        get_var_set(_KILLED) = new_killed_vars;
     }
     
     void Node::remove_killed_var(const NBase& old_killed_var)
@@ -1391,7 +1428,7 @@ namespace Analysis {
 
     NodeclSet& Node::get_private_killed_vars()
     {
-        return get_data<NodeclSet>(_PRIVATE_KILLED);
+        return get_var_set(_PRIVATE_KILLED);
     }
     
     void Node::add_private_killed_var(const NodeclSet& new_private_killed_vars)
@@ -1401,13 +1438,13 @@ namespace Analysis {
         
     void Node::set_private_killed_var(const NodeclSet& new_private_killed_vars)
     {
-        set_data(_PRIVATE_KILLED, new_private_killed_vars);
+        get_var_set(_PRIVATE_KILLED) = new_private_killed_vars;
     }
 
     // **** Undefined behavior *** //
     NodeclSet& Node::get_undefined_behaviour_vars()
     {
-        return get_data<NodeclSet>(_UNDEF);
+        return get_var_set(_UNDEF);
     }
 
     void Node::add_undefined_behaviour_var(const NBase& new_undef_var)
@@ -1430,7 +1467,7 @@ namespace Analysis {
 
     void Node::set_undefined_behaviour_var(const NodeclSet& new_undef_vars)
     {
-        set_data(_UNDEF, new_undef_vars);
+        get_var_set(_UNDEF) = new_undef_vars;
     }
 
     void Node::remove_undefined_behaviour_var(const NBase& old_undef_var)
@@ -1440,7 +1477,7 @@ namespace Analysis {
 
     NodeclSet& Node::get_private_undefined_behaviour_vars()
     {
-        return get_data<NodeclSet>(_PRIVATE_UNDEF);
+        return get_var_set(_PRIVATE_UNDEF);
     }
 
     void Node::add_private_undefined_behaviour_var(const NodeclSet& new_private_undef_vars)
@@ -1450,23 +1487,23 @@ namespace Analysis {
 
     void Node::set_private_undefined_behaviour_var(const NodeclSet& new_private_undef_vars)
     {
-        set_data(_PRIVATE_UNDEF, new_private_undef_vars);
+        get_var_set(_PRIVATE_UNDEF) = new_private_undef_vars;
     }
 
     // *** Used addresses *** //
     NodeclSet& Node::get_used_addresses()
     {
-        return get_data<NodeclSet>(_USED_ADDRESSES);
+        return get_var_set(_USED_ADDRESSES);
     }
 
     void Node::add_used_address(const NBase& es)
     {
-        get_data<NodeclSet>(_USED_ADDRESSES).insert(es);
+        get_var_set(_USED_ADDRESSES).insert(es);
     }
 
     void Node::set_used_addresses(const NodeclSet& used_addresses)
     {
-        set_data(_USED_ADDRESSES, used_addresses);
+        get_var_set(_USED_ADDRESSES) = used_addresses;
     }
 
     // ************* END getters and setters for use-definition analysis ************ //
@@ -1479,22 +1516,22 @@ namespace Analysis {
 
     NodeclSet& Node::get_live_in_vars()
     {
-        return get_data<NodeclSet>(_LIVE_IN);
+        return get_var_set(_LIVE_IN);
     }
 
     void Node::set_live_in(const NBase& new_live_in_var)
     {
-        get_data<NodeclSet>(_LIVE_IN).insert(new_live_in_var);
+        get_var_set(_LIVE_IN).insert(new_live_in_var);
     }
 
     void Node::set_live_in(const NodeclSet& new_live_in_set)
     {
-        set_data(_LIVE_IN, new_live_in_set);
+        get_var_set(_LIVE_IN) = new_live_in_set;
     }
 
     NodeclSet& Node::get_live_out_vars()
     {
-        return get_data<NodeclSet>(_LIVE_OUT);
+        return get_var_set(_LIVE_OUT);
     }
 
     void Node::add_live_out(const NodeclSet& new_live_out_set)
@@ -1504,12 +1541,12 @@ namespace Analysis {
     
     void Node::set_live_out(const NBase& new_live_out_var)
     {
-        get_data<NodeclSet>(_LIVE_OUT).insert(new_live_out_var);
+        get_var_set(_LIVE_OUT).insert(new_live_out_var);
     }
 
     void Node::set_live_out(const NodeclSet& new_live_out_set)
     {
-        set_data(_LIVE_OUT, new_live_out_set);
+        get_var_set(_LIVE_OUT) = new_live_out_set;
     }
 
     // **************** END getters and setters for liveness analysis *************** //
@@ -2566,13 +2603,13 @@ namespace Analysis {
     {
         if (VERBOSE)
         {
-            NodeclSet ue_vars = get_data<NodeclSet>(_UPPER_EXPOSED);
+            NodeclSet ue_vars = get_var_set(_UPPER_EXPOSED);
             std::cerr << " - Upper Exposed: " << print_set(ue_vars) << std::endl;
 
-            NodeclSet killed_vars = get_data<NodeclSet>(_KILLED);
+            NodeclSet killed_vars = get_var_set(_KILLED);
             std::cerr << " - Killed: " << print_set(killed_vars);
 
-            NodeclSet undef_vars = get_data<NodeclSet>(_UNDEF);
+            NodeclSet undef_vars = get_var_set(_UNDEF);
             std::cerr << " - Undefined usage: " << print_set(undef_vars);
         }
     }
@@ -2581,10 +2618,10 @@ namespace Analysis {
     {
         if (VERBOSE)
         {
-            NodeclSet live_in_vars = get_data<NodeclSet>(_LIVE_IN);
+            NodeclSet live_in_vars = get_var_set(_LIVE_IN);
             std::cerr << " - Live in: " << print_set(live_in_vars) << std::endl;
 
-            NodeclSet live_out_vars = get_data<NodeclSet>(_LIVE_OUT);
+            NodeclSet live_out_vars = get_var_set(_LIVE_OUT);
             std::cerr << " - Live out: " << print_set(live_out_vars) << std::endl;
         }
     }
@@ -61,11 +61,26 @@ namespace Analysis {
                                         // to avoid interfering with other traversals
             bool _visited_extgraph_aux;
 
+            // *** Use-definition and liveness sets *** //
+            // These are the most used attributes of a node, so they are not
+            // linked as LinkData but kept here and accessed directly.
+            // has_key is overridden to check their presence
+            NodeclSet _var_sets[_LIVE_OUT - _UPPER_EXPOSED + 1];
+            unsigned int _present_var_sets;
+            static_assert(_LIVE_OUT - _UPPER_EXPOSED + 1 <= sizeof(unsigned int) * 8,
+                    "_present_var_sets has one bit per attribute from _UPPER_EXPOSED to _LIVE_OUT");
+
             // *** Not allowed construction methods *** //
             Node(const Node& n);
             Node& operator=(const Node&);
 
             // *** Private methods for NodeclSet/NodeclMap/ObjectList linked data *** //
+            static bool is_var_set(int attr);
+            NodeclSet& get_var_set(PCFGAttribute attr);
+
+            template <typename T>
+            T& get_container(PCFGAttribute attr);
+
             template <typename T>
             T get_vars(PCFGAttribute attr);
 
@@ -119,6 +134,9 @@ namespace Analysis {
 
             bool operator==(const Node& node) const;
 
+            //! Returns true when the node has the attribute \p key
+            virtual bool has_key(const int key) const;
+
             //! Returns the node identifier
             unsigned int get_id() const;
 
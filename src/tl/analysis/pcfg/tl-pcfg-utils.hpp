@@ -335,6 +335,10 @@ namespace Analysis {
         // UseDef attributes
         ////////////////////
 
+        // Every attribute from _UPPER_EXPOSED to _LIVE_OUT is a NodeclSet kept as a
+        // member of Node (see Node::get_var_set), not as LinkData. Only add NodeclSet
+        // attributes to this range and keep _UPPER_EXPOSED and _LIVE_OUT at its ends
+
         /*! \def _UPPER_EXPOSED
         * Set of upper exposed variables within a node.
         * Available in all nodes (Mandatory once the UseDef analysis is performed).
@@ -392,6 +396,7 @@ namespace Analysis {
         * Available in all nodes (Mandatory once the Liveness analysis is performed).
         */
         _LIVE_OUT,
+        // End of the NodeclSet attributes kept as members of Node
 
 
         // Reaching definitions attributes
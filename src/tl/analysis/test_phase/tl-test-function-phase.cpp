@@ -0,0 +1,242 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2014 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+
+  This file is part of Mercurium C/C++ source-to-source compiler.
+
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+// --------------------------------------------------------------------*/
+
+#include "tl-test-function-phase.hpp"
+#include "tl-analysis-manager.hpp"
+#include "tl-nodecl-visitor.hpp"
+#include "cxx-utils.h"
+
+#include <set>
+
+namespace TL {
+
+namespace {
+    //!Collects the functions directly nested in a function
+    struct NestedFunctionsVisitor : public Nodecl::ExhaustiveVisitor<void>
+    {
+        ObjectList<Nodecl::FunctionCode> functions;
+
+        virtual void visit(const Nodecl::FunctionCode& n)
+        {
+            functions.append(n);
+        }
+    };
+}
+
+    TestFunctionPhase::TestFunctionPhase()
+            : _functions(), _num_commits(0),
+              _analysis_manager_enabled_str(""), _analysis_manager_enabled(false),
+              _pcfgs()
+    {
+        set_phase_name("Phase for testing function compiler phases");
+        set_phase_description("This phase checks that every function is handled and that commit is run once.");
+
+        register_parameter("analysis_manager_enabled",
+                           "If set to '1' checks the analyses shared through the analysis manager, otherwise it is disabled",
+                           _analysis_manager_enabled_str,
+                           "0").connect(std::bind(&TestFunctionPhase::set_analysis_manager, this, std::placeholders::_1));
+    }
+
+    void TestFunctionPhase::run(TL::DTO& dto)
+    {
+        _functions.clear();
+        _pcfgs.clear();
+        _num_commits = 0;
+
+        FunctionCompilerPhase::run(dto);
+
+        ERROR_CONDITION(_num_commits != 1,
+                "Commit has been run %d times instead of once", _num_commits);
+    }
+
+    void TestFunctionPhase::run_on_function(const Nodecl::FunctionCode& function_code, TL::DTO& dto)
+    {
+        ERROR_CONDITION(_num_commits != 0,
+                "Function '%s' handled after commit",
+                function_code.get_symbol().get_name().c_str());
+
+        _functions.append(function_code);
+
+        if (_analysis_manager_enabled)
+        {
+            Analysis::AnalysisManager& manager = Analysis::AnalysisManager::get_manager();
+            ObjectList<Analysis::ExtensibleGraph*> pcfgs = manager.get_pcfgs(
+                    function_code, Analysis::WhichAnalysis::PCFG_ANALYSIS, /*is_ompss_enabled*/ false);
+            ERROR_CONDITION(pcfgs.size() != 1,
+                    "Function '%s' has %d PCFGs instead of one",
+                    function_code.get_symbol().get_name().c_str(), (int)pcfgs.size());
+
+            // The function has not changed, so asking for more analyses extends the same ones
+            ObjectList<Analysis::ExtensibleGraph*> pcfgs_use_def = manager.get_pcfgs(
+                    function_code, Analysis::WhichAnalysis::USAGE_ANALYSIS, /*is_ompss_enabled*/ false);
+            ERROR_CONDITION(pcfgs_use_def != pcfgs,
+                    "Analyses of function '%s' have not been reused",
+                    function_code.get_symbol().get_name().c_str());
+
+            _pcfgs.append(pcfgs);
+        }
+    }
+
+    void TestFunctionPhase::commit(TL::DTO& dto)
+    {
+        _num_commits++;
+
+        Nodecl::NodeclBase top_level = *std::static_pointer_cast<Nodecl::NodeclBase>(dto["nodecl"]);
+
+        // Every function of the translation unit has been handled once and in order
+        ObjectList<Nodecl::FunctionCode>::iterator it_handled = _functions.begin();
+        Nodecl::List top_level_items = top_level.as<Nodecl::TopLevel>().get_top_level().as<Nodecl::List>();
+        for (Nodecl::List::iterator it = top_level_items.begin(); it != top_level_items.end(); ++it)
+        {
+            if (!it->is<Nodecl::FunctionCode>())
+                continue;
+
+            ERROR_CONDITION(it_handled == _functions.end() || *it_handled != *it,
+                    "Function '%s' has not been handled",
+                    it->get_symbol().get_name().c_str());
+            ++it_handled;
+        }
+        ERROR_CONDITION(it_handled != _functions.end(),
+                "Function '%s' has been handled but it is not in the translation unit",
+                it_handled->get_symbol().get_name().c_str());
+
+        check_nested_functions();
+
+        if (_analysis_manager_enabled)
+            check_analysis_manager(top_level);
+    }
+
+    void TestFunctionPhase::check_nested_functions()
+    {
+        for (ObjectList<Nodecl::FunctionCode>::iterator it = _functions.begin(); it != _functions.end(); ++it)
+        {
+            NestedFunctionsVisitor nested_visitor;
+            nested_visitor.walk(it->get_statements());
+            for (ObjectList<Nodecl::FunctionCode>::iterator itn = nested_visitor.functions.begin();
+                    itn != nested_visitor.functions.end(); ++itn)
+            {
+                unsigned int modification_count = nodecl_get_modification_count(it->get_internal_nodecl());
+
+                Nodecl::NodeclBase statements = itn->get_statements();
+                statements.replace(statements.shallow_copy());
+
+                ERROR_CONDITION(nodecl_get_modification_count(it->get_internal_nodecl()) == modification_count,
+                        "Modifying function '%s' has not modified function '%s' containing it",
+                        itn->get_symbol().get_name().c_str(),
+                        it->get_symbol().get_name().c_str());
+            }
+        }
+    }
+
+    void TestFunctionPhase::check_analysis_manager(const Nodecl::NodeclBase& top_level)
+    {
+        Analysis::AnalysisManager& manager = Analysis::AnalysisManager::get_manager();
+
+        // The analyses of the whole translation unit are those of its functions
+        ObjectList<Analysis::ExtensibleGraph*> pcfgs = manager.get_pcfgs(
+                top_level, Analysis::WhichAnalysis::USAGE_ANALYSIS, /*is_ompss_enabled*/ false);
+        ERROR_CONDITION(pcfgs != _pcfgs,
+                "Analyses of the translation unit have not been assembled from those of its functions", 0);
+
+        if (_functions.empty())
+            return;
+
+        // Modify the last function, which is not called by the others
+        Nodecl::NodeclBase statements = _functions.back().get_statements();
+        statements.replace(statements.shallow_copy());
+
+        pcfgs = manager.get_pcfgs(
+                top_level, Analysis::WhichAnalysis::USAGE_ANALYSIS, /*is_ompss_enabled*/ false);
+        ERROR_CONDITION(pcfgs.size() != _pcfgs.size(),
+                "The number of PCFGs has changed after modifying function '%s'",
+                _functions.back().get_symbol().get_name().c_str());
+        for (unsigned int i = 0; i < _pcfgs.size(); ++i)
+        {
+            bool is_modified = (i == _pcfgs.size() - 1);
+            ERROR_CONDITION(is_modified && pcfgs[i] == _pcfgs[i],
+                    "Analyses of function '%s' have not been discarded after modifying it",
+                    _functions[i].get_symbol().get_name().c_str());
+            ERROR_CONDITION(!is_modified && pcfgs[i] != _pcfgs[i],
+                    "Analyses of function '%s' have been discarded after modifying function '%s'",
+                    _functions[i].get_symbol().get_name().c_str(),
+                    _functions.back().get_symbol().get_name().c_str());
+        }
+
+        // Modify the first function, the functions calling it, directly or not, use its analyses
+        std::set<Symbol> affected;
+        affected.insert(_functions.front().get_symbol());
+        bool changed = true;
+        while (changed)
+        {
+            changed = false;
+            for (ObjectList<Analysis::ExtensibleGraph*>::iterator it = pcfgs.begin(); it != pcfgs.end(); ++it)
+            {
+                if (affected.find((*it)->get_function_symbol()) != affected.end())
+                    continue;
+
+                ObjectList<Symbol> called_funcs = (*it)->get_function_calls();
+                for (ObjectList<Symbol>::iterator itf = called_funcs.begin(); itf != called_funcs.end(); ++itf)
+                {
+                    if (affected.find(*itf) != affected.end())
+                    {
+                        affected.insert((*it)->get_function_symbol());
+                        changed = true;
+                        break;
+                    }
+                }
+            }
+        }
+
+        statements = _functions.front().get_statements();
+        statements.replace(statements.shallow_copy());
+
+        ObjectList<Analysis::ExtensibleGraph*> pcfgs_after = manager.get_pcfgs(
+                top_level, Analysis::WhichAnalysis::USAGE_ANALYSIS, /*is_ompss_enabled*/ false);
+        ERROR_CONDITION(pcfgs_after.size() != pcfgs.size(),
+                "The number of PCFGs has changed after modifying function '%s'",
+                _functions.front().get_symbol().get_name().c_str());
+        for (unsigned int i = 0; i < pcfgs.size(); ++i)
+        {
+            bool is_affected = (affected.find(_functions[i].get_symbol()) != affected.end());
+            ERROR_CONDITION(is_affected && pcfgs_after[i] == pcfgs[i],
+                    "Analyses of function '%s' have not been discarded after modifying function '%s'",
+                    _functions[i].get_symbol().get_name().c_str(),
+                    _functions.front().get_symbol().get_name().c_str());
+            ERROR_CONDITION(!is_affected && pcfgs_after[i] != pcfgs[i],
+                    "Analyses of function '%s' have been discarded after modifying function '%s'",
+                    _functions[i].get_symbol().get_name().c_str(),
+                    _functions.front().get_symbol().get_name().c_str());
+        }
+    }
+
+    void TestFunctionPhase::set_analysis_manager(const std::string& analysis_manager_enabled_str)
+    {
+        if (analysis_manager_enabled_str == "1")
+            _analysis_manager_enabled = true;
+    }
+}
+
+EXPORT_PHASE(TL::TestFunctionPhase);
@@ -0,0 +1,83 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2014 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+
+  This file is part of Mercurium C/C++ source-to-source compiler.
+
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+
+
+#ifndef TL_TEST_FUNCTION_PHASE_HPP
+#define TL_TEST_FUNCTION_PHASE_HPP
+
+#include "tl-compilerphase.hpp"
+#include "tl-nodecl.hpp"
+
+namespace TL {
+
+namespace Analysis {
+    class ExtensibleGraph;
+}
+
+    //! Phase that allows testing FunctionCompilerPhase
+    /*!
+     * It checks that every function of the translation unit is handed once
+     * to run_on_function and that commit is run once, after all of them.
+     * It also checks that modifying a nested function (e.g., a Fortran internal
+     * subprogram) changes the modification count of the function containing it.
+     *
+     * When analysis_manager_enabled is set, it also checks that the analyses
+     * of the AnalysisManager are reused while the functions are not modified,
+     * and that modifying a function only discards the analyses of that function
+     * and of the functions calling it.
+     */
+    class LIBTL_CLASS TestFunctionPhase : public FunctionCompilerPhase
+    {
+    private:
+        ObjectList<Nodecl::FunctionCode> _functions;    //!<Functions handed to run_on_function
+        int _num_commits;
+
+        std::string _analysis_manager_enabled_str;
+        bool _analysis_manager_enabled;
+        void set_analysis_manager(const std::string& analysis_manager_enabled_str);
+
+        ObjectList<Analysis::ExtensibleGraph*> _pcfgs;  //!<PCFG of each function in _functions
+
+        void check_nested_functions();
+        void check_analysis_manager(const Nodecl::NodeclBase& top_level);
+
+    public:
+        //! Constructor of this phase
+        TestFunctionPhase();
+
+        //!Entry point of the phase
+        virtual void run(TL::DTO& dto);
+
+        virtual void run_on_function(const Nodecl::FunctionCode& function_code, TL::DTO& dto);
+
+        virtual void commit(TL::DTO& dto);
+
+        virtual ~TestFunctionPhase() {};
+    };
+}
+
+#endif  // TL_TEST_FUNCTION_PHASE_HPP
@@ -137,7 +137,7 @@ namespace Analysis {
             const SymToNodeclMap& param_to_arg_map,
             Utils::UsageKind usage_kind)
     {
-        for (NodeclSet::iterator it = called_func_usage.begin(); it != called_func_usage.end(); ++it)
+        for (NodeclSet::const_iterator it = called_func_usage.begin(); it != called_func_usage.end(); ++it)
         {
             NBase n = it->no_conv();
             NBase n_base = Utils::get_nodecl_base(n);
@@ -173,7 +173,7 @@ namespace Analysis {
             const SymToNodeclMap& param_to_arg_map,
             Utils::UsageKind usage_kind)
     {
-        for(NodeclSet::iterator it = called_func_usage.begin(); it != called_func_usage.end(); ++it)
+        for(NodeclSet::const_iterator it = called_func_usage.begin(); it != called_func_usage.end(); ++it)
         {
             NBase n = it->no_conv();
             NBase n_base = Utils::get_nodecl_base(n);
@@ -462,7 +462,7 @@ namespace Analysis {
     {
         // Propagate the upwards exposed variables
         NBase ue_previously_killed_subobject, ue_previously_undef_subobject;
-        for (NodeclSet::iterator it = ue_children.begin(); it != ue_children.end(); ++it)
+        for (NodeclSet::const_iterator it = ue_children.begin(); it != ue_children.end(); ++it)
         {
             NBase n_it = *it;
 
@@ -527,7 +527,7 @@ namespace Analysis {
 
         // Propagate the killed variables
         NBase non_killed_var;
-        for (NodeclSet::iterator it = killed_children.begin(); it != killed_children.end(); ++it)
+        for (NodeclSet::const_iterator it = killed_children.begin(); it != killed_children.end(); ++it)
         {
             NBase n_it = *it;
             if (!Utils::nodecl_set_contains_enclosing_nodecl(n_it, undef_vars).is_null()
@@ -564,7 +564,7 @@ namespace Analysis {
 
         // Propagate the undefined behavior variables of the children
         NBase undef_previously_ue_subobject, undef_previously_killed_subobject;
-        for (NodeclSet::iterator it = undef_children.begin(); it != undef_children.end(); ++it)
+        for (NodeclSet::const_iterator it = undef_children.begin(); it != undef_children.end(); ++it)
         {
             NBase n_it = *it;
             // Variables marked as KILLED cannot be UNDEF
@@ -184,7 +184,7 @@ namespace {
         
         // Initialize global variables usage to NONE (for recursive calls)
         const NodeclSet& global_vars = _graph->get_global_variables();
-        for(NodeclSet::iterator it = global_vars.begin(); it != global_vars.end(); ++it)
+        for(NodeclSet::const_iterator it = global_vars.begin(); it != global_vars.end(); ++it)
         {
             _ipa_modif_vars[*it] = Utils::UsageKind::NONE;
         }
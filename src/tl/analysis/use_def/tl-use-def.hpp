@@ -31,6 +31,7 @@
 #include "tl-extensible-graph.hpp"
 #include "tl-nodecl-calc.hpp"
 #include "tl-nodecl-visitor.hpp"
+#include "tl-nodecl-static-visitor.hpp"
 #include "tl-nodecl-replacer.hpp"
 
 namespace TL {
@@ -100,7 +101,7 @@ namespace Analysis {
 
     //! This Class implements a Visitor that computes the Use-Definition information of a concrete statement
     //! and attaches this information to the Node in a PCFG which the statements belongs to
-    class LIBTL_CLASS UsageVisitor : public Nodecl::ExhaustiveVisitor<void>
+    class LIBTL_CLASS UsageVisitor : public Nodecl::StaticExhaustiveVisitor<UsageVisitor>
     {
     private:
 
@@ -234,6 +235,7 @@ namespace Analysis {
         void compute_statement_usage(NBase st);
 
         // *** Visitors *** //
+        using Nodecl::StaticExhaustiveVisitor<UsageVisitor>::visit;
         Ret unhandled_node(const NBase& n);
         Ret visit(const Nodecl::AddAssignment& n);
         Ret visit(const Nodecl::ArithmeticShrAssignment& n);
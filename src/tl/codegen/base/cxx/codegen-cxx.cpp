@@ -110,6 +110,7 @@ void CxxBase::codegen_cleanup()
     // sources (for example, it happens in ompss transformation). For this
     // reason, we need to restore the codegen status of every symbol.
     _codegen_status.clear();
+    _emitted_system_includes.clear();
 }
 
 void CxxBase::handle_parameter(int n, void* data)
@@ -4355,7 +4356,27 @@ CxxBase::Ret CxxBase::visit(const Nodecl::Throw& node)
 
 CxxBase::Ret CxxBase::visit(const Nodecl::TopLevel& node)
 {
-    walk(node.get_top_level());
+    if (!CURRENT_CONFIGURATION->include_system_headers)
+    {
+        walk(node.get_top_level());
+        return;
+    }
+
+    Nodecl::List top_level = node.get_top_level().as<Nodecl::List>();
+    for (Nodecl::List::iterator it = top_level.begin();
+            it != top_level.end();
+            it++)
+    {
+        // Definitions that come from a system header are replaced by its
+        // #include
+        TL::Symbol sym = it->get_symbol();
+        if (sym.is_valid()
+                && get_system_include(it->get_locus()) != NULL
+                && emit_system_include_of_symbol(sym))
+            continue;
+
+        walk(*it);
+    }
 }
 
 CxxBase::Ret CxxBase::visit(const Nodecl::TryBlock& node)
@@ -6804,6 +6825,9 @@ void CxxBase::do_define_symbol(TL::Symbol symbol,
     if (!symbol.is_user_declared())
         return;
 
+    if (emit_system_include_of_symbol(symbol))
+        return;
+
     emit_line_marker(symbol.get_locus());
 
     if (symbol.is_variable())
@@ -7021,6 +7045,9 @@ void CxxBase::do_declare_symbol(TL::Symbol symbol,
     if (state.must_be_object_init.find(symbol) != state.must_be_object_init.end())
         return;
 
+    if (emit_system_include_of_symbol(symbol))
+        return;
+
     if (symbol.is_variable())
     {
         define_or_declare_variable(symbol, /* is definition */ false);
@@ -8087,6 +8114,205 @@ void CxxBase::walk_type_for_symbols(TL::Type t,
 #undef return
 }
 
+top_level_include_t* CxxBase::get_system_include(const locus_t* locus)
+{
+    if (CURRENT_COMPILED_FILE == NULL
+            || CURRENT_COMPILED_FILE->top_level_include_of_file == NULL
+            || locus == NULL
+            || locus_get_filename(locus) == NULL)
+        return NULL;
+
+    top_level_include_t* top_level_include = (top_level_include_t*)dhash_ptr_query(
+            CURRENT_COMPILED_FILE->top_level_include_of_file,
+            locus_get_filename(locus));
+    if (top_level_include == NULL
+            || !top_level_include->system_include)
+        return NULL;
+
+    return top_level_include;
+}
+
+bool CxxBase::is_declared_in_system_header(TL::Symbol symbol)
+{
+    return get_system_include(symbol.get_locus()) != NULL;
+}
+
+// Functions and variables first declared in a system header may still be
+// defined in the main file, e.g. wrappers of library functions
+bool CxxBase::is_defined_outside_system_headers(TL::Symbol symbol)
+{
+    if (!symbol.is_defined())
+        return false;
+
+    if (symbol.is_function())
+    {
+        Nodecl::NodeclBase function_code = symbol.get_function_code();
+        return !function_code.is_null()
+            && get_system_include(function_code.get_locus()) == NULL;
+    }
+    else if (symbol.is_variable())
+    {
+        // The locus of a variable is the one of its last declaration
+        return get_system_include(symbol.get_locus()) == NULL
+            || (!symbol.get_value().is_null()
+                    && get_system_include(symbol.get_value().get_locus()) == NULL);
+    }
+
+    return false;
+}
+
+namespace
+{
+    std::size_t combine_fingerprint(std::size_t h, std::size_t v)
+    {
+        return h ^ (v + 0x9e3779b9 + (h << 6) + (h >> 2));
+    }
+
+    std::size_t tree_fingerprint(Nodecl::NodeclBase n)
+    {
+        if (n.is_null())
+            return 0;
+
+        return combine_fingerprint((std::size_t)nodecl_get_ast(n.get_internal_nodecl()),
+                nodecl_get_modification_count(n.get_internal_nodecl()));
+    }
+
+    // Summarizes what a phase may change of a declaration: its type, its
+    // definition and, for classes, its members
+    std::size_t declaration_fingerprint(TL::Symbol symbol)
+    {
+        std::size_t h = (std::size_t)symbol.get_type().get_internal_type();
+        h = combine_fingerprint(h, symbol.is_defined());
+        h = combine_fingerprint(h, tree_fingerprint(symbol.get_function_code()));
+        h = combine_fingerprint(h, tree_fingerprint(symbol.get_value()));
+
+        if (symbol.is_class()
+                && !symbol.get_type().is_incomplete())
+        {
+            TL::ObjectList<TL::Symbol> members = symbol.get_type().get_all_members();
+            h = combine_fingerprint(h, members.size());
+            for (TL::ObjectList<TL::Symbol>::iterator it = members.begin();
+                    it != members.end();
+                    it++)
+            {
+                if (it->is_injected_class_name())
+                    continue;
+                h = combine_fingerprint(h, declaration_fingerprint(*it));
+            }
+        }
+
+        return h;
+    }
+}
+
+void CxxBase::record_system_declarations(TL::Scope sc, std::set<TL::Symbol>& visited)
+{
+    TL::ObjectList<TL::Symbol> symbols = sc.get_all_symbols(/* include_hidden */ false);
+    for (TL::ObjectList<TL::Symbol>::iterator it = symbols.begin();
+            it != symbols.end();
+            it++)
+    {
+        if (!visited.insert(*it).second)
+            continue;
+
+        if (it->is_namespace())
+        {
+            record_system_declarations(it->get_related_scope(), visited);
+        }
+        else if (is_declared_in_system_header(*it))
+        {
+            _system_declarations[*it] = declaration_fingerprint(*it);
+
+            if (it->get_type().is_template_type())
+            {
+                TL::ObjectList<TL::Type> specializations = it->get_type().get_specializations();
+                for (TL::ObjectList<TL::Type>::iterator it_spec = specializations.begin();
+                        it_spec != specializations.end();
+                        it_spec++)
+                {
+                    TL::Symbol specialization = it_spec->get_symbol();
+                    if (specialization.is_valid())
+                        _system_declarations[specialization] = declaration_fingerprint(specialization);
+                }
+            }
+        }
+    }
+}
+
+void CxxBase::pre_phases_execution(TL::DTO& dto)
+{
+    _system_declarations.clear();
+    _system_declarations_file = NULL;
+
+    if (!CURRENT_CONFIGURATION->include_system_headers
+            || CURRENT_COMPILED_FILE == NULL
+            || CURRENT_COMPILED_FILE->top_level_include_of_file == NULL)
+        return;
+
+    std::set<TL::Symbol> visited;
+    record_system_declarations(TL::Scope::get_global_scope(), visited);
+    _system_declarations_file = CURRENT_COMPILED_FILE;
+}
+
+// A declaration of a system header can be replaced by its #include only if
+// no phase has changed it since the semantic analysis
+bool CxxBase::system_declaration_is_unchanged(TL::Symbol symbol)
+{
+    if (_system_declarations_file != CURRENT_COMPILED_FILE)
+        return false;
+
+    std::map<TL::Symbol, std::size_t>::iterator it = _system_declarations.find(symbol);
+    if (it == _system_declarations.end())
+    {
+        // Specializations instantiated by a phase are like their template
+        if (symbol.get_type().is_template_specialized_type())
+        {
+            TL::Symbol template_symbol =
+                symbol.get_type().get_related_template_type().get_related_template_symbol();
+            return (template_symbol.is_valid()
+                    && template_symbol != symbol
+                    && system_declaration_is_unchanged(template_symbol));
+        }
+        // Otherwise it has been created by a phase
+        return false;
+    }
+
+    return it->second == declaration_fingerprint(symbol);
+}
+
+// With --include-system-headers, entities declared in a system header that
+// the main file includes are not printed. Instead the #include of that
+// header, spelled as the preprocessor reported it, is emitted once before
+// its first use. Entities defined in the main file or modified by a phase
+// are still printed. Returns true if the symbol has been handled this way
+bool CxxBase::emit_system_include_of_symbol(TL::Symbol symbol)
+{
+    if (!CURRENT_CONFIGURATION->include_system_headers
+            || state.emit_declarations != State::EMIT_ALL_DECLARATIONS
+            || !state.classes_being_defined.empty())
+        return false;
+
+    top_level_include_t* top_level_include = get_system_include(symbol.get_locus());
+    if (top_level_include == NULL
+            || top_level_include->included_name == NULL
+            || is_defined_outside_system_headers(symbol)
+            || !system_declaration_is_unchanged(symbol))
+        return false;
+
+    std::string header_name = top_level_include->included_name;
+    if (_emitted_system_includes.find(header_name) == _emitted_system_includes.end())
+    {
+        _emitted_system_includes.insert(header_name);
+
+        // An #include must be emitted at global scope
+        move_to_namespace(state.global_namespace);
+        *(file) << "#include " << header_name << "\n";
+    }
+
+    set_codegen_status(symbol, CODEGEN_STATUS_DEFINED);
+    return true;
+}
+
 void CxxBase::set_codegen_status(TL::Symbol sym, codegen_status_t status)
 {
     _codegen_status[sym] = status;
@@ -9584,6 +9810,8 @@ CxxBase::CxxBase()
             "Disables removal of unused saved-expression variables. If you need to enable this, please report a ticket",
             _prune_saved_variables_str,
             "1").connect(std::bind(&CxxBase::set_prune_saved_variables, this, std::placeholders::_1));
+
+    _system_declarations_file = NULL;
 }
 
 void CxxBase::set_emit_saved_variables_as_unused(const std::string& str)
@@ -51,6 +51,8 @@ namespace Codegen
 
             void handle_parameter(int n, void* data);
 
+            virtual void pre_phases_execution(TL::DTO& dto);
+
             using CodegenPhase::visit;
             Ret visit(const Nodecl::Add &);
             Ret visit(const Nodecl::AddAssignment &);
@@ -665,6 +667,20 @@ namespace Codegen
             std::string _prune_saved_variables_str;
             bool _prune_saved_variables;
             void set_prune_saved_variables(const std::string& str);
+
+            // Top level system includes already emitted in the current file
+            std::set<std::string> _emitted_system_includes;
+            bool emit_system_include_of_symbol(TL::Symbol symbol);
+
+            // State of the entities declared in system headers before any
+            // phase was run, only those still in this state are included
+            const void* _system_declarations_file;
+            std::map<TL::Symbol, std::size_t> _system_declarations;
+            top_level_include_t* get_system_include(const locus_t* locus);
+            bool is_declared_in_system_header(TL::Symbol symbol);
+            bool is_defined_outside_system_headers(TL::Symbol symbol);
+            void record_system_declarations(TL::Scope sc, std::set<TL::Symbol>& visited);
+            bool system_declaration_is_unchanged(TL::Symbol symbol);
     };
 }
 
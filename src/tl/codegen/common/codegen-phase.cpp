@@ -42,6 +42,9 @@ namespace Codegen
     }
     void CodegenPhase::handle_parameter(int n, void* data)
     {}
+
+    void CodegenPhase::pre_phases_execution(TL::DTO& dto)
+    {}
 }
 
 Codegen::CodegenPhase& Codegen::get_current()
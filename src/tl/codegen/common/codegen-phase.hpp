@@ -38,6 +38,9 @@ namespace Codegen
 
         public:
             virtual void handle_parameter(int n, void* data);
+
+            //! Called after the semantic analysis, before any compiler phase is run
+            virtual void pre_phases_execution(TL::DTO& dto);
     };
 
     CodegenPhase& get_current();
@@ -66,6 +66,8 @@ HLTPragmaPhase::HLTPragmaPhase()
                 this,
                 std::placeholders::_1)
             );
+
+    add_pragma_trigger_kinds();
 }
 
 void HLTPragmaPhase::run(TL::DTO& dto)
@@ -26,6 +26,7 @@
 
 #include <climits>
 
+#include "tl-analysis-manager.hpp"
 #include "tl-analysis-utils.hpp"
 #include "tl-omp-auto-scope.hpp"
 
@@ -53,6 +54,10 @@ namespace OpenMP {
                             "Enables OmpSs semantics instead of OpenMP semantics",
                             _ompss_mode_str,
                             "0").connect(std::bind(&AutoScopePhase::set_ompss_mode, this, std::placeholders::_1));
+
+        // Only tasks are auto-scoped
+        add_trigger_kind(NODECL_OPEN_M_P_TASK);
+        add_trigger_kind(NODECL_OMP_SS_TASK_CALL);
     }
 
     void AutoScopePhase::pre_run(TL::DTO& dto)
@@ -66,7 +71,7 @@ namespace OpenMP {
             Nodecl::List& environ)
     {
         TL::Analysis::NodeclList real_autosc_vars;
-        for(TL::Analysis::NodeclSet::iterator it = auto_sc_vars.begin(); it != auto_sc_vars.end(); ++it)
+        for(TL::Analysis::NodeclSet::const_iterator it = auto_sc_vars.begin(); it != auto_sc_vars.end(); ++it)
         {
             if(!Nodecl::Utils::nodecl_is_in_nodecl_list(*it, user_sc_vars))
             {
@@ -112,11 +117,9 @@ namespace OpenMP {
             IsOmpssEnabled = _ompss_mode_enabled;
             
             // Automatically set the scope of the variables involved in the task, if possible
-            TL::Analysis::AnalysisBase analysis(IsOmpssEnabled);
-            analysis.auto_scoping(ast);
-            
             // Print the results if any and modify the environment for later lowering
-            const TL::ObjectList<TL::Analysis::ExtensibleGraph*>& pcfgs = analysis.get_pcfgs();
+            const TL::ObjectList<TL::Analysis::ExtensibleGraph*>& pcfgs = TL::Analysis::AnalysisManager::get_manager().get_pcfgs(
+                    ast, TL::Analysis::WhichAnalysis::AUTO_SCOPING, IsOmpssEnabled);
             for(TL::ObjectList<TL::Analysis::ExtensibleGraph*>::const_iterator it = pcfgs.begin(); it != pcfgs.end(); ++it)
             {
                 const TL::ObjectList<TL::Analysis::Node*>& tasks = (*it)->get_tasks_list();
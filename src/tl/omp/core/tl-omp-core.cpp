@@ -32,6 +32,7 @@
 #include "tl-omp-reduction.hpp"
 #include "tl-builtin.hpp"
 #include "tl-nodecl-utils.hpp"
+#include "tl-objectset.hpp"
 #include "cxx-diagnostic.h"
 
 #include "fortran03-typeutils.h"
@@ -718,7 +719,7 @@ namespace TL { namespace OpenMP {
     class SequentialLoopsVariables : public Nodecl::ExhaustiveVisitor<void>
     {
         public:
-            TL::ObjectList<TL::Symbol> symbols;
+            TL::ObjectSet<TL::Symbol> symbols;
 
             virtual void visit(const Nodecl::ForStatement& for_stmt)
             {
@@ -822,7 +823,7 @@ namespace TL { namespace OpenMP {
             TL::Scope _sc;
 
         public :
-            TL::ObjectList<TL::Symbol> symbols;
+            TL::ObjectSet<TL::Symbol> symbols;
 
             SavedExpressions(TL::Scope sc)
                 : _sc(sc)
@@ -886,9 +887,9 @@ namespace TL { namespace OpenMP {
             struct SymbolsOfScope : public Nodecl::ExhaustiveVisitor<void>
         {
             scope_t* _sc;
-            ObjectList<TL::Symbol>& _result;
+            ObjectSet<TL::Symbol>& _result;
 
-            SymbolsOfScope(scope_t* sc, ObjectList<TL::Symbol>& result)
+            SymbolsOfScope(scope_t* sc, ObjectSet<TL::Symbol>& result)
                 : _sc(sc),
                 _result(result)
             {
@@ -942,7 +943,7 @@ namespace TL { namespace OpenMP {
 
                 if (filter_symbol(sym))
                 {
-                    _result.append(sym);
+                    _result.insert(sym);
                 }
                 else if (sym.is_fortran_namelist())
                 {
@@ -953,7 +954,7 @@ namespace TL { namespace OpenMP {
                     {
                         if (filter_symbol(*it))
                         {
-                            _result.append(*it);
+                            _result.insert(*it);
                         }
                     }
                 }
@@ -986,7 +987,7 @@ namespace TL { namespace OpenMP {
             std::set<TL::Symbol> _visited_function;
             SavedExpressions &_saved_expressions;
         public:
-            ObjectList<TL::Symbol> symbols;
+            ObjectSet<TL::Symbol> symbols;
 
             SymbolsUsedInNestedFunctions(Symbol current_function,
                     SavedExpressions& saved_expressions)
@@ -1037,11 +1038,11 @@ namespace TL { namespace OpenMP {
                 SequentialLoopsVariables sequential_loops;
                 sequential_loops.walk(statement);
 
-                for (ObjectList<TL::Symbol>::iterator it = sequential_loops.symbols.begin();
+                for (ObjectSet<TL::Symbol>::const_iterator it = sequential_loops.symbols.begin();
                         it != sequential_loops.symbols.end();
                         it++)
                 {
-                    TL::Symbol &sym(*it);
+                    const TL::Symbol &sym(*it);
                     DataSharingValue data_sharing = data_environment.get_data_sharing(sym, /* check_enclosing */ false);
 
                     if (data_sharing.attr == DS_UNDEFINED)
@@ -1530,11 +1531,11 @@ namespace TL { namespace OpenMP {
             SequentialLoopsVariables sequential_loops;
             sequential_loops.walk(statement);
 
-            for (ObjectList<TL::Symbol>::iterator it = sequential_loops.symbols.begin();
+            for (ObjectSet<TL::Symbol>::const_iterator it = sequential_loops.symbols.begin();
                     it != sequential_loops.symbols.end();
                     it++)
             {
-                TL::Symbol &sym(*it);
+                const TL::Symbol &sym(*it);
                 DataSharingValue data_sharing = data_environment.get_data_sharing(sym, /* check_enclosing */ false);
 
                 if (data_sharing.attr == DS_UNDEFINED)
@@ -1781,7 +1782,7 @@ namespace TL { namespace OpenMP {
         FORTRAN_LANGUAGE()
         {
             // Other symbols that may be used indirectly are made shared
-            TL::ObjectList<TL::Symbol> other_symbols;
+            TL::ObjectSet<TL::Symbol> other_symbols;
 
             // Nested function symbols
             SymbolsUsedInNestedFunctions symbols_from_nested_calls(
@@ -1792,7 +1793,7 @@ namespace TL { namespace OpenMP {
             other_symbols.insert(symbols_from_nested_calls.symbols);
 
             // Members of namelists
-            ObjectList<TL::Symbol> namelist_members;
+            ObjectSet<TL::Symbol> namelist_members;
             for (ObjectList<TL::Symbol>::iterator it = nonlocal_symbols.begin();
                     it != nonlocal_symbols.end();
                     it++)
@@ -1805,13 +1806,13 @@ namespace TL { namespace OpenMP {
                             it2 != members.end();
                             it2++)
                     {
-                        namelist_members.append(*it2);
+                        namelist_members.insert(*it2);
                     }
                 }
             }
             other_symbols.insert(namelist_members);
 
-            for (ObjectList<TL::Symbol>::iterator it = other_symbols.begin();
+            for (ObjectSet<TL::Symbol>::const_iterator it = other_symbols.begin();
                     it != other_symbols.end();
                     it++)
             {
@@ -1838,11 +1839,11 @@ namespace TL { namespace OpenMP {
         }
 
         // Make them firstprivate if not already set
-        for (ObjectList<TL::Symbol>::iterator it = saved_expressions.symbols.begin();
+        for (ObjectSet<TL::Symbol>::const_iterator it = saved_expressions.symbols.begin();
                 it != saved_expressions.symbols.end();
                 it++)
         {
-            TL::Symbol &sym(*it);
+            const TL::Symbol &sym(*it);
 
             DataSharingValue data_sharing = data_environment.get_data_sharing(sym, /*enclosing */ false);
             if (data_sharing.attr == DS_UNDEFINED)
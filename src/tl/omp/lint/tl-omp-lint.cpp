@@ -25,6 +25,7 @@
 --------------------------------------------------------------------*/
 
 #include "cxx-diagnostic.h"
+#include "tl-analysis-manager.hpp"
 #include "tl-analysis-utils.hpp"
 #include "tl-datareference.hpp"
 #include "tl-omp-lint.hpp"
@@ -1858,12 +1859,18 @@ skip_current_var: ;
     void launch_correctness(
             const TL::Analysis::AnalysisBase& analysis,
             std::string file_path)
+    {
+        launch_correctness(analysis.get_pcfgs(), file_path);
+    }
+
+    void launch_correctness(
+            const TL::ObjectList<TL::Analysis::ExtensibleGraph*>& extensible_graphs,
+            std::string file_path)
     {
         // 1.- Create the log file that will store the logs
         create_logs_file(file_path);
 
         // 2.- Execute all correctness logs in each file we have analyzed previously
-        const TL::ObjectList<TL::Analysis::ExtensibleGraph*>& extensible_graphs = analysis.get_pcfgs();
         for (TL::ObjectList<TL::Analysis::ExtensibleGraph*>::const_iterator it = extensible_graphs.begin();
              it != extensible_graphs.end(); ++it)
         {
@@ -2073,7 +2080,8 @@ skip_current_var: ;
 
     void Lint::run(TL::DTO& dto)
     {
-        Nodecl::NodeclBase top_level = *std::static_pointer_cast<Nodecl::NodeclBase>(dto["nodecl"]);
+        _top_level = *std::static_pointer_cast<Nodecl::NodeclBase>(dto["nodecl"]);
+        _pcfgs.clear();
 
         if (_disable_phase == "0")
         {
@@ -2083,30 +2091,57 @@ skip_current_var: ;
             log_file_path = _correctness_log_path;
             ompss_mode_enabled = _ompss_mode_enabled;
             
-            // 2.- Compute the necessary analyses for reporting correctness logs
-            TL::Analysis::AnalysisBase analysis(ompss_mode_enabled);
-            // We compute liveness analysis (that includes PCFG and use-def) because 
-            // we need the information computed by TaskConcurrency (last and next synchronization points of a task)
+            // 2.- Compute the necessary analyses for reporting correctness logs, function by function
             if (VERBOSE)
             {
                 std::cerr << "===========================================" << std::endl;
                 std::cerr << "OMP-LINT_ Executing analysis required for OpenMP/OmpSs correctness checking in file '" 
-                          << top_level.get_filename() << "'" << std::endl;
-            }
-            analysis.reaching_definitions(top_level, /*propagate_graph_nodes*/ true);
-            if (VERBOSE)
-            {
-                analysis.print_all_pcfg();
+                          << _top_level.get_filename() << "'" << std::endl;
             }
-            
-            // 3.- Launch the correctness process
-            launch_correctness(analysis, log_file_path);
-            
-            if (VERBOSE)
+            FunctionCompilerPhase::run(dto);
+        }
+    }
+
+    void Lint::run_on_function(const Nodecl::FunctionCode& function_code, TL::DTO& dto)
+    {
+        // Only the functions of the file being compiled are checked, not those of included files
+        if (function_code.get_filename() != _top_level.get_filename())
+            return;
+
+        // We compute liveness analysis (that includes PCFG and use-def) because 
+        // we need the information computed by TaskConcurrency (last and next synchronization points of a task)
+        // The analysis is shared with other phases as long as the code does not change
+        TL::Analysis::AnalysisManager& manager = TL::Analysis::AnalysisManager::get_manager();
+        _pcfgs.append(manager.get_pcfgs(
+                function_code, TL::Analysis::WhichAnalysis::REACHING_DEFS_ANALYSIS, ompss_mode_enabled));
+        if (VERBOSE)
+        {
+            manager.print_pcfgs(function_code, ompss_mode_enabled);
+        }
+    }
+
+    void Lint::commit(TL::DTO& dto)
+    {
+        // Task calls at the top level are not part of any function
+        TL::Analysis::AnalysisManager& manager = TL::Analysis::AnalysisManager::get_manager();
+        Nodecl::List top_level_items = _top_level.as<Nodecl::TopLevel>().get_top_level().as<Nodecl::List>();
+        for (Nodecl::List::iterator it = top_level_items.begin(); it != top_level_items.end(); ++it)
+        {
+            if (it->is<Nodecl::OmpSs::TaskCall>()
+                    && it->get_filename() == _top_level.get_filename())
             {
-                std::cerr << "===========================================" << std::endl;
+                _pcfgs.append(manager.get_pcfgs(
+                        *it, TL::Analysis::WhichAnalysis::REACHING_DEFS_ANALYSIS, ompss_mode_enabled));
             }
         }
+
+        // 3.- Launch the correctness process
+        launch_correctness(_pcfgs, log_file_path);
+        
+        if (VERBOSE)
+        {
+            std::cerr << "===========================================" << std::endl;
+        }
     }
 
     void Lint::pre_run(TL::DTO& dto)
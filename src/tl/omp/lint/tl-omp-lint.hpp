@@ -39,6 +39,10 @@ namespace OpenMP {
     void launch_correctness(
             const TL::Analysis::AnalysisBase& analysis,
             std::string log_file_path);
+
+    void launch_correctness(
+            const TL::ObjectList<TL::Analysis::ExtensibleGraph*>& extensible_graphs,
+            std::string log_file_path);
     
     class WritesVisitor : public Nodecl::ExhaustiveVisitor<void>
     {
@@ -85,7 +89,11 @@ namespace OpenMP {
     };
     
     //! This class transforms OpenMP pragmas to the Nodecl representation of parallelism
-    class Lint : public TL::CompilerPhase
+    /*!
+     * Every function is analyzed on its own, through the analysis manager, and the
+     * correctness checks are launched on all of them at commit
+     */
+    class Lint : public TL::FunctionCompilerPhase
     {
     private:
         std::string _disable_phase;
@@ -95,6 +103,9 @@ namespace OpenMP {
 
         bool _ompss_mode_enabled;
 
+        Nodecl::NodeclBase _top_level;
+        TL::ObjectList<TL::Analysis::ExtensibleGraph*> _pcfgs;  //!<PCFGs of the functions handled so far
+
         void set_ompss_mode( const std::string& ompss_mode_str);
         void set_lint_deprecated_flag(const std::string& lint_deprecated_flag_str);
         
@@ -102,6 +113,8 @@ namespace OpenMP {
         Lint();
 
         virtual void run(TL::DTO& dto);
+        virtual void run_on_function(const Nodecl::FunctionCode& function_code, TL::DTO& dto);
+        virtual void commit(TL::DTO& dto);
         virtual void pre_run(TL::DTO& dto);
 
         virtual ~Lint() { }
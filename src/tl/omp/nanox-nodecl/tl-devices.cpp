@@ -660,7 +660,9 @@ namespace TL { namespace Nanox {
                             symbol_entity_specs_set_is_optional(private_sym, sym.is_optional());
                             symbol_entity_specs_set_is_target(private_sym, sym.is_target());
                             symbol_entity_specs_set_is_allocatable(private_sym,
-                                (!sym.is_member() && sym.is_allocatable())
+                                (!sym.is_member()
+                                 && sym.is_allocatable()
+                                 && !(*it)->is_array_passed_by_base_address())
                                 || (*it)->is_copy_of_array_descriptor_allocatable());
 
                             symbol_map->add_map(sym, private_sym);
@@ -27,6 +27,7 @@
 
 #include "tl-source.hpp"
 #include "tl-lowering-visitor.hpp"
+#include "tl-nodecl-builder.hpp"
 
 namespace TL { namespace Nanox {
     Source LoweringVisitor::full_barrier_source()
@@ -45,20 +46,89 @@ namespace TL { namespace Nanox {
         return barrier_src;
     }
 
-    void LoweringVisitor::visit(const Nodecl::OpenMP::BarrierFull& construct)
+    // Builds without parsing
+    //
+    // {
+    //    nanos_err_t nanos_err;
+    //    nanos_err = function_name(arguments);
+    //    if (nanos_err != NANOS_OK)
+    //       nanos_handle_error(nanos_err);
+    // }
+    Nodecl::NodeclBase LoweringVisitor::make_nanos_call_checking_error(
+            const std::string& function_name,
+            const TL::ObjectList<Nodecl::NodeclBase>& arguments,
+            Nodecl::NodeclBase construct)
     {
-        Source barrier_src = full_barrier_source();
-
         FORTRAN_LANGUAGE()
         {
+            // Build in C
             Source::source_language = SourceLanguage::C;
         }
-        Nodecl::NodeclBase barrier = barrier_src.parse_statement(construct);
+
+        TL::Scope sc = construct.retrieve_context();
+        const locus_t* locus = construct.get_locus();
+
+        TL::Scope block_scope = NodeclBuilder::new_block_scope(sc);
+        TL::Symbol nanos_err = NodeclBuilder::new_local_variable(
+                block_scope,
+                "nanos_err",
+                NodeclBuilder::get_symbol(sc, "nanos_err_t").get_user_defined_type(),
+                locus);
+
+        TL::ObjectList<Nodecl::NodeclBase> statements;
+        statements.append(
+                NodeclBuilder::make_assignment_statement(
+                    NodeclBuilder::make_symbol(nanos_err, locus),
+                    NodeclBuilder::make_function_call(
+                        NodeclBuilder::get_function(sc, function_name),
+                        arguments,
+                        block_scope,
+                        locus),
+                    block_scope,
+                    locus));
+
+        TL::ObjectList<Nodecl::NodeclBase> handle_error_arguments;
+        handle_error_arguments.append(NodeclBuilder::make_symbol(nanos_err, locus));
+
+        TL::ObjectList<Nodecl::NodeclBase> handle_error;
+        handle_error.append(
+                NodeclBuilder::make_expression_statement(
+                    NodeclBuilder::make_function_call(
+                        NodeclBuilder::get_function(sc, "nanos_handle_error"),
+                        handle_error_arguments,
+                        block_scope,
+                        locus),
+                    locus));
+
+        statements.append(
+                NodeclBuilder::make_if_statement(
+                    NodeclBuilder::make_binary_operation(
+                        NODECL_DIFFERENT,
+                        NodeclBuilder::make_symbol(nanos_err, locus),
+                        NodeclBuilder::make_symbol(NodeclBuilder::get_symbol(sc, "NANOS_OK"), locus),
+                        block_scope,
+                        locus),
+                    handle_error,
+                    block_scope,
+                    locus));
+
+        Nodecl::NodeclBase result = NodeclBuilder::make_compound_statement(statements, block_scope, locus);
+
         FORTRAN_LANGUAGE()
         {
             Source::source_language = SourceLanguage::Current;
         }
 
+        return result;
+    }
+
+    void LoweringVisitor::visit(const Nodecl::OpenMP::BarrierFull& construct)
+    {
+        Nodecl::NodeclBase barrier = make_nanos_call_checking_error(
+                "nanos_omp_barrier",
+                TL::ObjectList<Nodecl::NodeclBase>(),
+                construct);
+
         construct.replace(barrier);
     }
 } }
@@ -32,38 +32,25 @@ namespace TL { namespace Nanox {
 
     void LoweringVisitor::visit(const Nodecl::OpenMP::FlushMemory& construct)
     {
-        Source flush_source;
-
+        Nodecl::NodeclBase flush_code;
         if (IS_C_LANGUAGE
                 || IS_CXX_LANGUAGE)
         {
+            Source flush_source;
             flush_source
                 << "{"
                 << "__sync_synchronize();"
                 << "}"
                 ;
-        }
-        else
-        {
-            flush_source
-                << "{"
-                << "nanos_err_t nanos_err;"
-                << "nanos_err = nanos_memory_fence();"
-                << "if (nanos_err != NANOS_OK)"
-                <<    "nanos_handle_error(nanos_err);"
-                << "}"
-                ;
-        }
 
-        Nodecl::NodeclBase flush_code;
-        FORTRAN_LANGUAGE()
-        {
-            Source::source_language = SourceLanguage::C;
+            flush_code = flush_source.parse_statement(construct);
         }
-        flush_code = flush_source.parse_statement(construct);
-        FORTRAN_LANGUAGE()
+        else
         {
-            Source::source_language = SourceLanguage::Current;
+            flush_code = make_nanos_call_checking_error(
+                    "nanos_memory_fence",
+                    TL::ObjectList<Nodecl::NodeclBase>(),
+                    construct);
         }
 
         construct.replace(flush_code);
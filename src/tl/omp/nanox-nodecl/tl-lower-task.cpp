@@ -1664,8 +1664,15 @@ void LoweringVisitor::fill_arguments(
                             fill_immediate_arguments << "IF (PRESENT(" << sym.get_name() << ")) THEN\n";
                         }
 
+                        if ((*it)->is_array_passed_by_base_address())
+                        {
+                            fill_outline_arguments << "IF (ALLOCATED(" << sym.get_name() << ")) THEN\n";
+                            fill_immediate_arguments << "IF (ALLOCATED(" << sym.get_name() << ")) THEN\n";
+                        }
+
                         if (t.is_pointer()
-                                || sym.is_allocatable())
+                                || (sym.is_allocatable()
+                                    && !(*it)->is_array_passed_by_base_address()))
                         {
                             TL::Symbol ptr_of_sym = get_function_ptr_of((*it)->get_symbol(),
                                     ctr.retrieve_context());
@@ -1679,7 +1686,9 @@ void LoweringVisitor::fill_arguments(
                                 << ptr_of_sym.get_name() << "( " << (*it)->get_symbol().get_name() << ") \n"
                                 ;
                         }
-                        else if (t.is_array() && t.array_requires_descriptor())
+                        else if (t.is_array()
+                                && t.array_requires_descriptor()
+                                && !(*it)->is_array_passed_by_base_address())
                         {
                             // This must be an assumed shape, so it will have a descriptor
                             OutlineDataItem* copy_of_array_descriptor = (*it)->get_copy_of_array_descriptor();
@@ -1724,6 +1733,12 @@ void LoweringVisitor::fill_arguments(
                                 ;
                         }
 
+                        if ((*it)->is_array_passed_by_base_address())
+                        {
+                            fill_outline_arguments << "END IF\n";
+                            fill_immediate_arguments << "END IF\n";
+                        }
+
                         if (sym.is_optional())
                         {
                             fill_outline_arguments
@@ -29,6 +29,8 @@
 #include "tl-source.hpp"
 #include "tl-nanos.hpp"
 #include "tl-datareference.hpp"
+#include "tl-nodecl-builder.hpp"
+#include "cxx-cexpr.h"
 
 namespace TL { namespace Nanox {
 
@@ -125,46 +127,64 @@ void LoweringVisitor::emit_wait_async(Nodecl::NodeclBase construct,
         OutlineInfo& outline_info,
         bool is_noflush)
 {
-    Source src;
-
     if (!has_dependences)
     {
-        src << "{"
-            <<     "nanos_wd_t nanos_wd_ = nanos_current_wd();"
-            <<     "nanos_err_t nanos_err;"
-            <<     "nanos_err = nanos_wg_wait_completion(nanos_wd_, " << (is_noflush ? "1" : "0") << ");"
-            <<     "if (nanos_err != NANOS_OK) nanos_handle_error(nanos_err);"
-            << "}"
-            ;
-    }
-    else
-    {
-        Source dependences;
-        fill_dependences_taskwait(
-                construct,
-                outline_info,
-                dependences);
-
-        int num_dependences;
-        int num_static_dependences, num_dynamic_dependences;
-        count_dependences(outline_info, num_static_dependences, num_dynamic_dependences);
-        if (num_dynamic_dependences != 0)
+        FORTRAN_LANGUAGE()
         {
-            internal_error("Not yet implemented", 0);
+            // Build in C
+            Source::source_language = SourceLanguage::C;
         }
-        else
+
+        // nanos_wg_wait_completion(nanos_current_wd(), is_noflush)
+        TL::ObjectList<Nodecl::NodeclBase> arguments;
+        arguments.append(
+                NodeclBuilder::make_function_call(
+                    NodeclBuilder::get_function(construct.retrieve_context(), "nanos_current_wd"),
+                    TL::ObjectList<Nodecl::NodeclBase>(),
+                    construct.retrieve_context(),
+                    construct.get_locus()));
+        arguments.append(
+                const_value_to_nodecl(const_value_get_signed_int(is_noflush ? 1 : 0)));
+
+        FORTRAN_LANGUAGE()
         {
-            num_dependences = num_static_dependences;
+            Source::source_language = SourceLanguage::Current;
         }
 
-        src << "{"
-            <<     dependences
-            <<     "nanos_err_t nanos_err = nanos_wait_on(" << num_dependences << ", dependences);"
-            <<     "if (nanos_err != NANOS_OK) nanos_handle_error(nanos_err);"
-            << "}"
-            ;
+        construct.replace(
+                make_nanos_call_checking_error(
+                    "nanos_wg_wait_completion",
+                    arguments,
+                    construct));
+        return;
+    }
+
+    Source src;
+
+    Source dependences;
+    fill_dependences_taskwait(
+            construct,
+            outline_info,
+            dependences);
+
+    int num_dependences;
+    int num_static_dependences, num_dynamic_dependences;
+    count_dependences(outline_info, num_static_dependences, num_dynamic_dependences);
+    if (num_dynamic_dependences != 0)
+    {
+        internal_error("Not yet implemented", 0);
+    }
+    else
+    {
+        num_dependences = num_static_dependences;
     }
 
+    src << "{"
+        <<     dependences
+        <<     "nanos_err_t nanos_err = nanos_wait_on(" << num_dependences << ", dependences);"
+        <<     "if (nanos_err != NANOS_OK) nanos_handle_error(nanos_err);"
+        << "}"
+        ;
 
     FORTRAN_LANGUAGE()
     {
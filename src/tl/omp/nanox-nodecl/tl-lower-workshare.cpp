@@ -28,12 +28,731 @@
 #include "tl-source.hpp"
 #include "tl-lowering-visitor.hpp"
 #include "tl-nodecl-utils.hpp"
+#include "tl-counters.hpp"
+#include "tl-nanox-nodecl.hpp"
+#include "cxx-cexpr.h"
 #include "cxx-diagnostic.h"
+#include "fortran03-buildscope.h"
+#include "fortran03-typeutils.h"
+
+#include <algorithm>
 
 namespace TL { namespace Nanox {
 
+    namespace {
+
+        // Turns an array assignment, or a WHERE with a single masked
+        // assignment, into a loop over the last dimension of the assigned
+        // array. Arrays of rank 1 become a loop over their elements, arrays
+        // of higher rank become a loop whose body keeps the array syntax of
+        // the remaining dimensions.
+        //
+        // Only assignments whose right hand side (and mask) is an elemental
+        // expression of whole arrays and array sections (with known bounds)
+        // and scalars without side effects are handled. The assigned array
+        // may appear in the right hand side only as the very same array
+        // reference, so every element can be computed independently
+        class ArrayAssignmentScalarizer
+        {
+            private:
+                TL::Symbol _lhs_array;
+                Nodecl::NodeclBase _lhs;
+                int _rank;
+                TL::Symbol _induction_var;
+
+                Nodecl::NodeclBase _lower, _upper, _stride;
+
+                // The assignment and, if it is inside a WHERE, its mask
+                Nodecl::Assignment _assignment;
+                Nodecl::NodeclBase _mask;
+
+                static bool is_scalarizable_element_type(TL::Type t)
+                {
+                    t = t.no_ref();
+                    return t.is_integral_type()
+                        || t.is_floating_type()
+                        || t.is_complex()
+                        || t.is_bool();
+                }
+
+                static TL::Type get_rank0_type(TL::Type t)
+                {
+                    t = t.no_ref();
+                    while (t.is_fortran_array())
+                        t = t.array_element();
+                    return t;
+                }
+
+                static Nodecl::NodeclBase parenthesize(Nodecl::NodeclBase n)
+                {
+                    return Nodecl::ParenthesizedExpression::make(
+                            n.shallow_copy(), n.get_type(), n.get_locus());
+                }
+
+                // Inquiry intrinsics whose value does not depend on the
+                // values of the elements of their array argument
+                static bool is_bound_inquiry_intrinsic(TL::Symbol called)
+                {
+                    std::string name = called.get_name();
+                    return name == "lbound"
+                        || name == "ubound"
+                        || name == "size"
+                        || name == "len";
+                }
+
+                // Expressions that can be evaluated once per element.
+                //
+                // Calls to transformational intrinsics, like SUM, are not
+                // since they would be evaluated again for every element
+                bool is_repeatable(Nodecl::NodeclBase n) const
+                {
+                    if (n.is_null())
+                        return true;
+
+                    if (n.is<Nodecl::Symbol>()
+                            && n.get_symbol() == _lhs_array)
+                        return false;
+
+                    if (n.is<Nodecl::FunctionCall>())
+                    {
+                        TL::Symbol called = n.as<Nodecl::FunctionCall>().get_called().get_symbol();
+                        if (!called.is_valid()
+                                || !called.is_intrinsic())
+                            return false;
+
+                        if (is_bound_inquiry_intrinsic(called))
+                            return is_repeatable_bound_inquiry(n.as<Nodecl::FunctionCall>());
+
+                        if (!called.is_elemental())
+                            return false;
+                    }
+
+                    Nodecl::NodeclBase::Children children = n.children();
+                    for (Nodecl::NodeclBase::Children::iterator it = children.begin();
+                            it != children.end();
+                            it++)
+                    {
+                        if (!is_repeatable(*it))
+                            return false;
+                    }
+
+                    return true;
+                }
+
+                // The array of a bound inquiry may be any array, even the
+                // assigned one, as long as it is named directly
+                bool is_repeatable_bound_inquiry(Nodecl::FunctionCall call) const
+                {
+                    Nodecl::List arguments = call.get_arguments().as<Nodecl::List>();
+                    for (Nodecl::List::iterator it = arguments.begin();
+                            it != arguments.end();
+                            it++)
+                    {
+                        Nodecl::NodeclBase argument = *it;
+                        if (argument.is<Nodecl::FortranActualArgument>())
+                            argument = argument.as<Nodecl::FortranActualArgument>().get_argument();
+
+                        if (!argument.is<Nodecl::Symbol>()
+                                && !is_repeatable(argument))
+                            return false;
+                    }
+
+                    return true;
+                }
+
+                static bool is_plain_array(TL::Symbol sym)
+                {
+                    // Pointer arrays are references through a dereference
+                    // so they never get here
+                    if (!sym.is_valid()
+                            || !sym.is_variable()
+                            || sym.is_target())
+                        return false;
+
+                    // Storage of arrays in an EQUIVALENCE may overlap
+                    scope_entry_t* equivalence_info =
+                        ::fortran_get_equivalence_symbol_info(sym.get_scope().get_decl_context());
+                    return (equivalence_info == NULL
+                            || nodecl_is_null(equivalence_info->value));
+                }
+
+                // Arrays with the same rank as the assigned one
+                bool is_conformable(TL::Type t) const
+                {
+                    t = t.no_ref();
+                    return t.is_fortran_array()
+                        && t.fortran_rank() == _rank
+                        && is_scalarizable_element_type(get_rank0_type(t));
+                }
+
+                // Gets the bounds of every dimension of a whole array as
+                // ranges, the first dimension first. The last one is the
+                // dimension that is distributed
+                bool get_whole_array_ranges(TL::Type t, TL::ObjectList<Nodecl::NodeclBase>& ranges) const
+                {
+                    t = t.no_ref();
+                    while (t.is_fortran_array())
+                    {
+                        Nodecl::NodeclBase lower, upper;
+                        t.array_get_bounds(lower, upper);
+                        if (lower.is_null()
+                                || upper.is_null()
+                                || !is_repeatable(lower)
+                                || !is_repeatable(upper))
+                            return false;
+
+                        ranges.append(
+                                Nodecl::Range::make(
+                                    lower.shallow_copy(),
+                                    upper.shallow_copy(),
+                                    const_value_to_nodecl(const_value_get_signed_int(1)),
+                                    ::fortran_get_default_integer_type(),
+                                    lower.get_locus()));
+
+                        t = t.array_element();
+                    }
+
+                    // The outermost array type is the last dimension
+                    std::reverse(ranges.begin(), ranges.end());
+                    return true;
+                }
+
+                // Gets the base array of a whole array or array section
+                // reference and the bounds of its distributed dimension, which
+                // is its last range. 'distributed' is the position of that
+                // range among the subscripts
+                bool get_array_reference(Nodecl::NodeclBase n,
+                        TL::Symbol& array,
+                        Nodecl::NodeclBase& lower,
+                        Nodecl::NodeclBase& upper,
+                        Nodecl::NodeclBase& stride,
+                        int& distributed) const
+                {
+                    if (!is_conformable(n.get_type()))
+                        return false;
+
+                    if (n.is<Nodecl::Symbol>())
+                    {
+                        array = n.get_symbol();
+                        if (!is_plain_array(array))
+                            return false;
+
+                        TL::ObjectList<Nodecl::NodeclBase> ranges;
+                        if (!get_whole_array_ranges(n.get_type(), ranges))
+                            return false;
+
+                        distributed = _rank - 1;
+                        lower = ranges.back().as<Nodecl::Range>().get_lower();
+                        upper = ranges.back().as<Nodecl::Range>().get_upper();
+                        stride = Nodecl::NodeclBase::null();
+                        return true;
+                    }
+                    else if (n.is<Nodecl::ArraySubscript>())
+                    {
+                        Nodecl::NodeclBase subscripted = n.as<Nodecl::ArraySubscript>().get_subscripted();
+                        if (!subscripted.is<Nodecl::Symbol>())
+                            return false;
+
+                        array = subscripted.get_symbol();
+                        if (!is_plain_array(array))
+                            return false;
+
+                        Nodecl::List subscripts = n.as<Nodecl::ArraySubscript>().get_subscripts().as<Nodecl::List>();
+                        if (subscripted.get_type().no_ref().fortran_rank() != (int)subscripts.size())
+                            return false;
+
+                        int num_ranges = 0;
+                        int position = 0;
+                        for (Nodecl::List::iterator it = subscripts.begin();
+                                it != subscripts.end();
+                                it++, position++)
+                        {
+                            if (it->is<Nodecl::Range>())
+                            {
+                                num_ranges++;
+                                Nodecl::Range range = it->as<Nodecl::Range>();
+                                if (range.get_lower().is_null()
+                                        || range.get_upper().is_null()
+                                        || !is_repeatable(range.get_lower())
+                                        || !is_repeatable(range.get_upper())
+                                        || !is_repeatable(range.get_stride()))
+                                    return false;
+
+                                lower = range.get_lower();
+                                upper = range.get_upper();
+                                stride = range.get_stride();
+                                distributed = position;
+                            }
+                            else if (it->get_type().no_ref().is_fortran_array()
+                                    || !is_repeatable(*it))
+                            {
+                                // Vector subscripts are not handled
+                                return false;
+                            }
+                        }
+
+                        return (num_ranges == _rank);
+                    }
+
+                    return false;
+                }
+
+                // lower + induction_var * stride
+                Nodecl::NodeclBase make_element_index(
+                        Nodecl::NodeclBase lower,
+                        Nodecl::NodeclBase stride,
+                        const locus_t* locus) const
+                {
+                    TL::Type int_type = ::fortran_get_default_integer_type();
+
+                    Nodecl::NodeclBase offset = _induction_var.make_nodecl(/* set_ref_type */ true, locus);
+                    if (!stride.is_null()
+                            && !(stride.is_constant()
+                                && const_value_is_one(stride.get_constant())))
+                    {
+                        offset = Nodecl::Mul::make(offset, parenthesize(stride), int_type, locus);
+                    }
+
+                    return Nodecl::Add::make(parenthesize(lower), offset, int_type, locus);
+                }
+
+                // Makes the reference to the part of the array referenced
+                // by 'n' in one iteration of the loop: an element if the
+                // rank is 1 or an array section of rank - 1 otherwise
+                bool make_element(Nodecl::NodeclBase n, Nodecl::NodeclBase& element) const
+                {
+                    TL::Symbol array;
+                    Nodecl::NodeclBase lower, upper, stride;
+                    int distributed;
+                    if (!get_array_reference(n, array, lower, upper, stride, distributed))
+                        return false;
+
+                    if (array == _lhs_array
+                            && !Nodecl::Utils::structurally_equal_nodecls(n, _lhs,
+                                /* skip_conversion_nodecls */ true))
+                        return false;
+
+                    Nodecl::NodeclBase index = make_element_index(lower, stride, n.get_locus());
+                    TL::Type element_type = n.get_type().no_ref().array_element().get_lvalue_reference_to();
+
+                    Nodecl::NodeclBase subscripted;
+                    TL::ObjectList<Nodecl::NodeclBase> subscripts;
+                    if (n.is<Nodecl::Symbol>())
+                    {
+                        subscripted = n;
+                        get_whole_array_ranges(n.get_type(), subscripts);
+                    }
+                    else
+                    {
+                        subscripted = n.as<Nodecl::ArraySubscript>().get_subscripted();
+                        subscripts = n.as<Nodecl::ArraySubscript>().get_subscripts().as<Nodecl::List>().to_object_list();
+                    }
+
+                    Nodecl::List new_subscripts;
+                    int position = 0;
+                    for (TL::ObjectList<Nodecl::NodeclBase>::iterator it = subscripts.begin();
+                            it != subscripts.end();
+                            it++, position++)
+                    {
+                        if (position == distributed)
+                            new_subscripts.append(index);
+                        else
+                            new_subscripts.append(it->shallow_copy());
+                    }
+
+                    element = Nodecl::ArraySubscript::make(
+                            subscripted.shallow_copy(),
+                            new_subscripts,
+                            element_type,
+                            n.get_locus());
+
+                    return true;
+                }
+
+                static bool is_elemental_operation(Nodecl::NodeclBase n)
+                {
+                    return n.is<Nodecl::Add>()
+                        || n.is<Nodecl::Minus>()
+                        || n.is<Nodecl::Mul>()
+                        || n.is<Nodecl::Div>()
+                        || n.is<Nodecl::Power>()
+                        || n.is<Nodecl::Neg>()
+                        || n.is<Nodecl::Plus>()
+                        || n.is<Nodecl::Equal>()
+                        || n.is<Nodecl::Different>()
+                        || n.is<Nodecl::LowerThan>()
+                        || n.is<Nodecl::LowerOrEqualThan>()
+                        || n.is<Nodecl::GreaterThan>()
+                        || n.is<Nodecl::GreaterOrEqualThan>()
+                        || n.is<Nodecl::LogicalAnd>()
+                        || n.is<Nodecl::LogicalOr>()
+                        || n.is<Nodecl::LogicalNot>()
+                        || n.is<Nodecl::Conversion>()
+                        || n.is<Nodecl::ParenthesizedExpression>();
+                }
+
+                static bool is_elemental_intrinsic_call(Nodecl::NodeclBase n)
+                {
+                    if (!n.is<Nodecl::FunctionCall>())
+                        return false;
+
+                    TL::Symbol called = n.as<Nodecl::FunctionCall>().get_called().get_symbol();
+                    return called.is_valid()
+                        && called.is_intrinsic()
+                        && called.is_elemental();
+                }
+
+                // Replaces in place every array reference of 'n' by its element
+                bool scalarize_in_place(Nodecl::NodeclBase n) const
+                {
+                    TL::Type t = n.get_type();
+                    if (!t.no_ref().is_fortran_array())
+                        return is_repeatable(n);
+
+                    if (!is_conformable(t))
+                        return false;
+
+                    if (n.is<Nodecl::Symbol>()
+                            || n.is<Nodecl::ArraySubscript>())
+                    {
+                        Nodecl::NodeclBase element;
+                        if (!make_element(n, element))
+                            return false;
+
+                        n.replace(element);
+                        return true;
+                    }
+                    else if (is_elemental_operation(n))
+                    {
+                        Nodecl::NodeclBase::Children children = n.children();
+                        for (Nodecl::NodeclBase::Children::iterator it = children.begin();
+                                it != children.end();
+                                it++)
+                        {
+                            if (!it->is_null()
+                                    && !scalarize_in_place(*it))
+                                return false;
+                        }
+                    }
+                    else if (is_elemental_intrinsic_call(n))
+                    {
+                        Nodecl::List arguments = n.as<Nodecl::FunctionCall>().get_arguments().as<Nodecl::List>();
+                        for (Nodecl::List::iterator it = arguments.begin();
+                                it != arguments.end();
+                                it++)
+                        {
+                            Nodecl::NodeclBase argument = *it;
+                            if (argument.is<Nodecl::FortranActualArgument>())
+                                argument = argument.as<Nodecl::FortranActualArgument>().get_argument();
+
+                            if (!scalarize_in_place(argument))
+                                return false;
+                        }
+                    }
+                    else
+                    {
+                        return false;
+                    }
+
+                    n.set_type(t.no_ref().array_element());
+                    return true;
+                }
+
+                // WHERE (mask) lhs = rhs
+                static bool get_masked_assignment(Nodecl::FortranWhere where,
+                        Nodecl::NodeclBase& mask,
+                        Nodecl::NodeclBase& stmt)
+                {
+                    // ELSEWHERE parts are not handled
+                    Nodecl::List where_set = where.get_where_set().as<Nodecl::List>();
+                    if (where_set.size() != 1)
+                        return false;
+
+                    Nodecl::FortranWherePair where_pair = where_set[0].as<Nodecl::FortranWherePair>();
+                    Nodecl::List statements = where_pair.get_statement().as<Nodecl::List>();
+                    if (where_pair.get_mask().is_null()
+                            || statements.size() != 1)
+                        return false;
+
+                    mask = where_pair.get_mask();
+                    stmt = statements[0];
+                    return true;
+                }
+
+            public:
+                ArrayAssignmentScalarizer()
+                    : _rank(0)
+                {
+                }
+
+                // Checks if the statement can be scalarized
+                bool check(Nodecl::NodeclBase stmt)
+                {
+                    _mask = Nodecl::NodeclBase::null();
+                    if (stmt.is<Nodecl::FortranWhere>()
+                            && !get_masked_assignment(stmt.as<Nodecl::FortranWhere>(), _mask, stmt))
+                        return false;
+
+                    if (!stmt.is<Nodecl::ExpressionStatement>())
+                        return false;
+
+                    Nodecl::NodeclBase expr = stmt.as<Nodecl::ExpressionStatement>().get_nest();
+                    if (!expr.is<Nodecl::Assignment>())
+                        return false;
+
+                    _assignment = expr.as<Nodecl::Assignment>();
+                    _lhs = _assignment.get_lhs();
+
+                    // First find the assigned array, this is used by is_repeatable
+                    if (_lhs.is<Nodecl::Symbol>())
+                        _lhs_array = _lhs.get_symbol();
+                    else if (_lhs.is<Nodecl::ArraySubscript>())
+                        _lhs_array = _lhs.as<Nodecl::ArraySubscript>().get_subscripted().get_symbol();
+                    else
+                        return false;
+
+                    if (!_lhs.get_type().no_ref().is_fortran_array())
+                        return false;
+                    _rank = _lhs.get_type().no_ref().fortran_rank();
+
+                    TL::Symbol array;
+                    int distributed;
+                    if (!get_array_reference(_lhs, array, _lower, _upper, _stride, distributed))
+                        return false;
+
+                    // Like scalarize but do not keep the result. A scalar
+                    // mask would not be evaluated once per element
+                    Nodecl::NodeclBase rhs = _assignment.get_rhs().shallow_copy();
+                    if (!_mask.is_null())
+                    {
+                        Nodecl::NodeclBase mask = _mask.shallow_copy();
+                        if (!_mask.get_type().no_ref().is_fortran_array()
+                                || !scalarize_in_place(mask))
+                            return false;
+                    }
+                    return scalarize_in_place(rhs);
+                }
+
+                // DO induction_var = 0, (upper - lower + stride) / stride - 1
+                //    lhs(lower + induction_var * stride) = rhs(...)
+                // END DO
+                //
+                // A masked assignment is guarded by an IF if the rank is 1
+                // and by a WHERE otherwise
+                Nodecl::NodeclBase scalarize(TL::Symbol induction_var)
+                {
+                    _induction_var = induction_var;
+
+                    const locus_t* locus = _assignment.get_locus();
+
+                    Nodecl::NodeclBase lhs = _lhs.shallow_copy();
+                    Nodecl::NodeclBase rhs = _assignment.get_rhs().shallow_copy();
+
+                    bool ok = scalarize_in_place(lhs) && scalarize_in_place(rhs);
+                    ERROR_CONDITION(!ok, "Statement could not be scalarized", 0);
+
+                    Nodecl::NodeclBase element_stmt = Nodecl::ExpressionStatement::make(
+                            Nodecl::Assignment::make(lhs, rhs, lhs.get_type(), locus),
+                            locus);
+
+                    if (!_mask.is_null())
+                    {
+                        Nodecl::NodeclBase mask = _mask.shallow_copy();
+                        ok = scalarize_in_place(mask);
+                        ERROR_CONDITION(!ok, "Mask could not be scalarized", 0);
+
+                        if (_rank == 1)
+                        {
+                            element_stmt = Nodecl::IfElseStatement::make(
+                                    mask,
+                                    Nodecl::List::make(element_stmt),
+                                    /* else */ Nodecl::NodeclBase::null(),
+                                    locus);
+                        }
+                        else
+                        {
+                            element_stmt = Nodecl::FortranWhere::make(
+                                    Nodecl::List::make(
+                                        Nodecl::FortranWherePair::make(
+                                            mask,
+                                            Nodecl::List::make(element_stmt),
+                                            locus)),
+                                    locus);
+                        }
+                    }
+
+                    TL::Type int_type = ::fortran_get_default_integer_type();
+                    Nodecl::NodeclBase num_elements = Nodecl::Minus::make(
+                            parenthesize(_upper),
+                            parenthesize(_lower),
+                            int_type,
+                            locus);
+                    Nodecl::NodeclBase last_index;
+                    if (_stride.is_null())
+                    {
+                        last_index = num_elements;
+                    }
+                    else
+                    {
+                        num_elements = Nodecl::Add::make(num_elements, parenthesize(_stride), int_type, locus);
+                        last_index = Nodecl::Minus::make(
+                                Nodecl::Div::make(
+                                    Nodecl::ParenthesizedExpression::make(num_elements, int_type, locus),
+                                    parenthesize(_stride),
+                                    int_type,
+                                    locus),
+                                const_value_to_nodecl(const_value_get_signed_int(1)),
+                                int_type,
+                                locus);
+                    }
+
+                    Nodecl::NodeclBase range = Nodecl::RangeLoopControl::make(
+                            Nodecl::Symbol::make(induction_var, locus),
+                            const_value_to_nodecl(const_value_get_signed_int(0)),
+                            last_index,
+                            const_value_to_nodecl(const_value_get_signed_int(1)),
+                            locus);
+
+                    return Nodecl::ForStatement::make(
+                            range,
+                            Nodecl::List::make(element_stmt),
+                            /* name */ Nodecl::NodeclBase::null(),
+                            locus);
+                }
+        };
+
+        // Splits the statements of a WORKSHARE in loops, one for each array
+        // assignment or masked assignment that can be scalarized, distributed among the threads
+        // of the team, and WORKSHAREs for the remaining statements
+        Nodecl::NodeclBase lower_workshare_into_loops(
+                const Nodecl::OpenMP::Workshare& construct)
+        {
+            Nodecl::List statements = construct.get_statements().as<Nodecl::List>();
+
+            TL::ObjectList<bool> is_scalarizable;
+            bool any_scalarizable = false;
+            for (Nodecl::List::iterator it = statements.begin();
+                    it != statements.end();
+                    it++)
+            {
+                ArrayAssignmentScalarizer scalarizer;
+                is_scalarizable.append(scalarizer.check(*it));
+                any_scalarizable = any_scalarizable || is_scalarizable.back();
+            }
+
+            if (!any_scalarizable)
+                return Nodecl::NodeclBase::null();
+
+            // Every part but the last one waits for the previous ones
+            Nodecl::List environment = construct.get_environment().as<Nodecl::List>();
+            bool barrier_at_end = !environment.find_first<Nodecl::OpenMP::BarrierAtEnd>().is_null();
+
+            Nodecl::List base_environment;
+            for (Nodecl::List::iterator it = environment.begin();
+                    it != environment.end();
+                    it++)
+            {
+                if (!it->is<Nodecl::OpenMP::BarrierAtEnd>()
+                        && !it->is<Nodecl::OpenMP::FlushAtExit>())
+                    base_environment.append(it->shallow_copy());
+            }
+
+            Scope sc = construct.retrieve_context();
+            Counter& counter = CounterManager::get_counter("nanox_workshare_to_for");
+
+            Nodecl::List parts;
+            Nodecl::List pending_statements;
+            unsigned int i = 0;
+            for (Nodecl::List::iterator it = statements.begin();
+                    it != statements.end();
+                    it++, i++)
+            {
+                bool is_last = (i + 1 == statements.size());
+                bool part_ends = is_last || is_scalarizable[i] || is_scalarizable[i + 1];
+
+                Nodecl::List part_environment = base_environment.shallow_copy().as<Nodecl::List>();
+                if (part_ends
+                        && (!is_last || barrier_at_end))
+                {
+                    part_environment.append(Nodecl::OpenMP::FlushAtExit::make(construct.get_locus()));
+                    part_environment.append(Nodecl::OpenMP::BarrierAtEnd::make(construct.get_locus()));
+                }
+
+                if (!is_scalarizable[i])
+                {
+                    pending_statements.append(it->shallow_copy());
+                    if (part_ends)
+                    {
+                        parts.append(
+                                Nodecl::OpenMP::Workshare::make(
+                                    part_environment,
+                                    pending_statements,
+                                    construct.get_locus()));
+                        pending_statements = Nodecl::List();
+                    }
+                    continue;
+                }
+
+                std::stringstream symbol_name;
+                symbol_name << "nanos_omp_ws_index_" << (int)counter;
+                counter++;
+
+                TL::Symbol index_symbol = sc.new_symbol(symbol_name.str());
+                scope_entry_t* index_sym = index_symbol.get_internal_symbol();
+                index_sym->kind = SK_VARIABLE;
+                index_sym->type_information = get_signed_int_type();
+                index_sym->locus = it->get_locus();
+
+                part_environment.append(
+                        Nodecl::OpenMP::Private::make(
+                            Nodecl::List::make(
+                                Nodecl::Symbol::make(index_symbol, it->get_locus())),
+                            it->get_locus()));
+                part_environment.append(
+                        Nodecl::OpenMP::Schedule::make(
+                            ::const_value_to_nodecl(const_value_get_signed_int(0)),
+                            "static",
+                            it->get_locus()));
+
+                ArrayAssignmentScalarizer scalarizer;
+                scalarizer.check(*it);
+                Nodecl::NodeclBase for_statement = scalarizer.scalarize(index_symbol);
+
+                // The OpenMP::For construct expects NODECL_CONTEXT -> NODECL_LIST -> NODECL_FOR_STATEMENT
+                const decl_context_t* block_context = new_block_context(sc.get_decl_context());
+                Nodecl::NodeclBase context = Nodecl::Context::make(
+                        Nodecl::List::make(for_statement),
+                        block_context,
+                        it->get_locus());
+
+                parts.append(
+                        Nodecl::OpenMP::For::make(
+                            part_environment,
+                            context,
+                            it->get_locus()));
+            }
+
+            return Nodecl::CompoundStatement::make(
+                    parts,
+                    /* finalize */ Nodecl::NodeclBase::null(),
+                    construct.get_locus());
+        }
+    }
+
     void LoweringVisitor::visit(const Nodecl::OpenMP::Workshare& construct)
     {
+        if (_lowering->workshare_loops_enabled()
+                && !_lowering->in_ompss_mode())
+        {
+            Nodecl::NodeclBase parts = lower_workshare_into_loops(construct);
+            if (!parts.is_null())
+            {
+                construct.replace(parts);
+                walk(construct);
+                return;
+            }
+        }
+
         warn_printf_at(construct.get_locus(), "!$OMP WORKSHARE is implemented as !$OMP SINGLE\n");
 
         Nodecl::List environment = construct.get_environment().as<Nodecl::List>();
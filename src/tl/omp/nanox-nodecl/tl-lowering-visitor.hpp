@@ -413,6 +413,11 @@ class LoweringVisitor : public Nodecl::ExhaustiveVisitor<void>
 
         Source full_barrier_source();
 
+        Nodecl::NodeclBase make_nanos_call_checking_error(
+                const std::string& function_name,
+                const TL::ObjectList<Nodecl::NodeclBase>& arguments,
+                Nodecl::NodeclBase construct);
+
         void reduction_initialization_code(
                 OutlineInfo& outline_info,
                 Nodecl::NodeclBase ref_tree,
@@ -46,7 +46,8 @@ namespace TL { namespace Nanox {
         _instrumentation_enabled(false),
         _nanos_debug_enabled(false),
         _final_clause_transformation_disabled(false),
-        _firstprivates_always_references(false)
+        _firstprivates_always_references(false),
+        _workshare_loops(false)
     {
         set_phase_name("Nanos++ lowering");
         set_phase_description("This phase lowers from Mercurium parallel IR into real code involving Nanos++ runtime interface");
@@ -85,6 +86,11 @@ namespace TL { namespace Nanox {
                 "For C/C++, passes firstprivates always by reference",
                 _firstprivates_always_references_str,
                 "0").connect(std::bind(&Lowering::set_firstprivates_always_references, this, std::placeholders::_1));
+
+        register_parameter("workshare_loops",
+                "In Fortran, distributes the array assignments and the single masked array assignments of a WORKSHARE among the threads instead of running them in a single thread",
+                _workshare_loops_str,
+                "0").connect(std::bind(&Lowering::set_workshare_loops, this, std::placeholders::_1));
     }
 
     void Lowering::run(DTO& dto)
@@ -150,6 +156,11 @@ namespace TL { namespace Nanox {
         parse_boolean_option("firstprivates_always_references", str, _firstprivates_always_references, "Assuming false.");
     }
 
+    void Lowering::set_workshare_loops(const std::string& str)
+    {
+        parse_boolean_option("workshare_loops", str, _workshare_loops, "Assuming false.");
+    }
+
     bool Lowering::nanos_debug_enabled() const
     {
         return _nanos_debug_enabled;
@@ -175,6 +186,11 @@ namespace TL { namespace Nanox {
         return _firstprivates_always_references;
     }
 
+    bool Lowering::workshare_loops_enabled() const
+    {
+        return _workshare_loops;
+    }
+
     void Lowering::emit_nanos_requirements(Nodecl::NodeclBase global_node)
     {
         Source src;
@@ -49,6 +49,7 @@ namespace TL { namespace Nanox {
             bool instrumentation_enabled() const;
             bool final_clause_transformation_disabled() const;
             bool firstprivates_always_by_reference() const;
+            bool workshare_loops_enabled() const;
 
             struct Flag
             {
@@ -103,6 +104,10 @@ namespace TL { namespace Nanox {
             bool _firstprivates_always_references;
             void set_firstprivates_always_references(const std::string& str);
 
+            std::string _workshare_loops_str;
+            bool _workshare_loops;
+            void set_workshare_loops(const std::string& str);
+
             void finalize_phase(Nodecl::NodeclBase global_node);
             void emit_nanos_requirements(Nodecl::NodeclBase global_node);
             void set_openmp_programming_model(Source &src);
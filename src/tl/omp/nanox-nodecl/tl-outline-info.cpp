@@ -28,6 +28,7 @@
 #include "tl-outline-info.hpp"
 #include "tl-nodecl-visitor.hpp"
 #include "tl-datareference.hpp"
+#include "tl-nodecl-builder.hpp"
 #include "tl-counters.hpp"
 #include "tl-predicateutils.hpp"
 #include "codegen-phase.hpp"
@@ -610,9 +611,30 @@ namespace TL { namespace Nanox {
             if (t.array_requires_descriptor()
                     && outline_data_item != NULL
                     && (outline_data_item->get_sharing() == OutlineDataItem::SHARING_SHARED
-                        || outline_data_item->get_sharing() == OutlineDataItem::SHARING_REDUCTION))
+                        || outline_data_item->get_sharing() == OutlineDataItem::SHARING_REDUCTION)
+                    && !outline_data_item->is_array_passed_by_base_address())
                 return t;
 
+            if (sym.is_allocatable()
+                    && outline_data_item != NULL
+                    && outline_data_item->is_array_passed_by_base_address()
+                    && conditional_bound.is_null())
+            {
+                // The bounds are only meaningful if the array is allocated
+                Nodecl::NodeclBase symbol_ref = Nodecl::Symbol::make(sym, make_locus("", 0, 0));
+                TL::Type sym_type = sym.get_type();
+
+                if (!sym_type.is_any_reference())
+                    sym_type = sym_type.get_lvalue_reference_to();
+                symbol_ref.set_type(sym_type);
+
+                conditional_bound = NodeclBuilder::make_fortran_intrinsic_call(
+                        "allocated",
+                        TL::ObjectList<Nodecl::NodeclBase>(1, symbol_ref),
+                        _sc,
+                        symbol_ref.get_locus());
+            }
+
             if (sym.is_allocatable()
                     && outline_data_item != NULL
                     && ((outline_data_item->get_sharing() == OutlineDataItem::SHARING_PRIVATE)
@@ -634,10 +656,11 @@ namespace TL { namespace Nanox {
                     sym_type = sym_type.get_lvalue_reference_to();
                 symbol_ref.set_type(sym_type);
 
-                Source allocated_src;
-                allocated_src << "ALLOCATED(" << as_expression(symbol_ref) << ")";
-
-                Nodecl::NodeclBase allocated_tree = allocated_src.parse_expression(_sc);
+                Nodecl::NodeclBase allocated_tree = NodeclBuilder::make_fortran_intrinsic_call(
+                        "allocated",
+                        TL::ObjectList<Nodecl::NodeclBase>(1, symbol_ref),
+                        _sc,
+                        symbol_ref.get_locus());
 
                 this->add_capture_with_value(is_allocated_sym, allocated_tree);
 
@@ -647,11 +670,12 @@ namespace TL { namespace Nanox {
             if (sym.is_optional()
                     && conditional_bound.is_null())
             {
-                Source present_src;
-                present_src << "PRESENT(" << sym.get_name() << ")";
-
-                Nodecl::NodeclBase allocated_tree = present_src.parse_expression(_sc);
-                conditional_bound = allocated_tree;
+                Nodecl::NodeclBase symbol_ref = sym.make_nodecl(/* set_ref_type */ true);
+                conditional_bound = NodeclBuilder::make_fortran_intrinsic_call(
+                        "present",
+                        TL::ObjectList<Nodecl::NodeclBase>(1, symbol_ref),
+                        _sc,
+                        symbol_ref.get_locus());
             }
 
             if (lower.is_null())
@@ -685,10 +709,12 @@ namespace TL { namespace Nanox {
                                 sym_type.no_ref().points_to().get_lvalue_reference_to());
                     }
 
-                    Source lbound_src;
-                    lbound_src << "LBOUND(" << as_expression(symbol_ref) << ", DIM=" << dim << ")";
+                    TL::ObjectList<Nodecl::NodeclBase> lbound_arguments;
+                    lbound_arguments.append(symbol_ref);
+                    lbound_arguments.append(const_value_to_nodecl(const_value_get_signed_int(dim)));
 
-                    Nodecl::NodeclBase lbound_tree = lbound_src.parse_expression(_sc);
+                    Nodecl::NodeclBase lbound_tree = NodeclBuilder::make_fortran_intrinsic_call(
+                            "lbound", lbound_arguments, _sc, symbol_ref.get_locus());
 
                     this->add_capture_with_value(bound_sym, lbound_tree, conditional_bound);
 
@@ -752,10 +778,12 @@ namespace TL { namespace Nanox {
                                 sym_type.no_ref().points_to().get_lvalue_reference_to());
                     }
 
-                    Source ubound_src;
-                    ubound_src << "UBOUND(" << as_expression(symbol_ref) << ", DIM=" << dim << ")";
+                    TL::ObjectList<Nodecl::NodeclBase> ubound_arguments;
+                    ubound_arguments.append(symbol_ref);
+                    ubound_arguments.append(const_value_to_nodecl(const_value_get_signed_int(dim)));
 
-                    Nodecl::NodeclBase ubound_tree = ubound_src.parse_expression(_sc);
+                    Nodecl::NodeclBase ubound_tree = NodeclBuilder::make_fortran_intrinsic_call(
+                            "ubound", ubound_arguments, _sc, symbol_ref.get_locus());
 
                     this->add_capture_with_value(bound_sym, ubound_tree, conditional_bound);
 
@@ -1095,6 +1123,147 @@ namespace TL { namespace Nanox {
         _outline_info.add_copy_of_outline_data_item(data_item);
     }
 
+    namespace {
+
+        // Checks that the statements only use the elements and the bounds of
+        // an ALLOCATABLE array, so the array can be redeclared as an explicit
+        // shape array
+        class OnlyElementsAndBoundsAreUsed : public Nodecl::ExhaustiveVisitor<void>
+        {
+            private:
+                TL::Symbol _sym;
+                bool _result;
+
+                bool is_valid_use(Nodecl::NodeclBase n)
+                {
+                    Nodecl::NodeclBase parent = n.get_parent();
+
+                    // Element references and array sections
+                    if (parent.is<Nodecl::ArraySubscript>()
+                            && parent.as<Nodecl::ArraySubscript>().get_subscripted() == n)
+                        return true;
+
+                    // A = ... may reallocate A
+                    if (parent.is<Nodecl::Assignment>()
+                            && parent.as<Nodecl::Assignment>().get_lhs() == n)
+                        return false;
+
+                    while (parent.is<Nodecl::FortranActualArgument>()
+                            || parent.is<Nodecl::List>())
+                    {
+                        parent = parent.get_parent();
+                    }
+
+                    if (parent.is<Nodecl::FunctionCall>())
+                    {
+                        // The callee may expect an ALLOCATABLE dummy
+                        TL::Symbol called = parent.as<Nodecl::FunctionCall>().get_called().get_symbol();
+                        if (!called.is_valid()
+                                || !called.is_intrinsic())
+                            return false;
+
+                        std::string name = strtolower(called.get_name().c_str());
+                        return (name != "allocated"
+                                && name != "move_alloc");
+                    }
+
+                    return true;
+                }
+
+                void check_allocation_statement(Nodecl::NodeclBase n)
+                {
+                    if (Nodecl::Utils::get_all_symbols(n).contains(_sym))
+                        _result = false;
+                }
+
+            public:
+                OnlyElementsAndBoundsAreUsed(TL::Symbol sym)
+                    : _sym(sym), _result(true)
+                {
+                }
+
+                bool get_result() const
+                {
+                    return _result;
+                }
+
+                virtual void visit(const Nodecl::Symbol& n)
+                {
+                    if (n.get_symbol() == _sym
+                            && !is_valid_use(n))
+                        _result = false;
+                }
+
+                virtual void visit(const Nodecl::FortranAllocateStatement& n)
+                {
+                    check_allocation_statement(n);
+                }
+
+                virtual void visit(const Nodecl::FortranDeallocateStatement& n)
+                {
+                    check_allocation_statement(n);
+                }
+        };
+    }
+
+    // Copying the descriptor of a shared ALLOCATABLE array at every task
+    // creation is expensive. When the task only uses the elements and bounds
+    // of the array, pass just its base address and bounds, like we do for
+    // explicit shape arrays
+    void OutlineInfoRegisterEntities::pass_arrays_by_base_address(Nodecl::NodeclBase statements)
+    {
+        ERROR_CONDITION(!IS_FORTRAN_LANGUAGE, "This function is only for Fortran", 0);
+
+        // The captured descriptors are removed after the loop since they
+        // are also items of data_items
+        TL::ObjectList<OutlineDataItem*> removed_descriptors;
+
+        TL::ObjectList<OutlineDataItem*> data_items = _outline_info.get_data_items();
+        for (TL::ObjectList<OutlineDataItem*>::iterator it = data_items.begin();
+                it != data_items.end();
+                it++)
+        {
+            if (removed_descriptors.contains(*it))
+                continue;
+
+            OutlineDataItem& item = *(*it);
+            TL::Symbol sym = item.get_symbol();
+
+            if (item.get_sharing() != OutlineDataItem::SHARING_SHARED
+                    || item.get_copy_of_array_descriptor() == NULL
+                    || !item.get_copies().empty()
+                    || !sym.is_valid()
+                    || !sym.is_allocatable()
+                    || sym.is_member()
+                    || sym.is_optional()
+                    || sym.is_target()
+                    || !sym.get_type().no_ref().is_fortran_array())
+                continue;
+
+            OnlyElementsAndBoundsAreUsed check_uses(sym);
+            check_uses.walk(statements);
+            if (!check_uses.get_result())
+                continue;
+
+            removed_descriptors.append(item.get_copy_of_array_descriptor());
+            item.set_copy_of_array_descriptor(NULL);
+
+            item.set_is_array_passed_by_base_address(true);
+
+            TL::Type in_outline_type = sym.get_type().no_ref().get_lvalue_reference_to();
+            in_outline_type = add_extra_dimensions(sym, in_outline_type, &item);
+            item.set_in_outline_type(in_outline_type);
+        }
+
+        for (TL::ObjectList<OutlineDataItem*>::iterator it = removed_descriptors.begin();
+                it != removed_descriptors.end();
+                it++)
+        {
+            _outline_info.remove_entity(*(*it));
+            delete *it;
+        }
+    }
+
     class OutlineInfoSetupVisitor : public Nodecl::ExhaustiveVisitor<void>, public OutlineInfoRegisterEntities
     {
         private:
@@ -1464,6 +1633,15 @@ namespace TL { namespace Nanox {
         OutlineInfoSetupVisitor setup_visitor(*this, sc, is_task_construct);
         setup_visitor.walk(environment);
 
+        if (IS_FORTRAN_LANGUAGE
+                && is_task_construct
+                && environment.get_parent().is<Nodecl::OpenMP::Task>()
+                && only_has_smp_or_mpi_implementations())
+        {
+            setup_visitor.pass_arrays_by_base_address(
+                    environment.get_parent().as<Nodecl::OpenMP::Task>().get_statements());
+        }
+
         setup_visitor.purge_saved_expressions();
 
         // Multicopies may require extra information captured. Note that OutlineInfoSetupVisitor
@@ -158,6 +158,10 @@ namespace TL
                 // referring to refers to an ALLOCATABLE array
                 bool _is_copy_of_array_descriptor_allocatable;
 
+                // This is a shared ALLOCATABLE array whose descriptor is not
+                // captured, only its base address and bounds are passed
+                bool _is_array_passed_by_base_address;
+
                 // Captured value
                 Nodecl::NodeclBase _captured_value;
                 // If not null, used to capture a value only under some conditions
@@ -189,6 +193,7 @@ namespace TL
                     _allocation_policy_flags(),
                     _copy_of_array_descriptor(NULL),
                     _is_copy_of_array_descriptor_allocatable(false),
+                    _is_array_passed_by_base_address(false),
                     _base_symbol_of_argument(),
                     _is_lastprivate(),
                     _lastprivate_shared(NULL),
@@ -444,6 +449,16 @@ namespace TL
                 {
                     _is_copy_of_array_descriptor_allocatable = b;
                 }
+
+                bool is_array_passed_by_base_address() const
+                {
+                    return _is_array_passed_by_base_address;
+                }
+
+                void set_is_array_passed_by_base_address(bool b)
+                {
+                    _is_array_passed_by_base_address = b;
+                }
         };
 
         inline OutlineDataItem::AllocationPolicyFlags operator|(OutlineDataItem::AllocationPolicyFlags a, OutlineDataItem::AllocationPolicyFlags b)
@@ -609,6 +624,8 @@ namespace TL
 
                 void add_copy_of_outline_data_item(const OutlineDataItem& ol);
 
+                void pass_arrays_by_base_address(Nodecl::NodeclBase statements);
+
                 void purge_saved_expressions();
         };
     }
@@ -36,6 +36,7 @@
 #include "tl-nodecl-utils-fortran.hpp"
 #include "tl-symbol-utils.hpp"
 #include "tl-counters.hpp"
+#include "tl-nodecl-builder.hpp"
 
 #include "codegen-phase.hpp"
 
@@ -3769,6 +3770,44 @@ namespace TL { namespace Nanos6 {
                 priority_function_code);
     }
 
+    namespace
+    {
+        // MERCURIUM_NULL()
+        Nodecl::NodeclBase make_mercurium_null(TL::Scope sc)
+        {
+            return NodeclBuilder::make_fortran_intrinsic_call(
+                    "mercurium_null",
+                    TL::ObjectList<Nodecl::NodeclBase>(),
+                    sc,
+                    make_locus("", 0, 0));
+        }
+
+        // IF (PRESENT(optional_sym)) THEN
+        //    capture_stmts
+        // ELSE
+        //    capture_null
+        // END IF
+        Nodecl::NodeclBase make_if_present(
+                TL::Symbol optional_sym,
+                const TL::ObjectList<Nodecl::NodeclBase>& capture_stmts,
+                Nodecl::NodeclBase capture_null,
+                TL::Scope sc)
+        {
+            Nodecl::NodeclBase present = NodeclBuilder::make_fortran_intrinsic_call(
+                    "present",
+                    TL::ObjectList<Nodecl::NodeclBase>(1, optional_sym.make_nodecl(/* set_ref_type */ true)),
+                    sc,
+                    optional_sym.get_locus());
+
+            return NodeclBuilder::make_fortran_if_statement(
+                    present,
+                    capture_stmts,
+                    TL::ObjectList<Nodecl::NodeclBase>(1, capture_null),
+                    sc,
+                    optional_sym.get_locus());
+        }
+    }
+
     void TaskProperties::capture_environment(
             TL::Symbol args,
             /* out */
@@ -3970,25 +4009,18 @@ namespace TL { namespace Nanos6 {
                     && it->is_parameter()
                     && it->is_optional())
             {
-                Source conditional_capture_src;
-
                 Nodecl::NodeclBase capture_null =
                     Nodecl::ExpressionStatement::make(
                             Nodecl::Assignment::make(
                                 lhs.shallow_copy(),
-                                Source("MERCURIUM_NULL()").parse_expression(_related_function.get_related_scope()),
+                                make_mercurium_null(_related_function.get_related_scope()),
                                 TL::Type::get_void_type().get_pointer_to()));
 
-                conditional_capture_src
-                    << "IF (PRESENT(" << as_symbol(*it) << ")) THEN\n"
-                    <<    as_statement(current_captured_stmts)
-                    << "ELSE\n"
-                    <<    as_statement(capture_null)
-                    << "END IF\n"
-                    ;
-
-                Nodecl::NodeclBase if_else_stmt =
-                    conditional_capture_src.parse_statement(_related_function.get_related_scope());
+                Nodecl::NodeclBase if_else_stmt = make_if_present(
+                        *it,
+                        current_captured_stmts.to_object_list(),
+                        capture_null,
+                        _related_function.get_related_scope());
 
                current_captured_stmts = Nodecl::List::make(if_else_stmt);
             }
@@ -4109,21 +4141,14 @@ namespace TL { namespace Nanos6 {
                     Nodecl::ExpressionStatement::make(
                             Nodecl::Assignment::make(
                                 lhs.shallow_copy(),
-                                Source("MERCURIUM_NULL()").parse_expression(_related_function.get_related_scope()),
+                                make_mercurium_null(_related_function.get_related_scope()),
                                 TL::Type::get_void_type().get_pointer_to()));
 
-                Source conditional_capture_src;
-
-                conditional_capture_src
-                    << "IF (PRESENT(" << as_symbol(*it) << ")) THEN\n"
-                    <<    as_statement(current_captured_stmt)
-                    << "ELSE\n"
-                    <<    as_statement(capture_null)
-                    << "END IF\n"
-                    ;
-
-                current_captured_stmt =
-                    conditional_capture_src.parse_statement(_related_function.get_related_scope());
+                current_captured_stmt = make_if_present(
+                        *it,
+                        TL::ObjectList<Nodecl::NodeclBase>(1, current_captured_stmt),
+                        capture_null,
+                        _related_function.get_related_scope());
             }
 
             captured_list.append(current_captured_stmt);
@@ -54,6 +54,22 @@ namespace TL { namespace Nanos6 {
                 _final_clause_transformation_str,
                 "0").connect(std::bind(&LoweringPhase::set_disable_final_clause_transformation, this, std::placeholders::_1));
 
+        // Constructs handled (or diagnosed) by Lower
+        add_trigger_kind(NODECL_OPEN_M_P_TASK);
+        add_trigger_kind(NODECL_OMP_SS_TASK_CALL);
+        add_trigger_kind(NODECL_OPEN_M_P_TASKLOOP);
+        add_trigger_kind(NODECL_OPEN_M_P_TASKWAIT);
+        add_trigger_kind(NODECL_OPEN_M_P_CRITICAL);
+        add_trigger_kind(NODECL_OPEN_M_P_ATOMIC);
+        add_trigger_kind(NODECL_OMP_SS_RELEASE);
+        add_trigger_kind(NODECL_OPEN_M_P_TASKYIELD);
+        add_trigger_kind(NODECL_OPEN_M_P_FOR);
+        add_trigger_kind(NODECL_OPEN_M_P_BARRIER_FULL);
+        add_trigger_kind(NODECL_OPEN_M_P_FLUSH_MEMORY);
+        add_trigger_kind(NODECL_OMP_SS_REGISTER);
+        add_trigger_kind(NODECL_OMP_SS_UNREGISTER);
+        add_trigger_kind(NODECL_OPEN_M_P_TASKGROUP);
+
         // std::cerr << "Initializing Nanos 6 lowering phase" << std::endl;
     }
 
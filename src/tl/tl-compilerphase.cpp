@@ -28,6 +28,8 @@
 
 
 #include "tl-compilerphase.hpp"
+#include "tl-nodecl.hpp"
+#include "tl-nodecl-visitor.hpp"
 
 namespace TL
 {
@@ -73,6 +75,16 @@ namespace TL
         return _parameters;
     }
 
+    void CompilerPhase::add_trigger_kind(node_t kind)
+    {
+        _trigger_kinds.insert(kind);
+    }
+
+    const std::set<node_t>& CompilerPhase::get_trigger_kinds() const
+    {
+        return _trigger_kinds;
+    }
+
     CompilerPhase::CompilerPhase()
         : _phase_name(""), 
         _phase_description(""),
@@ -100,6 +112,39 @@ namespace TL
         return _phase_status;
     }
     
+    namespace
+    {
+        class FunctionCodeCollector : public Nodecl::ExhaustiveVisitor<void>
+        {
+            public:
+                ObjectList<Nodecl::FunctionCode> functions;
+
+                virtual void visit(const Nodecl::FunctionCode& function_code)
+                {
+                    // Do not descend, nested functions are handled along with this one
+                    functions.append(function_code);
+                }
+        };
+    }
+
+    void FunctionCompilerPhase::run(DTO& data_flow)
+    {
+        Nodecl::NodeclBase top_level = *std::static_pointer_cast<Nodecl::NodeclBase>(data_flow["nodecl"]);
+
+        // Collect them first so run_on_function can modify the tree
+        FunctionCodeCollector collector;
+        collector.walk(top_level);
+
+        for (ObjectList<Nodecl::FunctionCode>::iterator it = collector.functions.begin();
+                it != collector.functions.end();
+                it++)
+        {
+            run_on_function(*it, data_flow);
+        }
+
+        commit(data_flow);
+    }
+
     void parse_boolean_option(const std::string& option_name, 
             const std::string &str_value, 
             bool &bool_value, 
@@ -33,10 +33,17 @@
 #include "tl-common.hpp"
 #include <string>
 #include <vector>
+#include <set>
+#include "cxx-asttype.h"
 #include "tl-object.hpp"
 #include "tl-dto.hpp"
 #include "tl-handler.hpp"
 
+namespace Nodecl
+{
+    class FunctionCode;
+}
+
 namespace TL
 {
     //! Represents an external compiler phase parameter
@@ -121,11 +128,20 @@ namespace TL
                 return NULL;
             }
 
+            //! States that this phase only has work to do if the tree has nodes of kind \a kind
+            /*!
+             * Call it in the constructor of the phase for every kind of node
+             * the phase handles
+             */
+            void add_trigger_kind(node_t kind);
+
         private :
             //! Status result of the phase
             PhaseStatus _phase_status;
             //! List of phase parameters
             std::vector<CompilerPhaseParameter*> _parameters;
+            //! Kinds of nodes this phase handles
+            std::set<node_t> _trigger_kinds;
 
         public:
             //! Constructor of the phase
@@ -230,6 +246,54 @@ namespace TL
 
             //! Returns a list of parameters.
             std::vector<CompilerPhaseParameter*> get_parameters() const;
+
+            //! Returns the kinds of nodes this phase handles
+            /*!
+             * The phase is not run on translation units without nodes of
+             * any of these kinds. If empty, the default, the phase is always run
+             */
+            const std::set<node_t>& get_trigger_kinds() const;
+    };
+
+    //! Base class for compiler phases whose work is done function by function
+    /*!
+      Derive from this class instead of CompilerPhase when the phase handles
+      every function of the translation unit independently of the others.
+      FunctionCompilerPhase::run collects all the Nodecl::FunctionCode of the
+      translation unit before handing them to
+      FunctionCompilerPhase::run_on_function, so a function may freely modify
+      its own body. Functions nested in another function are not handed
+      separately, they are part of the enclosing one.
+
+      Changes that are not local to the function being handled (appending new
+      nodes to the top level, for instance) must be deferred to
+      FunctionCompilerPhase::commit, which is run once all the functions have
+      been handled.
+
+      \note This class does not run functions concurrently. They are handled
+      one after the other, in the order they appear in the translation unit,
+      from the thread running the pipeline. None of the structures reachable
+      from FunctionCompilerPhase::run_on_function (scopes, symbols, types,
+      unique strings, counters, the nodecl trees) are thread-safe.
+     */
+    class LIBTL_CLASS FunctionCompilerPhase : public CompilerPhase
+    {
+        public:
+            //! Runs the phase on every function of the translation unit and then commits
+            virtual void run(DTO& data_flow);
+
+            //! Entry point of the phase for every function of the translation unit
+            /*!
+             * \param function_code The function being handled
+             * \param data_flow The data transfer object along the compiler phase pipeline
+             */
+            virtual void run_on_function(const Nodecl::FunctionCode& function_code, DTO& data_flow) = 0;
+
+            //! Serial step run after all the functions have been handled
+            /*!
+             * \param data_flow The data transfer object along the compiler phase pipeline
+             */
+            virtual void commit(DTO& data_flow) { }
     };
 
     //! Conveninence function for parsing boolean options
@@ -0,0 +1,381 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2014 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+
+  This file is part of Mercurium C/C++ source-to-source compiler.
+
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+
+#include "tl-nodecl-builder.hpp"
+#include "tl-source.hpp"
+#include "cxx-exprtype.h"
+#include "cxx-scope.h"
+#include "cxx-typeutils.h"
+#include "cxx-entrylist.h"
+#include "cxx-utils.h"
+#include "fortran03-intrinsics.h"
+#include "fortran03-scope.h"
+
+namespace NodeclBuilder
+{
+    namespace
+    {
+        // Like Source::parse_common, build the trees in the language of
+        // Source::source_language
+        struct BuildingLanguage
+        {
+            private:
+                source_language_t _kept_language;
+
+            public:
+                BuildingLanguage()
+                {
+                    TL::Source::switch_language(_kept_language);
+                }
+
+                ~BuildingLanguage()
+                {
+                    TL::Source::restore_language(_kept_language);
+                }
+        };
+
+        Nodecl::NodeclBase check_result(nodecl_t n, const char* what, const locus_t* locus)
+        {
+            ERROR_CONDITION(nodecl_is_err_expr(n),
+                    "%s: built %s is not valid", locus_to_str(locus), what);
+            return n;
+        }
+
+        // Fortran blocks are lists of statements in their own context
+        Nodecl::NodeclBase make_fortran_block(
+                const TL::ObjectList<Nodecl::NodeclBase>& statements,
+                TL::Scope sc,
+                const locus_t* locus)
+        {
+            Nodecl::List statement_list;
+            for (TL::ObjectList<Nodecl::NodeclBase>::const_iterator it = statements.begin();
+                    it != statements.end();
+                    it++)
+            {
+                statement_list.append(*it);
+            }
+
+            return Nodecl::List::make(
+                    Nodecl::Context::make(
+                        statement_list,
+                        fortran_new_block_context(sc.get_decl_context()),
+                        locus));
+        }
+    }
+
+    TL::Symbol get_function(TL::Scope sc, const std::string& name)
+    {
+        BuildingLanguage building_language;
+
+        TL::Symbol result = sc.get_symbol_from_name(name);
+        ERROR_CONDITION(!result.is_valid()
+                || !result.is_function(),
+                "Function '%s' not found", name.c_str());
+        return result;
+    }
+
+    TL::Symbol get_symbol(TL::Scope sc, const std::string& name)
+    {
+        BuildingLanguage building_language;
+
+        TL::Symbol result = sc.get_symbol_from_name(name);
+        ERROR_CONDITION(!result.is_valid(),
+                "Symbol '%s' not found", name.c_str());
+        return result;
+    }
+
+    Nodecl::NodeclBase make_symbol(TL::Symbol sym, const locus_t* locus)
+    {
+        if (sym.is_enumerator())
+        {
+            // Enumerators are not lvalues
+            Nodecl::NodeclBase result = sym.make_nodecl(/* set_ref_type */ false, locus);
+            if (!sym.get_value().is_null()
+                    && sym.get_value().is_constant())
+                result.set_constant(sym.get_value().get_constant());
+            return result;
+        }
+
+        return sym.make_nodecl(/* set_ref_type */ true, locus);
+    }
+
+    Nodecl::NodeclBase make_function_call(
+            TL::Symbol function,
+            const TL::ObjectList<Nodecl::NodeclBase>& arguments,
+            TL::Scope sc,
+            const locus_t* locus)
+    {
+        BuildingLanguage building_language;
+
+        TL::Type function_type = function.get_type();
+        bool has_ellipsis = false;
+        TL::ObjectList<TL::Type> parameters = function_type.parameters(has_ellipsis);
+
+        ERROR_CONDITION(arguments.size() < parameters.size()
+                || (arguments.size() > parameters.size() && !has_ellipsis),
+                "Wrong number of arguments in call to '%s'", function.get_name().c_str());
+
+        nodecl_t nodecl_arguments = nodecl_null();
+        unsigned int i = 0;
+        for (TL::ObjectList<Nodecl::NodeclBase>::const_iterator it = arguments.begin();
+                it != arguments.end();
+                it++, i++)
+        {
+            nodecl_t nodecl_arg = nodecl_null();
+            if (i < parameters.size())
+            {
+                check_nodecl_function_argument_initialization(
+                        it->get_internal_nodecl(),
+                        sc.get_decl_context(),
+                        parameters[i].get_internal_type(),
+                        /* disallow_narrowing */ 0,
+                        &nodecl_arg);
+                check_result(nodecl_arg, "argument", locus);
+            }
+            else
+            {
+                // Arguments of the ellipsis
+                nodecl_arg = nodecl_expression_make_rvalue(
+                        it->get_internal_nodecl(),
+                        sc.get_decl_context());
+            }
+
+            nodecl_arguments = nodecl_append_to_list(nodecl_arguments, nodecl_arg);
+        }
+
+        return check_result(
+                cxx_nodecl_make_function_call(
+                    make_symbol(function, locus).get_internal_nodecl(),
+                    /* called name */ nodecl_null(),
+                    nodecl_arguments,
+                    /* function form */ nodecl_null(),
+                    function_type.returns().get_internal_type(),
+                    sc.get_decl_context(),
+                    locus),
+                "function call", locus);
+    }
+
+    Nodecl::NodeclBase make_binary_operation(
+            node_t kind,
+            Nodecl::NodeclBase lhs,
+            Nodecl::NodeclBase rhs,
+            TL::Scope sc,
+            const locus_t* locus)
+    {
+        BuildingLanguage building_language;
+
+        nodecl_t result = nodecl_null();
+        check_nodecl_binary_expression(kind,
+                lhs.get_internal_nodecl(),
+                rhs.get_internal_nodecl(),
+                sc.get_decl_context(),
+                locus,
+                &result);
+
+        return check_result(result, "binary operation", locus);
+    }
+
+    Nodecl::NodeclBase make_expression_statement(
+            Nodecl::NodeclBase expr,
+            const locus_t* locus)
+    {
+        return Nodecl::ExpressionStatement::make(expr, locus);
+    }
+
+    Nodecl::NodeclBase make_assignment_statement(
+            Nodecl::NodeclBase lhs,
+            Nodecl::NodeclBase rhs,
+            TL::Scope sc,
+            const locus_t* locus)
+    {
+        return make_expression_statement(
+                make_binary_operation(NODECL_ASSIGNMENT, lhs, rhs, sc, locus),
+                locus);
+    }
+
+    Nodecl::NodeclBase make_if_statement(
+            Nodecl::NodeclBase condition,
+            const TL::ObjectList<Nodecl::NodeclBase>& then_statements,
+            TL::Scope sc,
+            const locus_t* locus)
+    {
+        TL::Scope if_scope = new_block_scope(sc);
+
+        {
+            BuildingLanguage building_language;
+
+            // Same conversions the frontend does for the condition of an if
+            TL::Type condition_type = IS_CXX_LANGUAGE ? TL::Type::get_bool_type() : TL::Type::get_int_type();
+            if (!condition.get_type().no_ref().is_same_type(condition_type))
+            {
+                condition = cxx_nodecl_make_conversion_to_logical(
+                        condition.get_internal_nodecl(),
+                        condition_type.get_internal_type(),
+                        if_scope.get_decl_context(),
+                        locus);
+            }
+        }
+
+        // The then part is always a compound statement
+        Nodecl::NodeclBase then_part = make_compound_statement(
+                then_statements,
+                new_block_scope(if_scope),
+                locus);
+
+        return Nodecl::Context::make(
+                Nodecl::List::make(
+                    Nodecl::IfElseStatement::make(
+                        condition,
+                        Nodecl::List::make(then_part),
+                        /* else */ Nodecl::NodeclBase::null(),
+                        locus)),
+                if_scope.get_decl_context(),
+                locus);
+    }
+
+    Nodecl::NodeclBase make_fortran_intrinsic_call(
+            const std::string& name,
+            const TL::ObjectList<Nodecl::NodeclBase>& arguments,
+            TL::Scope sc,
+            const locus_t* locus)
+    {
+        ERROR_CONDITION(!IS_FORTRAN_LANGUAGE, "This function is only for Fortran", 0);
+
+        std::vector<nodecl_t> actual_arguments;
+        for (TL::ObjectList<Nodecl::NodeclBase>::const_iterator it = arguments.begin();
+                it != arguments.end();
+                it++)
+        {
+            actual_arguments.push_back(
+                    nodecl_make_fortran_actual_argument(it->get_internal_nodecl(), locus));
+        }
+
+        scope_entry_t* generic_intrinsic = fortran_query_intrinsic_name_str(sc.get_decl_context(), name.c_str());
+        ERROR_CONDITION(generic_intrinsic == NULL, "Intrinsic '%s' not found", name.c_str());
+
+        scope_entry_t* intrinsic = fortran_solve_generic_intrinsic_call(
+                generic_intrinsic,
+                actual_arguments.empty() ? NULL : &actual_arguments[0],
+                actual_arguments.size(),
+                /* is_call */ 0);
+        ERROR_CONDITION(intrinsic == NULL,
+                "%s: built call to intrinsic '%s' is not valid", locus_to_str(locus), name.c_str());
+
+        nodecl_t simplified = nodecl_null();
+        fortran_simplify_specific_intrinsic_call(intrinsic,
+                actual_arguments.empty() ? NULL : &actual_arguments[0],
+                actual_arguments.size(),
+                &simplified,
+                locus);
+        if (!nodecl_is_null(simplified))
+            return simplified;
+
+        nodecl_t nodecl_arguments = nodecl_null();
+        for (std::vector<nodecl_t>::iterator it = actual_arguments.begin();
+                it != actual_arguments.end();
+                it++)
+        {
+            nodecl_arguments = nodecl_append_to_list(nodecl_arguments, nodecl_get_child(*it, 0));
+        }
+
+        nodecl_t nodecl_called = nodecl_make_symbol(intrinsic, locus);
+        nodecl_set_type(nodecl_called, lvalue_ref(intrinsic->type_information));
+
+        return nodecl_make_function_call(
+                nodecl_called,
+                nodecl_arguments,
+                /* generic spec */ nodecl_null(),
+                /* function form */ nodecl_null(),
+                function_type_get_return_type(intrinsic->type_information),
+                locus);
+    }
+
+    Nodecl::NodeclBase make_fortran_if_statement(
+            Nodecl::NodeclBase condition,
+            const TL::ObjectList<Nodecl::NodeclBase>& then_statements,
+            const TL::ObjectList<Nodecl::NodeclBase>& else_statements,
+            TL::Scope sc,
+            const locus_t* locus)
+    {
+        ERROR_CONDITION(!IS_FORTRAN_LANGUAGE, "This function is only for Fortran", 0);
+
+        Nodecl::NodeclBase else_part;
+        if (!else_statements.empty())
+            else_part = make_fortran_block(else_statements, sc, locus);
+
+        return Nodecl::IfElseStatement::make(
+                condition,
+                make_fortran_block(then_statements, sc, locus),
+                else_part,
+                locus);
+    }
+
+    TL::Scope new_block_scope(TL::Scope sc)
+    {
+        return TL::Scope(new_block_context(sc.get_decl_context()));
+    }
+
+    TL::Symbol new_local_variable(
+            TL::Scope block_scope,
+            const std::string& name,
+            TL::Type t,
+            const locus_t* locus)
+    {
+        TL::Symbol result = block_scope.new_symbol(name);
+        scope_entry_t* entry = result.get_internal_symbol();
+        entry->kind = SK_VARIABLE;
+        entry->type_information = t.get_internal_type();
+        entry->locus = locus;
+        entry->defined = 1;
+        symbol_entity_specs_set_is_user_declared(entry, 1);
+
+        return result;
+    }
+
+    Nodecl::NodeclBase make_compound_statement(
+            const TL::ObjectList<Nodecl::NodeclBase>& statements,
+            TL::Scope block_scope,
+            const locus_t* locus)
+    {
+        Nodecl::List statement_list;
+        for (TL::ObjectList<Nodecl::NodeclBase>::const_iterator it = statements.begin();
+                it != statements.end();
+                it++)
+        {
+            statement_list.append(*it);
+        }
+
+        return Nodecl::Context::make(
+                Nodecl::List::make(
+                    Nodecl::CompoundStatement::make(
+                        statement_list,
+                        /* finalize */ Nodecl::NodeclBase::null(),
+                        locus)),
+                block_scope.get_decl_context(),
+                locus);
+    }
+}
@@ -0,0 +1,119 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2014 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+
+  This file is part of Mercurium C/C++ source-to-source compiler.
+
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+
+#ifndef TL_NODECL_BUILDER_HPP
+#define TL_NODECL_BUILDER_HPP
+
+#include "tl-common.hpp"
+#include "tl-nodecl.hpp"
+#include "tl-symbol.hpp"
+#include "tl-scope.hpp"
+#include "tl-type.hpp"
+#include "tl-objectlist.hpp"
+
+// Builds typed nodecl directly instead of parsing a TL::Source. Trees are
+// built for the language in TL::Source::source_language and are checked by
+// the frontend like the parsed ones
+namespace NodeclBuilder
+{
+    // These fail if the symbol cannot be found in sc
+    TL::Symbol get_function(TL::Scope sc, const std::string& name);
+    TL::Symbol get_symbol(TL::Scope sc, const std::string& name);
+
+    // Reference to a variable, an enumerator or a function
+    Nodecl::NodeclBase make_symbol(TL::Symbol sym, const locus_t* locus);
+
+    // function(arguments), arguments are converted to the parameter types
+    Nodecl::NodeclBase make_function_call(
+            TL::Symbol function,
+            const TL::ObjectList<Nodecl::NodeclBase>& arguments,
+            TL::Scope sc,
+            const locus_t* locus);
+
+    // lhs <op> rhs where kind is the kind of the nodecl (e.g. NODECL_DIFFERENT)
+    Nodecl::NodeclBase make_binary_operation(
+            node_t kind,
+            Nodecl::NodeclBase lhs,
+            Nodecl::NodeclBase rhs,
+            TL::Scope sc,
+            const locus_t* locus);
+
+    // expr;
+    Nodecl::NodeclBase make_expression_statement(
+            Nodecl::NodeclBase expr,
+            const locus_t* locus);
+
+    // lhs = rhs;
+    Nodecl::NodeclBase make_assignment_statement(
+            Nodecl::NodeclBase lhs,
+            Nodecl::NodeclBase rhs,
+            TL::Scope sc,
+            const locus_t* locus);
+
+    // if (condition) { then_statements }
+    Nodecl::NodeclBase make_if_statement(
+            Nodecl::NodeclBase condition,
+            const TL::ObjectList<Nodecl::NodeclBase>& then_statements,
+            TL::Scope sc,
+            const locus_t* locus);
+
+    // Fortran only: call to the intrinsic 'name' with positional arguments.
+    // Like in the frontend, calls that can be simplified, e.g. LBOUND of an
+    // array with constant bounds, are returned simplified
+    Nodecl::NodeclBase make_fortran_intrinsic_call(
+            const std::string& name,
+            const TL::ObjectList<Nodecl::NodeclBase>& arguments,
+            TL::Scope sc,
+            const locus_t* locus);
+
+    // Fortran only: IF (condition) THEN then_statements ELSE else_statements END IF
+    // The ELSE part is omitted if else_statements is empty
+    Nodecl::NodeclBase make_fortran_if_statement(
+            Nodecl::NodeclBase condition,
+            const TL::ObjectList<Nodecl::NodeclBase>& then_statements,
+            const TL::ObjectList<Nodecl::NodeclBase>& else_statements,
+            TL::Scope sc,
+            const locus_t* locus);
+
+    // Scope of a new compound statement nested in sc
+    TL::Scope new_block_scope(TL::Scope sc);
+
+    // Declares a variable in block_scope, like 'T name;'
+    TL::Symbol new_local_variable(
+            TL::Scope block_scope,
+            const std::string& name,
+            TL::Type t,
+            const locus_t* locus);
+
+    // { statements } where block_scope has been created with new_block_scope
+    Nodecl::NodeclBase make_compound_statement(
+            const TL::ObjectList<Nodecl::NodeclBase>& statements,
+            TL::Scope block_scope,
+            const locus_t* locus);
+}
+
+#endif // TL_NODECL_BUILDER_HPP
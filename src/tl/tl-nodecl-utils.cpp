@@ -27,6 +27,7 @@
 #include "tl-nodecl-utils.hpp"
 #include "tl-counters.hpp"
 #include "tl-predicateutils.hpp"
+#include "tl-objectset.hpp"
 #include "cxx-cexpr.h"
 #include "cxx-nodecl-deep-copy.h"
 #include "cxx-utils.h"
@@ -36,7 +37,7 @@
 
 namespace Nodecl
 {
-    static void get_all_symbols_rec(Nodecl::NodeclBase n, TL::ObjectList<TL::Symbol>& result)
+    static void get_all_symbols_rec(Nodecl::NodeclBase n, TL::ObjectSet<TL::Symbol>& result)
     {
         if (n.is_null())
             return;
@@ -67,9 +68,9 @@ namespace Nodecl
 
     TL::ObjectList<TL::Symbol> Utils::get_all_symbols(Nodecl::NodeclBase n)
     {
-        TL::ObjectList<TL::Symbol> sym_list;
-        get_all_symbols_rec(n, sym_list);
-        return sym_list;
+        TL::ObjectSet<TL::Symbol> sym_set;
+        get_all_symbols_rec(n, sym_set);
+        return sym_set.as_list();
     }
 
     struct IsLocalSymbol
@@ -201,7 +202,9 @@ namespace Nodecl
         return get_all_symbols_occurrences(n).filter(local);
     }
 
-    static void get_all_symbols_first_occurrence_rec(Nodecl::NodeclBase n, TL::ObjectList<Nodecl::Symbol> &result)
+    static void get_all_symbols_first_occurrence_rec(Nodecl::NodeclBase n,
+            TL::ObjectSet<TL::Symbol>& seen,
+            TL::ObjectList<Nodecl::Symbol> &result)
     {
         if (n.is_null())
             return;
@@ -210,12 +213,12 @@ namespace Nodecl
                 // Ignore the internal symbol which represents the C++ NULL constant
                 && n.as<Nodecl::Symbol>().get_symbol().get_name() != "__null")
         {
-            result.insert<TL::Symbol>(n.as<Nodecl::Symbol>(),
-                   &Nodecl::Symbol::get_symbol);
+            if (seen.insert(n.get_symbol()))
+                result.append(n.as<Nodecl::Symbol>());
         }
         else if (n.is<Nodecl::ObjectInit>())
         {
-            get_all_symbols_first_occurrence_rec(n.get_symbol().get_value(), result);
+            get_all_symbols_first_occurrence_rec(n.get_symbol().get_value(), seen, result);
         }
 
         Nodecl::NodeclBase::Children children = n.children();
@@ -223,14 +226,15 @@ namespace Nodecl
                 it != children.end();
                 it++)
         {
-            get_all_symbols_first_occurrence_rec(*it, result);
+            get_all_symbols_first_occurrence_rec(*it, seen, result);
         }
     }
 
     TL::ObjectList<Nodecl::Symbol> Utils::get_all_symbols_first_occurrence(Nodecl::NodeclBase n)
     {
+        TL::ObjectSet<TL::Symbol> seen;
         TL::ObjectList<Nodecl::Symbol> result;
-        get_all_symbols_first_occurrence_rec(n, result);
+        get_all_symbols_first_occurrence_rec(n, seen, result);
         return result;
     }
 
@@ -247,7 +251,7 @@ namespace Nodecl
     }
 
     static void get_all_memory_accesses_rec(Nodecl::NodeclBase n, bool in_ref, bool in_class_member,
-                                            TL::ObjectList<Nodecl::NodeclBase>& result)
+                                            TL::ObjectSet<Nodecl::NodeclBase>& result)
     {
         if (n.is_null())
             return;
@@ -303,9 +307,9 @@ namespace Nodecl
 
     TL::ObjectList<Nodecl::NodeclBase> Utils::get_all_memory_accesses(Nodecl::NodeclBase n)
     {
-        TL::ObjectList<Nodecl::NodeclBase> obj_list;
-        get_all_memory_accesses_rec(n, /*in ref*/false, /*only subscripts*/false, obj_list);
-        return obj_list;
+        TL::ObjectSet<Nodecl::NodeclBase> obj_set;
+        get_all_memory_accesses_rec(n, /*in ref*/false, /*only subscripts*/false, obj_set);
+        return obj_set.as_list();
     }
 
     static int cmp_trees_rec(nodecl_t n1, nodecl_t n2, bool skip_conversion_nodes)
@@ -798,6 +802,56 @@ namespace Nodecl
         return cmp_trees_rec(n1_, n2_, skip_conversion_nodes) < 0;
     }
 
+    static size_t hash_combine(size_t seed, size_t value)
+    {
+        return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+    }
+
+    static size_t structural_hash_rec(nodecl_t n)
+    {
+        // Conversions are skipped when comparing trees
+        while (!nodecl_is_null(n)
+                && nodecl_get_kind(n) == NODECL_CONVERSION)
+            n = nodecl_get_child(n, 0);
+
+        if (nodecl_is_null(n))
+            return 0;
+
+        size_t hash = nodecl_get_kind(n);
+
+        // Trees are compared by the address of their symbols but
+        // their names are hashed instead so iterating a hashed set
+        // gives the same order in every run
+        scope_entry_t* sym = nodecl_get_symbol(n);
+        if (sym != NULL && sym->symbol_name != NULL)
+        {
+            for (const char* c = sym->symbol_name; *c != '\0'; c++)
+                hash = hash_combine(hash, *c);
+        }
+
+        // Object and address constants are ignored when comparing trees
+        const_value_t* cval = nodecl_get_constant(n);
+        if (cval != NULL
+                && const_value_is_integer(cval))
+        {
+            hash = hash_combine(hash, const_value_cast_to_8(cval));
+        }
+
+        for (int i = 0; i < MCXX_MAX_AST_CHILDREN; i++)
+        {
+            nodecl_t child = nodecl_get_child(n, i);
+            if (!nodecl_is_null(child))
+                hash = hash_combine(hash, hash_combine(i, structural_hash_rec(child)));
+        }
+
+        return hash;
+    }
+
+    size_t Utils::structural_hash_nodecl(const Nodecl::NodeclBase& n)
+    {
+        return structural_hash_rec(n.get_internal_nodecl());
+    }
+
     size_t Utils::Nodecl_hash::operator() (const Nodecl::NodeclBase& n) const
     {
         return nodecl_hash_table(n.get_internal_nodecl());
@@ -813,6 +867,16 @@ namespace Nodecl
         return structurally_less_nodecls(n1, n2, /*skip_conversion_nodes*/true);
     }
 
+    size_t Utils::Nodecl_structural_hash::operator() (const Nodecl::NodeclBase& n) const
+    {
+        return structural_hash_nodecl(n);
+    }
+
+    bool Utils::Nodecl_structural_equal_skip_conversions::operator() (const Nodecl::NodeclBase& n1, const Nodecl::NodeclBase& n2) const
+    {
+        return structurally_equal_nodecls(n1, n2, /*skip_conversion_nodecls*/true);
+    }
+
     Nodecl::List Utils::get_all_list_from_list_node(Nodecl::List n)
     {
         while (n.get_parent().is<Nodecl::List>())
@@ -75,6 +75,11 @@ namespace Utils {
                                  bool skip_conversion_nodecls = false);
     bool structurally_less_nodecls(Nodecl::NodeclBase n1, Nodecl::NodeclBase n2,
                                  bool skip_conversion_nodecls = false);
+
+    // Hash of a tree that is the same for trees that are structurally equal
+    // when skipping conversions. It does not depend on addresses, thus
+    // it is the same between runs
+    size_t structural_hash_nodecl(const Nodecl::NodeclBase& n);
  
     struct Nodecl_hash {
         size_t operator() (const Nodecl::NodeclBase& n) const;
@@ -88,6 +93,15 @@ namespace Utils {
         bool operator() (const Nodecl::NodeclBase& n1, const Nodecl::NodeclBase& n2) const;
     };
 
+    // Hash and equality of trees skipping conversions, like Nodecl_structural_less
+    struct Nodecl_structural_hash {
+        size_t operator() (const Nodecl::NodeclBase& n) const;
+    };
+
+    struct Nodecl_structural_equal_skip_conversions {
+        bool operator() (const Nodecl::NodeclBase& n1, const Nodecl::NodeclBase& n2) const;
+    };
+
     // Basic replacement
     //
     // After this operation dest will be updated to have the same contents
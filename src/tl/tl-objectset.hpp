@@ -0,0 +1,219 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2014 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+  
+  This file is part of Mercurium C/C++ source-to-source compiler.
+  
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+  
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+  
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+
+
+
+#ifndef TL_OBJECTSET_HPP
+#define TL_OBJECTSET_HPP
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "tl-common.hpp"
+#include "tl-objectlist.hpp"
+#include "tl-symbol.hpp"
+#include "tl-nodecl-base.hpp"
+#include <tr1/unordered_set>
+
+namespace TL
+{
+//! \addtogroup ObjectList Lists of objects
+//! @{
+
+//! Hash functor used by ObjectSet
+/*!
+ * It must agree with operator== of T
+ */
+template <class T>
+struct ObjectSetHash
+{
+    size_t operator()(const T& t) const
+    {
+        return std::tr1::hash<T>()(t);
+    }
+};
+
+template <>
+struct ObjectSetHash<TL::Symbol>
+{
+    size_t operator()(const TL::Symbol& sym) const
+    {
+        return std::tr1::hash<scope_entry_t*>()(sym.get_internal_symbol());
+    }
+};
+
+// Nodecl::NodeclBase::operator== compares the trees by identity
+template <>
+struct ObjectSetHash<Nodecl::NodeclBase>
+{
+    size_t operator()(const Nodecl::NodeclBase& n) const
+    {
+        return std::tr1::hash<AST>()(nodecl_get_ast(n.get_internal_nodecl()));
+    }
+};
+
+//! A set of objects that keeps the order of insertion
+/*!
+ * Unlike ObjectList::insert, that has to look for the element in the whole
+ * list, inserting or looking for an element here is done in constant time.
+ * Iterating an ObjectSet yields its elements in the order they were first
+ * inserted, thus it can replace an ObjectList used as a set without
+ * changing the order of the results.
+ */
+template <class T, class Hash = ObjectSetHash<T> >
+class ObjectSet : public TL::Object
+{
+    private:
+        ObjectList<T> _elements;
+        std::tr1::unordered_set<T, Hash> _index;
+
+    public:
+        typedef typename ObjectList<T>::const_iterator iterator;
+        typedef typename ObjectList<T>::const_iterator const_iterator;
+        typedef typename ObjectList<T>::size_type size_type;
+        typedef T value_type;
+
+        ObjectSet()
+            : _elements(), _index()
+        {
+        }
+
+        //! Creates a set with the elements of \a l
+        explicit ObjectSet(const ObjectList<T>& l)
+            : _elements(), _index()
+        {
+            insert(l);
+        }
+
+        virtual ~ObjectSet()
+        {
+        }
+
+        const_iterator begin() const
+        {
+            return _elements.begin();
+        }
+
+        const_iterator end() const
+        {
+            return _elements.end();
+        }
+
+        size_type size() const
+        {
+            return _elements.size();
+        }
+
+        bool empty() const
+        {
+            return _elements.empty();
+        }
+
+        void clear()
+        {
+            _elements.clear();
+            _index.clear();
+        }
+
+        //! Inserts element if it was not already in
+        /*!
+         * \param t Element to be inserted once
+         * \return true if \a t has been inserted
+         */
+        bool insert(const T& t)
+        {
+            if (!_index.insert(t).second)
+                return false;
+
+            _elements.push_back(t);
+            return true;
+        }
+
+        //! Inserts the elements of a list that are not already in
+        ObjectSet<T, Hash>& insert(const ObjectList<T>& l)
+        {
+            for (typename ObjectList<T>::const_iterator it = l.begin();
+                    it != l.end();
+                    it++)
+            {
+                insert(*it);
+            }
+            return *this;
+        }
+
+        //! Inserts the elements of another set that are not already in
+        ObjectSet<T, Hash>& insert(const ObjectSet<T, Hash>& s)
+        {
+            return insert(s._elements);
+        }
+
+        //! States whether \a t is in the set
+        bool contains(const T& t) const
+        {
+            return _index.find(t) != _index.end();
+        }
+
+        //! Filters the set using the given predicate
+        /*!
+         * \return A list with the elements, in order of insertion, that satisfy \a p
+         */
+        ObjectList<T> filter(const std::function<bool(const T&)>& p) const
+        {
+            return _elements.filter(p);
+        }
+
+        //! Applies a given functor to the elements of the set in order of insertion
+        template <class S>
+        ObjectList<S> map(const std::function<S(const T&)> &f) const
+        {
+            return _elements.template map<S>(f);
+        }
+
+        //! Applies a given functor to the elements of the set in order of insertion
+        void map(const std::function<void(const T&)> & f) const
+        {
+            _elements.map(f);
+        }
+
+        //! Returns the elements of the set in order of insertion
+        const ObjectList<T>& as_list() const
+        {
+            return _elements;
+        }
+
+        operator const ObjectList<T>&() const
+        {
+            return _elements;
+        }
+};
+
+//! @}
+
+}
+
+#endif // TL_OBJECTSET_HPP
@@ -33,6 +33,7 @@
 #include "cxx-diagnostic.h"
 #include "tl-pragmasupport.hpp"
 #include "tl-nodecl-utils.hpp"
+#include "cxx-driver-decls.h"
 
 namespace TL
 {
@@ -128,6 +129,13 @@ namespace TL
     {
     }
 
+    void PragmaCustomCompilerPhase::add_pragma_trigger_kinds()
+    {
+        add_trigger_kind(NODECL_PRAGMA_CUSTOM_DIRECTIVE);
+        add_trigger_kind(NODECL_PRAGMA_CUSTOM_STATEMENT);
+        add_trigger_kind(NODECL_PRAGMA_CUSTOM_DECLARATION);
+    }
+
     void PragmaCustomCompilerPhase::pre_run(DTO& data_flow)
     {
         // Do nothing
@@ -137,7 +145,41 @@ namespace TL
     {
         Nodecl::NodeclBase node = *std::static_pointer_cast<Nodecl::NodeclBase>(data_flow["nodecl"]);
 
-        this->walk(node);
+        if (node.is<Nodecl::TopLevel>()
+                && !debug_options.do_not_index_pragmas)
+        {
+            this->walk_indexed(data_flow, node);
+        }
+        else
+        {
+            this->walk(node);
+        }
+    }
+
+    void PragmaCustomCompilerPhase::walk_indexed(DTO& data_flow, Nodecl::NodeclBase& node)
+    {
+        std::shared_ptr<PragmaIndex> pragma_index =
+            std::dynamic_pointer_cast<PragmaIndex>(data_flow["pragma_index"]);
+
+        if (pragma_index == NULL
+                || !pragma_index->is_up_to_date(node))
+        {
+            pragma_index = std::shared_ptr<PragmaIndex>(new PragmaIndex(node));
+            data_flow.set_object("pragma_index", pragma_index);
+        }
+
+        PragmaVisitor visitor(_pragma_map_dispatcher, _ignore_template_functions);
+
+        // The list is traversed as the visitor would, so items added by
+        // the handlers are walked too
+        Nodecl::List top_level_items = node.as<Nodecl::TopLevel>().get_top_level().as<Nodecl::List>();
+        for (Nodecl::List::iterator it = top_level_items.begin();
+                it != top_level_items.end();
+                it++)
+        {
+            if (pragma_index->may_contain_pragmas(*it))
+                visitor.walk(*it);
+        }
     }
 
     void PragmaCustomCompilerPhase::walk(Nodecl::NodeclBase& node)
@@ -146,6 +188,68 @@ namespace TL
         visitor.walk(node);
     }
 
+    namespace
+    {
+        class HasPragmasVisitor : public Nodecl::ExhaustiveVisitor<void>
+        {
+            public:
+                bool has_pragmas;
+
+                HasPragmasVisitor()
+                    : has_pragmas(false)
+                {
+                }
+
+                virtual void visit(const Nodecl::PragmaCustomDirective& n)
+                {
+                    has_pragmas = true;
+                }
+
+                virtual void visit(const Nodecl::PragmaCustomStatement& n)
+                {
+                    has_pragmas = true;
+                }
+
+                virtual void visit(const Nodecl::PragmaCustomDeclaration& n)
+                {
+                    has_pragmas = true;
+                }
+        };
+    }
+
+    PragmaIndex::PragmaIndex(Nodecl::NodeclBase top_level)
+        : _top_level(nodecl_get_ast(top_level.get_internal_nodecl())),
+        _num_pragma_custom_made(nodecl_get_num_pragma_custom_made())
+    {
+        Nodecl::List top_level_items = top_level.as<Nodecl::TopLevel>().get_top_level().as<Nodecl::List>();
+        for (Nodecl::List::iterator it = top_level_items.begin();
+                it != top_level_items.end();
+                it++)
+        {
+            HasPragmasVisitor has_pragmas_visitor;
+            has_pragmas_visitor.walk(*it);
+
+            ItemInfo& item_info = _items[nodecl_get_ast(it->get_internal_nodecl())];
+            item_info.has_pragmas = has_pragmas_visitor.has_pragmas;
+            item_info.modification_count = nodecl_get_modification_count(it->get_internal_nodecl());
+        }
+    }
+
+    bool PragmaIndex::is_up_to_date(Nodecl::NodeclBase top_level) const
+    {
+        return _top_level == nodecl_get_ast(top_level.get_internal_nodecl())
+            && _num_pragma_custom_made == nodecl_get_num_pragma_custom_made();
+    }
+
+    bool PragmaIndex::may_contain_pragmas(Nodecl::NodeclBase item) const
+    {
+        std::map<AST, ItemInfo>::const_iterator it = _items.find(
+                nodecl_get_ast(item.get_internal_nodecl()));
+        return it == _items.end()
+            || it->second.has_pragmas
+            || it->second.modification_count != nodecl_get_modification_count(item.get_internal_nodecl());
+    }
+
     void PragmaCustomCompilerPhase::register_directive(
             const std::string& pragma_handled,
             const std::string& str)
@@ -33,6 +33,7 @@
 #include "tl-common.hpp"
 #include <string>
 #include <stack>
+#include <map>
 #include <algorithm>
 #include "tl-clauses-info.hpp"
 #include "tl-compilerphase.hpp"
@@ -527,6 +528,37 @@ namespace TL
             }
     };
 
+    //! Index of the top level items of a translation unit that contain pragmas
+    /*!
+     * It is built with a single walk of the whole tree and shared, through
+     * the DTO, by all the PragmaCustomCompilerPhase of the pipeline, so every
+     * phase only walks the top level items that may contain pragmas.
+     *
+     * The index is stale once new pragma nodes have been created (parsed,
+     * built or copied) since it was built. Top level items not seen when
+     * building the index are always walked, and so are the items modified
+     * since then (see nodecl_get_modification_count), as an existing pragma
+     * subtree may have been moved into them.
+     */
+    class LIBTL_CLASS PragmaIndex : public Object
+    {
+        private:
+            AST _top_level;
+            unsigned int _num_pragma_custom_made;
+
+            struct ItemInfo
+            {
+                bool has_pragmas;
+                unsigned int modification_count;
+            };
+            std::map<AST, ItemInfo> _items;
+        public:
+            PragmaIndex(Nodecl::NodeclBase top_level);
+
+            bool is_up_to_date(Nodecl::NodeclBase top_level) const;
+            bool may_contain_pragmas(Nodecl::NodeclBase item) const;
+    };
+
     //! Base class for all compiler phases working on user defined pragma lines
     /*!
      * Configuration of mcxx will require a 'pragma_prefix' line in order
@@ -539,9 +571,14 @@ namespace TL
         private:
             PragmaMapDispatcher _pragma_map_dispatcher;
             bool _ignore_template_functions;
+
+            void walk_indexed(DTO& data_flow, Nodecl::NodeclBase& node);
         protected:
             SinglePragmaMapDispatcher& dispatcher(const std::string &pragma_handled);
 
+            //! States that this phase only has work to do if the tree has pragmas
+            void add_pragma_trigger_kinds();
+
             void set_ignore_template_functions(bool b) { _ignore_template_functions = b; }
             bool get_ignore_template_functions() const { return _ignore_template_functions; };
         public:
@@ -555,7 +592,9 @@ namespace TL
 
             //! Entry point of the phase
             /*!
-             * This function calls PragmaCustomCompilerPhase::walk
+             * Like PragmaCustomCompilerPhase::walk but only the top level
+             * items that have pragmas, according to the PragmaIndex, are
+             * walked
              */
             virtual void run(DTO& data_flow);
 
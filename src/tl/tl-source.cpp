@@ -46,10 +46,75 @@
 #include <sstream>
 #include <iomanip>
 #include <cstring>
+#include <map>
 
 namespace TL
 {
     SourceLanguage Source::source_language;
+    unsigned int Source::_num_parsed_fragments = 0;
+    unsigned int Source::_num_reused_fragments = 0;
+
+    unsigned int Source::get_num_parsed_fragments()
+    {
+        return _num_parsed_fragments;
+    }
+
+    unsigned int Source::get_num_reused_fragments()
+    {
+        return _num_reused_fragments;
+    }
+
+    void Source::reset_num_parsed_fragments()
+    {
+        _num_parsed_fragments = 0;
+        _num_reused_fragments = 0;
+    }
+
+    namespace
+    {
+        // The parse tree only depends on the parser and the text, the
+        // subparsing prefix included. Names are looked up later, during the
+        // semantic analysis, which changes the tree when it solves the
+        // ambiguities. So what is kept is a pristine copy of the tree
+        struct ParseCacheKey
+        {
+            source_language_t language;
+            int (*parse)(AST*);
+            std::string text;
+
+            bool operator<(const ParseCacheKey& k) const
+            {
+                if (language != k.language)
+                    return language < k.language;
+                if (parse != k.parse)
+                    return parse < k.parse;
+                return text < k.text;
+            }
+        };
+
+        typedef std::map<ParseCacheKey, AST> parse_cache_t;
+        parse_cache_t _parse_cache;
+
+        bool can_cache_parse(const std::string& text)
+        {
+            return !debug_options.do_not_cache_tl_source
+                // Embedded trees and statement placeholders are moved into
+                // the result, they cannot be used twice
+                && text.find("@NODECL-LITERAL-") == std::string::npos
+                && text.find("@STATEMENT-PH::") == std::string::npos;
+        }
+    }
+
+    void Source::clear_parse_cache()
+    {
+        for (parse_cache_t::iterator it = _parse_cache.begin();
+                it != _parse_cache.end();
+                it++)
+        {
+            ast_free(it->second);
+        }
+        _parse_cache.clear();
+    }
 
     ReferenceScope::ReferenceScope(Scope sc)
         : _scope(sc)
@@ -480,6 +545,8 @@ namespace TL
             decl_context_map_fun_t decl_context_map_fun)
     {
 
+        _num_parsed_fragments++;
+
         source_language_t kept_language;
         switch_language(kept_language);
 
@@ -487,17 +554,38 @@ namespace TL
 
         std::string mangled_text = subparsing_prefix + extended_source;
 
-        prepare_lexer(mangled_text.c_str());
-
-        int parse_result = 0;
         AST a = NULL;
 
-        parse_result = parse(&a);
+        ParseCacheKey cache_key;
+        cache_key.language = CURRENT_CONFIGURATION->source_language;
+        cache_key.parse = parse;
+        cache_key.text = mangled_text;
 
-        if (parse_result != 0)
+        bool use_cache = can_cache_parse(mangled_text);
+        parse_cache_t::iterator it_cache = _parse_cache.end();
+        if (use_cache)
+            it_cache = _parse_cache.find(cache_key);
+
+        if (it_cache != _parse_cache.end())
         {
-            fatal_error("Could not parse source\n\n%s\n", 
-                    format_source(extended_source).c_str());
+            _num_reused_fragments++;
+            a = ast_copy(it_cache->second);
+        }
+        else
+        {
+            prepare_lexer(mangled_text.c_str());
+
+            int parse_result = 0;
+            parse_result = parse(&a);
+
+            if (parse_result != 0)
+            {
+                fatal_error("Could not parse source\n\n%s\n", 
+                        format_source(extended_source).c_str());
+            }
+
+            if (use_cache)
+                _parse_cache[cache_key] = ast_copy(a);
         }
 
         const decl_context_t* decl_context = decl_context_map_fun(ref_scope.get_scope().get_decl_context());
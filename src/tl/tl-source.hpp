@@ -226,6 +226,9 @@ namespace TL
         private:
             chunk_list_ref_t _chunk_list;
 
+            static unsigned int _num_parsed_fragments;
+            static unsigned int _num_reused_fragments;
+
             void append_text_chunk(const std::string& str);
             void append_source_ref(SourceChunkRef src);
 
@@ -242,10 +245,28 @@ namespace TL
                     compute_nodecl_fun_t compute_nodecl,
                     decl_context_map_fun_t decl_context_map_fun);
 
+        public:
+            //! Switches the current language to source_language
+            /*!
+             * The previous language is kept in \a n so it can be restored
+             * later with restore_language
+             */
             static void switch_language(source_language_t& n);
             static void restore_language(source_language_t n);
 
-        public:
+            //! Number of sources parsed since the last reset
+            static unsigned int get_num_parsed_fragments();
+            //! Number of those whose parse tree was copied from an identical fragment
+            static unsigned int get_num_reused_fragments();
+            static void reset_num_parsed_fragments();
+
+            //! Forgets the parse trees kept for identical fragments
+            /*!
+             * Only the parse tree is reused. The semantic analysis of every
+             * fragment is always done in its own scope
+             */
+            static void clear_parse_cache();
+
             //! Constructor
             /*!
              * Creates an empty source
@@ -536,7 +536,7 @@ namespace Vectorization
         const Nodecl::NodeclBase& scope,
         const Nodecl::NodeclBase& n)
     {
-        std::set<Nodecl::NodeclBase, Nodecl::Utils::Nodecl_structural_less> lower_bounds
+        Analysis::NodeclSet lower_bounds
                 = Analysis::AnalysisInterface::get_induction_variable_lower_bound_list(
                         translate_input(scope), translate_input(n));
 
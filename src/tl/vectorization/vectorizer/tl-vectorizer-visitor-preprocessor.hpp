@@ -27,14 +27,15 @@
 #ifndef TL_VECTORIZER_VISITOR_PREPROCESSOR_HPP 
 #define TL_VECTORIZER_VISITOR_PREPROCESSOR_HPP
 
-#include "tl-nodecl-visitor.hpp" 
+#include "tl-nodecl-static-visitor.hpp"
 #include "tl-vectorizer.hpp"
 
 namespace TL
 { 
 namespace Vectorization
 { 
-    class VectorizerVisitorPreprocessor : public Nodecl::ExhaustiveVisitor<void> 
+    class VectorizerVisitorPreprocessor
+        : public Nodecl::StaticExhaustiveVisitor<VectorizerVisitorPreprocessor>
     {
         private:
 //            const VectorizerEnvironment& _environment;
@@ -49,6 +50,8 @@ namespace Vectorization
             VectorizerVisitorPreprocessor();
  //                   const VectorizerEnvironment& environment);
 
+            using Nodecl::StaticExhaustiveVisitor<VectorizerVisitorPreprocessor>::visit;
+
             void visit(const Nodecl::ObjectInit& n);
             void visit(const Nodecl::ArraySubscript& n);
 
@@ -0,0 +1,920 @@
+! <testinfo>
+! test_generator=config/mercurium-fortran
+! </testinfo>
+
+! Many external procedures called through implicit interfaces before being
+! defined in the same file. Every call is resolved to its definition
+PROGRAM MAIN
+    IMPLICIT NONE
+    INTEGER, EXTERNAL :: F001, F002, F003, F004, F005, F006, F007, F008
+    INTEGER, EXTERNAL :: F009, F010, F011, F012, F013, F014, F015, F016
+    INTEGER, EXTERNAL :: F017, F018, F019, F020, F021, F022, F023, F024
+    INTEGER, EXTERNAL :: F025, F026, F027, F028, F029, F030, F031, F032
+    INTEGER, EXTERNAL :: F033, F034, F035, F036, F037, F038, F039, F040
+    INTEGER, EXTERNAL :: F041, F042, F043, F044, F045, F046, F047, F048
+    INTEGER, EXTERNAL :: F049, F050, F051, F052, F053, F054, F055, F056
+    INTEGER, EXTERNAL :: F057, F058, F059, F060, F061, F062, F063, F064
+    EXTERNAL :: S001
+    INTEGER :: S
+
+    S = 0
+    S = S + F001(1)
+    S = S + F002(2)
+    S = S + F003(3)
+    S = S + F004(4)
+    S = S + F005(5)
+    S = S + F006(6)
+    S = S + F007(7)
+    S = S + F008(8)
+    S = S + F009(9)
+    S = S + F010(10)
+    S = S + F011(11)
+    S = S + F012(12)
+    S = S + F013(13)
+    S = S + F014(14)
+    S = S + F015(15)
+    S = S + F016(16)
+    S = S + F017(17)
+    S = S + F018(18)
+    S = S + F019(19)
+    S = S + F020(20)
+    S = S + F021(21)
+    S = S + F022(22)
+    S = S + F023(23)
+    S = S + F024(24)
+    S = S + F025(25)
+    S = S + F026(26)
+    S = S + F027(27)
+    S = S + F028(28)
+    S = S + F029(29)
+    S = S + F030(30)
+    S = S + F031(31)
+    S = S + F032(32)
+    S = S + F033(33)
+    S = S + F034(34)
+    S = S + F035(35)
+    S = S + F036(36)
+    S = S + F037(37)
+    S = S + F038(38)
+    S = S + F039(39)
+    S = S + F040(40)
+    S = S + F041(41)
+    S = S + F042(42)
+    S = S + F043(43)
+    S = S + F044(44)
+    S = S + F045(45)
+    S = S + F046(46)
+    S = S + F047(47)
+    S = S + F048(48)
+    S = S + F049(49)
+    S = S + F050(50)
+    S = S + F051(51)
+    S = S + F052(52)
+    S = S + F053(53)
+    S = S + F054(54)
+    S = S + F055(55)
+    S = S + F056(56)
+    S = S + F057(57)
+    S = S + F058(58)
+    S = S + F059(59)
+    S = S + F060(60)
+    S = S + F061(61)
+    S = S + F062(62)
+    S = S + F063(63)
+    S = S + F064(64)
+    IF (S /= 4160) STOP 1
+
+    CALL S001(S)
+    IF (S /= 64) STOP 2
+END PROGRAM MAIN
+
+INTEGER FUNCTION F001(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F001 = X + 1
+END FUNCTION F001
+
+INTEGER FUNCTION F002(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F002 = X + 2
+END FUNCTION F002
+
+INTEGER FUNCTION F003(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F003 = X + 3
+END FUNCTION F003
+
+INTEGER FUNCTION F004(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F004 = X + 4
+END FUNCTION F004
+
+INTEGER FUNCTION F005(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F005 = X + 5
+END FUNCTION F005
+
+INTEGER FUNCTION F006(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F006 = X + 6
+END FUNCTION F006
+
+INTEGER FUNCTION F007(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F007 = X + 7
+END FUNCTION F007
+
+INTEGER FUNCTION F008(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F008 = X + 8
+END FUNCTION F008
+
+INTEGER FUNCTION F009(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F009 = X + 9
+END FUNCTION F009
+
+INTEGER FUNCTION F010(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F010 = X + 10
+END FUNCTION F010
+
+INTEGER FUNCTION F011(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F011 = X + 11
+END FUNCTION F011
+
+INTEGER FUNCTION F012(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F012 = X + 12
+END FUNCTION F012
+
+INTEGER FUNCTION F013(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F013 = X + 13
+END FUNCTION F013
+
+INTEGER FUNCTION F014(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F014 = X + 14
+END FUNCTION F014
+
+INTEGER FUNCTION F015(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F015 = X + 15
+END FUNCTION F015
+
+INTEGER FUNCTION F016(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F016 = X + 16
+END FUNCTION F016
+
+INTEGER FUNCTION F017(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F017 = X + 17
+END FUNCTION F017
+
+INTEGER FUNCTION F018(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F018 = X + 18
+END FUNCTION F018
+
+INTEGER FUNCTION F019(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F019 = X + 19
+END FUNCTION F019
+
+INTEGER FUNCTION F020(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F020 = X + 20
+END FUNCTION F020
+
+INTEGER FUNCTION F021(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F021 = X + 21
+END FUNCTION F021
+
+INTEGER FUNCTION F022(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F022 = X + 22
+END FUNCTION F022
+
+INTEGER FUNCTION F023(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F023 = X + 23
+END FUNCTION F023
+
+INTEGER FUNCTION F024(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F024 = X + 24
+END FUNCTION F024
+
+INTEGER FUNCTION F025(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F025 = X + 25
+END FUNCTION F025
+
+INTEGER FUNCTION F026(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F026 = X + 26
+END FUNCTION F026
+
+INTEGER FUNCTION F027(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F027 = X + 27
+END FUNCTION F027
+
+INTEGER FUNCTION F028(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F028 = X + 28
+END FUNCTION F028
+
+INTEGER FUNCTION F029(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F029 = X + 29
+END FUNCTION F029
+
+INTEGER FUNCTION F030(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F030 = X + 30
+END FUNCTION F030
+
+INTEGER FUNCTION F031(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F031 = X + 31
+END FUNCTION F031
+
+INTEGER FUNCTION F032(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F032 = X + 32
+END FUNCTION F032
+
+INTEGER FUNCTION F033(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F033 = X + 33
+END FUNCTION F033
+
+INTEGER FUNCTION F034(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F034 = X + 34
+END FUNCTION F034
+
+INTEGER FUNCTION F035(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F035 = X + 35
+END FUNCTION F035
+
+INTEGER FUNCTION F036(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F036 = X + 36
+END FUNCTION F036
+
+INTEGER FUNCTION F037(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F037 = X + 37
+END FUNCTION F037
+
+INTEGER FUNCTION F038(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F038 = X + 38
+END FUNCTION F038
+
+INTEGER FUNCTION F039(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F039 = X + 39
+END FUNCTION F039
+
+INTEGER FUNCTION F040(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F040 = X + 40
+END FUNCTION F040
+
+INTEGER FUNCTION F041(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F041 = X + 41
+END FUNCTION F041
+
+INTEGER FUNCTION F042(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F042 = X + 42
+END FUNCTION F042
+
+INTEGER FUNCTION F043(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F043 = X + 43
+END FUNCTION F043
+
+INTEGER FUNCTION F044(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F044 = X + 44
+END FUNCTION F044
+
+INTEGER FUNCTION F045(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F045 = X + 45
+END FUNCTION F045
+
+INTEGER FUNCTION F046(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F046 = X + 46
+END FUNCTION F046
+
+INTEGER FUNCTION F047(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F047 = X + 47
+END FUNCTION F047
+
+INTEGER FUNCTION F048(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F048 = X + 48
+END FUNCTION F048
+
+INTEGER FUNCTION F049(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F049 = X + 49
+END FUNCTION F049
+
+INTEGER FUNCTION F050(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F050 = X + 50
+END FUNCTION F050
+
+INTEGER FUNCTION F051(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F051 = X + 51
+END FUNCTION F051
+
+INTEGER FUNCTION F052(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F052 = X + 52
+END FUNCTION F052
+
+INTEGER FUNCTION F053(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F053 = X + 53
+END FUNCTION F053
+
+INTEGER FUNCTION F054(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F054 = X + 54
+END FUNCTION F054
+
+INTEGER FUNCTION F055(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F055 = X + 55
+END FUNCTION F055
+
+INTEGER FUNCTION F056(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F056 = X + 56
+END FUNCTION F056
+
+INTEGER FUNCTION F057(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F057 = X + 57
+END FUNCTION F057
+
+INTEGER FUNCTION F058(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F058 = X + 58
+END FUNCTION F058
+
+INTEGER FUNCTION F059(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F059 = X + 59
+END FUNCTION F059
+
+INTEGER FUNCTION F060(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F060 = X + 60
+END FUNCTION F060
+
+INTEGER FUNCTION F061(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F061 = X + 61
+END FUNCTION F061
+
+INTEGER FUNCTION F062(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F062 = X + 62
+END FUNCTION F062
+
+INTEGER FUNCTION F063(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F063 = X + 63
+END FUNCTION F063
+
+INTEGER FUNCTION F064(X)
+    IMPLICIT NONE
+    INTEGER :: X
+    F064 = X + 64
+END FUNCTION F064
+
+SUBROUTINE S001(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = 1
+    CALL S002(S)
+END SUBROUTINE S001
+
+SUBROUTINE S002(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S003(S)
+END SUBROUTINE S002
+
+SUBROUTINE S003(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S004(S)
+END SUBROUTINE S003
+
+SUBROUTINE S004(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S005(S)
+END SUBROUTINE S004
+
+SUBROUTINE S005(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S006(S)
+END SUBROUTINE S005
+
+SUBROUTINE S006(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S007(S)
+END SUBROUTINE S006
+
+SUBROUTINE S007(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S008(S)
+END SUBROUTINE S007
+
+SUBROUTINE S008(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S009(S)
+END SUBROUTINE S008
+
+SUBROUTINE S009(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S010(S)
+END SUBROUTINE S009
+
+SUBROUTINE S010(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S011(S)
+END SUBROUTINE S010
+
+SUBROUTINE S011(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S012(S)
+END SUBROUTINE S011
+
+SUBROUTINE S012(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S013(S)
+END SUBROUTINE S012
+
+SUBROUTINE S013(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S014(S)
+END SUBROUTINE S013
+
+SUBROUTINE S014(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S015(S)
+END SUBROUTINE S014
+
+SUBROUTINE S015(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S016(S)
+END SUBROUTINE S015
+
+SUBROUTINE S016(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S017(S)
+END SUBROUTINE S016
+
+SUBROUTINE S017(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S018(S)
+END SUBROUTINE S017
+
+SUBROUTINE S018(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S019(S)
+END SUBROUTINE S018
+
+SUBROUTINE S019(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S020(S)
+END SUBROUTINE S019
+
+SUBROUTINE S020(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S021(S)
+END SUBROUTINE S020
+
+SUBROUTINE S021(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S022(S)
+END SUBROUTINE S021
+
+SUBROUTINE S022(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S023(S)
+END SUBROUTINE S022
+
+SUBROUTINE S023(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S024(S)
+END SUBROUTINE S023
+
+SUBROUTINE S024(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S025(S)
+END SUBROUTINE S024
+
+SUBROUTINE S025(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S026(S)
+END SUBROUTINE S025
+
+SUBROUTINE S026(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S027(S)
+END SUBROUTINE S026
+
+SUBROUTINE S027(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S028(S)
+END SUBROUTINE S027
+
+SUBROUTINE S028(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S029(S)
+END SUBROUTINE S028
+
+SUBROUTINE S029(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S030(S)
+END SUBROUTINE S029
+
+SUBROUTINE S030(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S031(S)
+END SUBROUTINE S030
+
+SUBROUTINE S031(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S032(S)
+END SUBROUTINE S031
+
+SUBROUTINE S032(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S033(S)
+END SUBROUTINE S032
+
+SUBROUTINE S033(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S034(S)
+END SUBROUTINE S033
+
+SUBROUTINE S034(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S035(S)
+END SUBROUTINE S034
+
+SUBROUTINE S035(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S036(S)
+END SUBROUTINE S035
+
+SUBROUTINE S036(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S037(S)
+END SUBROUTINE S036
+
+SUBROUTINE S037(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S038(S)
+END SUBROUTINE S037
+
+SUBROUTINE S038(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S039(S)
+END SUBROUTINE S038
+
+SUBROUTINE S039(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S040(S)
+END SUBROUTINE S039
+
+SUBROUTINE S040(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S041(S)
+END SUBROUTINE S040
+
+SUBROUTINE S041(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S042(S)
+END SUBROUTINE S041
+
+SUBROUTINE S042(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S043(S)
+END SUBROUTINE S042
+
+SUBROUTINE S043(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S044(S)
+END SUBROUTINE S043
+
+SUBROUTINE S044(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S045(S)
+END SUBROUTINE S044
+
+SUBROUTINE S045(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S046(S)
+END SUBROUTINE S045
+
+SUBROUTINE S046(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S047(S)
+END SUBROUTINE S046
+
+SUBROUTINE S047(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S048(S)
+END SUBROUTINE S047
+
+SUBROUTINE S048(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S049(S)
+END SUBROUTINE S048
+
+SUBROUTINE S049(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S050(S)
+END SUBROUTINE S049
+
+SUBROUTINE S050(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S051(S)
+END SUBROUTINE S050
+
+SUBROUTINE S051(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S052(S)
+END SUBROUTINE S051
+
+SUBROUTINE S052(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S053(S)
+END SUBROUTINE S052
+
+SUBROUTINE S053(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S054(S)
+END SUBROUTINE S053
+
+SUBROUTINE S054(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S055(S)
+END SUBROUTINE S054
+
+SUBROUTINE S055(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S056(S)
+END SUBROUTINE S055
+
+SUBROUTINE S056(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S057(S)
+END SUBROUTINE S056
+
+SUBROUTINE S057(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S058(S)
+END SUBROUTINE S057
+
+SUBROUTINE S058(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S059(S)
+END SUBROUTINE S058
+
+SUBROUTINE S059(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S060(S)
+END SUBROUTINE S059
+
+SUBROUTINE S060(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S061(S)
+END SUBROUTINE S060
+
+SUBROUTINE S061(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S062(S)
+END SUBROUTINE S061
+
+SUBROUTINE S062(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S063(S)
+END SUBROUTINE S062
+
+SUBROUTINE S063(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+    CALL S064(S)
+END SUBROUTINE S063
+
+SUBROUTINE S064(S)
+    IMPLICIT NONE
+    INTEGER :: S
+    S = S + 1
+END SUBROUTINE S064
@@ -0,0 +1,42 @@
+! <testinfo>
+! test_generator=config/mercurium-fortran
+! </testinfo>
+PROGRAM MAIN
+    IMPLICIT NONE
+    INTEGER :: I, J
+    INTEGER, PARAMETER :: N = 64
+    ! Constant arrays this large are folded in packed form
+    INTEGER, PARAMETER :: A(N) = (/ (I, I = 1, N) /)
+    REAL(KIND=8), PARAMETER :: D(N) = (/ (I * 0.5D0, I = 1, N) /)
+    INTEGER, PARAMETER :: M(N / 2, 2) = RESHAPE(A, (/ N / 2, 2 /))
+    INTEGER, PARAMETER :: MT(2, N / 2) = RESHAPE(A, (/ 2, N / 2 /), ORDER = (/ 2, 1 /))
+    INTEGER, PARAMETER :: S = SUM(A)
+    INTEGER, PARAMETER :: SM = SUM(M)
+    INTEGER, PARAMETER :: SE = SUM(A, MASK = MOD(A, 2) == 0)
+    INTEGER, PARAMETER :: SD(2) = SUM(M, DIM = 1)
+    REAL(KIND=8), PARAMETER :: DS = SUM(D)
+    INTEGER(KIND=8), PARAMETER :: P = PRODUCT(INT(A(1:16), KIND=8))
+    INTEGER, PARAMETER :: E(N / 2) = PACK(A, MOD(A, 2) == 0)
+    INTEGER, PARAMETER :: EV(N) = PACK(A, A > N / 2, A)
+
+    IF (S /= (N * (N + 1)) / 2) STOP 1
+    IF (SM /= S) STOP 2
+    IF (SE /= 2 * ((N / 2) * (N / 2 + 1)) / 2) STOP 3
+    IF (SD(1) /= ((N / 2) * (N / 2 + 1)) / 2) STOP 4
+    IF (SD(2) /= S - SD(1)) STOP 5
+    IF (DS /= 0.5D0 * S) STOP 6
+    IF (P /= 20922789888000_8) STOP 7
+
+    DO J = 1, 2
+        DO I = 1, N / 2
+            IF (M(I, J) /= A(I + (J - 1) * (N / 2))) STOP 8
+            IF (MT(J, I) /= A(I + (J - 1) * (N / 2))) STOP 9
+        END DO
+    END DO
+
+    DO I = 1, N / 2
+        IF (E(I) /= 2 * I) STOP 10
+        IF (EV(I) /= N / 2 + I) STOP 11
+        IF (EV(N / 2 + I) /= N / 2 + I) STOP 12
+    END DO
+END PROGRAM MAIN
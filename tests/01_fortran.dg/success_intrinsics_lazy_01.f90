@@ -0,0 +1,35 @@
+! <testinfo>
+! test_generator=config/mercurium-fortran
+! test_FFLAGS="--disable-intrinsics=dprod"
+! </testinfo>
+MODULE MOD_LAZY_01
+    USE, INTRINSIC :: ISO_C_BINDING, ONLY : C_INT
+    INTEGER(KIND=C_INT) :: N = 3
+CONTAINS
+    FUNCTION APPLY(F, X)
+        REAL(KIND=8) :: APPLY, X
+        INTERFACE
+            FUNCTION F(Y)
+                REAL(KIND=8) :: F, Y
+            END FUNCTION F
+        END INTERFACE
+        APPLY = F(X)
+    END FUNCTION APPLY
+
+    ! DPROD has been disabled so this is not the intrinsic
+    FUNCTION DPROD(A, B)
+        INTEGER :: DPROD, A, B
+        DPROD = A * B + 1
+    END FUNCTION DPROD
+END MODULE MOD_LAZY_01
+
+PROGRAM MAIN
+    USE MOD_LAZY_01
+    IMPLICIT NONE
+    INTRINSIC :: DABS, DSQRT
+
+    IF (APPLY(DABS, -2.0D0) /= 2.0D0) STOP 1
+    IF (APPLY(DSQRT, 4.0D0) /= 2.0D0) STOP 2
+    IF (ABS(-N) /= 3) STOP 3
+    IF (DPROD(2, 3) /= 7) STOP 4
+END PROGRAM MAIN
@@ -0,0 +1,65 @@
+/*
+<testinfo>
+test_generator=config/mercurium
+test_nolink=no
+test_ARGS='${tmpdir} ${test_CC}'
+</testinfo>
+*/
+
+/* Runs the compiler passed in the arguments with --jobs=2 on several files
+   and checks that every object is generated and that a failing file makes
+   the whole compilation fail */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void write_file(const char* dir, const char* name, const char* contents)
+{
+    char filename[1024];
+    snprintf(filename, sizeof(filename), "%s/%s", dir, name);
+
+    FILE* f = fopen(filename, "w");
+    if (f == NULL)
+        abort();
+    fputs(contents, f);
+    fclose(f);
+}
+
+static int run(const char* dir, const char* cc, const char* args)
+{
+    char command[8192];
+    snprintf(command, sizeof(command), "cd %s && %s %s", dir, cc, args);
+    return system(command);
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3)
+        return 1;
+
+    const char* dir = argv[1];
+
+    char cc[4096] = "";
+    int i;
+    for (i = 2; i < argc; i++)
+    {
+        strncat(cc, argv[i], sizeof(cc) - strlen(cc) - 2);
+        strcat(cc, " ");
+    }
+
+    write_file(dir, "jobs243_a.c", "int a(void) { return 1; }\n");
+    write_file(dir, "jobs243_b.c", "int b(void) { return 2; }\n");
+    write_file(dir, "jobs243_c.c", "int c(void) { return 3; }\n");
+    write_file(dir, "jobs243_d.c", "int d(void) { return undeclared; }\n");
+
+    if (run(dir, cc, "--jobs=2 -c jobs243_a.c jobs243_b.c jobs243_c.c") != 0)
+        return 2;
+
+    if (run(dir, "", "test -f jobs243_a.o && test -f jobs243_b.o && test -f jobs243_c.o") != 0)
+        return 3;
+
+    if (run(dir, cc, "--jobs=2 -c jobs243_a.c jobs243_d.c 2> /dev/null") == 0)
+        return 4;
+
+    return 0;
+}
@@ -0,0 +1,73 @@
+/*
+<testinfo>
+test_generator=config/mercurium
+test_nolink=no
+test_ARGS='${tmpdir} ${test_CC}'
+</testinfo>
+*/
+
+/* Runs the compiler passed in the arguments with and without
+   --debug-flags=benchmark_lexer and checks that the lexer is benchmarked and
+   that scanning the file once more does not change the generated code */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void write_file(const char* dir, const char* name, const char* contents)
+{
+    char filename[1024];
+    snprintf(filename, sizeof(filename), "%s/%s", dir, name);
+
+    FILE* f = fopen(filename, "w");
+    if (f == NULL)
+        abort();
+    fputs(contents, f);
+    fclose(f);
+}
+
+static int run(const char* dir, const char* cc, const char* args)
+{
+    char command[8192];
+    snprintf(command, sizeof(command), "cd %s && %s %s", dir, cc, args);
+    return system(command);
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3)
+        return 1;
+
+    const char* dir = argv[1];
+
+    char cc[4096] = "";
+    int i;
+    for (i = 2; i < argc; i++)
+    {
+        strncat(cc, argv[i], sizeof(cc) - strlen(cc) - 2);
+        strcat(cc, " ");
+    }
+
+    write_file(dir, "lexer244.h", "struct A { int x; };\n");
+    write_file(dir, "lexer244.c",
+            "#include <stdlib.h>\n"
+            "#include \"lexer244.h\"\n"
+            "int f(struct A* a)\n"
+            "{\n"
+            "    return a->x + abs(-1);\n"
+            "}\n");
+
+    if (run(dir, cc, "-y lexer244.c -o lexer244_plain.c") != 0)
+        return 2;
+
+    if (run(dir, cc, "--debug-flags=benchmark_lexer -y lexer244.c -o lexer244_benchmark.c "
+                "2> lexer244.err") != 0)
+        return 3;
+
+    if (run(dir, "", "grep -q \"File 'lexer244.c' .* scanned in .* tokens\" lexer244.err") != 0)
+        return 4;
+
+    if (run(dir, "", "cmp -s lexer244_plain.c lexer244_benchmark.c") != 0)
+        return 5;
+
+    return 0;
+}
@@ -0,0 +1,40 @@
+/*
+<testinfo>
+test_generator="config/mercurium"
+</testinfo>
+*/
+namespace N
+{
+    struct Base { };
+    void f(Base*);
+}
+
+namespace M
+{
+    struct D;
+    void g(D*);
+
+    template <typename T>
+    struct W { };
+    template <typename T>
+    void g(W<T>);
+}
+
+void h1(M::D* d, M::W<M::D> w)
+{
+    g(d);
+    g(w);
+}
+
+namespace M
+{
+    struct D : N::Base { };
+}
+
+void h2(M::D* d, M::W<M::D> w)
+{
+    // N is an associated namespace now that D has been completed
+    f(d);
+    g(d);
+    g(w);
+}
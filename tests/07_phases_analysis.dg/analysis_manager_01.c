@@ -0,0 +1,57 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2012 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+  
+  This file is part of Mercurium C/C++ source-to-source compiler.
+  
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+  
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+  
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+
+
+/*
+<testinfo>
+test_generator=config/mercurium-analysis
+test_CFLAGS="--test-function-phase --variable=analysis_manager_enabled:1"
+test_nolink=yes
+</testinfo>
+*/
+
+int a = 0;
+
+static void g(int x)
+{
+    a += x;
+}
+
+int f(int x)
+{
+    int i;
+    for (i = 0; i < x; i++)
+        g(i);
+    return a;
+}
+
+// The test phase modifies main, which keeps the analyses of f and g, and then
+// g, which discards those of f and main as they use the analyses of g
+int main()
+{
+    return f(10);
+}
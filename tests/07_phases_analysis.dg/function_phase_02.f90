@@ -0,0 +1,40 @@
+! <testinfo>
+! test_generator=config/mercurium-analysis
+! test_FFLAGS=--test-function-phase
+! test_nolink=yes
+! </testinfo>
+
+! The test phase modifies the internal subprograms and checks that the
+! modification reaches the top level function containing them
+MODULE M
+    IMPLICIT NONE
+CONTAINS
+    SUBROUTINE S(X)
+        INTEGER :: X
+
+        CALL INC(X)
+    CONTAINS
+        SUBROUTINE INC(Y)
+            INTEGER :: Y
+
+            Y = Y + 1
+        END SUBROUTINE INC
+    END SUBROUTINE S
+END MODULE M
+
+PROGRAM P
+    USE M
+    IMPLICIT NONE
+    INTEGER :: A
+
+    A = 0
+    CALL S(A)
+    CALL TWICE(A)
+    IF (A /= 3) STOP 1
+CONTAINS
+    SUBROUTINE TWICE(Z)
+        INTEGER :: Z
+
+        Z = Z + 2
+    END SUBROUTINE TWICE
+END PROGRAM P
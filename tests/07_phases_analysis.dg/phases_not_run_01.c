@@ -0,0 +1,101 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2012 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+  
+  This file is part of Mercurium C/C++ source-to-source compiler.
+  
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+  
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+  
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+
+
+/*
+<testinfo>
+test_generator=config/mercurium-analysis
+test_nolink=no
+test_ARGS='${tmpdir} ${test_CC}'
+</testinfo>
+*/
+
+/* Runs the compiler passed in the arguments with auto-scoping and checks
+   that -v reports the phase as not run only on the file without tasks */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void write_file(const char* dir, const char* name, const char* contents)
+{
+    char filename[1024];
+    snprintf(filename, sizeof(filename), "%s/%s", dir, name);
+
+    FILE* f = fopen(filename, "w");
+    if (f == NULL)
+        abort();
+    fputs(contents, f);
+    fclose(f);
+}
+
+static int run(const char* dir, const char* cc, const char* args)
+{
+    char command[8192];
+    snprintf(command, sizeof(command), "cd %s && %s %s", dir, cc, args);
+    return system(command);
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3)
+        return 1;
+
+    const char* dir = argv[1];
+
+    char cc[4096] = "";
+    int i;
+    for (i = 2; i < argc; i++)
+    {
+        strncat(cc, argv[i], sizeof(cc) - strlen(cc) - 2);
+        strcat(cc, " ");
+    }
+
+    write_file(dir, "without_task.c",
+            "int f(int x) { return x + 1; }\n");
+    write_file(dir, "with_task.c",
+            "int g(int x)\n"
+            "{\n"
+            "    #pragma omp task default(AUTO)\n"
+            "    x++;\n"
+            "    #pragma omp taskwait\n"
+            "    return x;\n"
+            "}\n");
+
+    if (run(dir, cc, "--openmp --auto-scope -v -y without_task.c -o without_task.out.c 2> without_task.log") != 0)
+        return 2;
+    if (run(dir, "", "grep -q \"^Phases not run on '.*without_task.c' since it has nothing they handle: "
+                ".*Automatically compute the scope of variables in OpenMP tasks\" without_task.log") != 0)
+        return 3;
+
+    if (run(dir, cc, "--openmp --auto-scope -v -y with_task.c -o with_task.out.c 2> with_task.log") != 0)
+        return 4;
+    if (run(dir, "", "grep -q \"^Phases not run on .*Automatically compute the scope of variables in OpenMP tasks\" "
+                "with_task.log") == 0)
+        return 5;
+
+    return 0;
+}
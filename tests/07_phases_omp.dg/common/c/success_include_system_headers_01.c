@@ -0,0 +1,61 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2013 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+  
+  This file is part of Mercurium C/C++ source-to-source compiler.
+  
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+  
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+  
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+/*
+<testinfo>
+test_generator=config/mercurium-omp
+test_CFLAGS=--include-system-headers
+</testinfo>
+*/
+
+#include <sys/types.h>
+#include <stdlib.h>
+
+// Headers in a subdirectory are included with the name written here and the
+// code that the OpenMP phase outlines still sees their declarations
+static ssize_t sum(const ssize_t *v, size_t n)
+{
+    ssize_t s = 0;
+    size_t i;
+#pragma omp parallel for reduction(+:s)
+    for (i = 0; i < n; i++)
+    {
+        s += v[i];
+    }
+    return s;
+}
+
+int main(int argc, char *argv[])
+{
+    ssize_t v[100];
+    size_t i;
+    for (i = 0; i < 100; i++)
+        v[i] = i;
+
+    if (sum(v, 100) != 4950)
+        abort();
+
+    return 0;
+}
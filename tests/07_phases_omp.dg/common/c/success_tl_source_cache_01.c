@@ -0,0 +1,80 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2012 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+  
+  This file is part of Mercurium C/C++ source-to-source compiler.
+  
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+  
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+  
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+/*
+<testinfo>
+test_generator=config/mercurium-omp
+</testinfo>
+*/
+
+#include <stdlib.h>
+
+// The lowering parses the same fragments for both functions, but 's' and 'v'
+// have different types in each of them. Reusing the parse tree of a fragment
+// must not reuse its meaning
+int f(int *v, int n)
+{
+    int s = 0;
+    int i;
+#pragma omp parallel for reduction(+:s) shared(v)
+    for (i = 0; i < n; i++)
+    {
+        s += v[i];
+    }
+    return s;
+}
+
+double g(double *v, int n)
+{
+    double s = 0.5;
+    int i;
+#pragma omp parallel for reduction(+:s) shared(v)
+    for (i = 0; i < n; i++)
+    {
+        s += v[i];
+    }
+    return s;
+}
+
+int main(int argc, char *argv[])
+{
+    int vi[100];
+    double vd[100];
+    int i;
+    for (i = 0; i < 100; i++)
+    {
+        vi[i] = i;
+        vd[i] = i + 0.25;
+    }
+
+    if (f(vi, 100) != 4950)
+        abort();
+
+    if (g(vd, 100) != 4975.5)
+        abort();
+
+    return 0;
+}
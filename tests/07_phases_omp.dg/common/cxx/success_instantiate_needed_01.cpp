@@ -0,0 +1,68 @@
+/*--------------------------------------------------------------------
+  (C) Copyright 2006-2012 Barcelona Supercomputing Center
+                          Centro Nacional de Supercomputacion
+  
+  This file is part of Mercurium C/C++ source-to-source compiler.
+  
+  See AUTHORS file in the top level directory for information
+  regarding developers and contributors.
+  
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 3 of the License, or (at your option) any later version.
+  
+  Mercurium C/C++ source-to-source compiler is distributed in the hope
+  that it will be useful, but WITHOUT ANY WARRANTY; without even the
+  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.  See the GNU Lesser General Public License for more
+  details.
+  
+  You should have received a copy of the GNU Lesser General Public
+  License along with Mercurium C/C++ source-to-source compiler; if
+  not, write to the Free Software Foundation, Inc., 675 Mass Ave,
+  Cambridge, MA 02139, USA.
+--------------------------------------------------------------------*/
+
+
+
+/*
+<testinfo>
+test_generator=config/mercurium-omp
+test_CXXFLAGS="--instantiate=needed"
+</testinfo>
+*/
+
+#include <stdlib.h>
+
+// No pragmas, left to the native compiler
+template <typename T>
+T twice(T t)
+{
+    return 2 * t;
+}
+
+// Has pragmas, instantiated so the OpenMP phases see it
+template <typename T>
+T sum_of_twice(int n)
+{
+    T s = 0;
+#pragma omp parallel for reduction(+:s)
+    for (int i = 0; i < n; i++)
+    {
+        s += twice(T(i));
+    }
+    return s;
+}
+
+int main(int argc, char *argv[])
+{
+    if (sum_of_twice<int>(100) != 9900)
+        abort();
+    if (sum_of_twice<long>(10) != 90)
+        abort();
+    if (twice(21.0) != 42.0)
+        abort();
+
+    return 0;
+}
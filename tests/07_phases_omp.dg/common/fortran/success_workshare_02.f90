@@ -0,0 +1,51 @@
+! <testinfo>
+! test_generator=config/mercurium-omp
+! compile_versions="single loops"
+! test_FFLAGS_loops="--variable=workshare_loops:1"
+! </testinfo>
+PROGRAM MAIN
+    IMPLICIT NONE
+    INTEGER, PARAMETER :: N = 100
+    REAL :: A(N), B(N), C(N)
+    REAL :: M(10, N), P(10, N)
+    INTEGER :: I, J
+
+    DO I = 1, N
+        A(I) = 0.0
+        B(I) = REAL(I)
+        C(I) = -REAL(I)
+        DO J = 1, 10
+            M(J, I) = REAL(J + I)
+            P(J, I) = 0.0
+        END DO
+    END DO
+
+    !$OMP PARALLEL
+    !$OMP WORKSHARE
+    ! Rank 1 with elemental intrinsics in the right hand side
+    A = SQRT(B) + ABS(C)
+    ! The assigned array appears as the same reference
+    B(2:N:2) = B(2:N:2) * 2.0
+    ! A transformational intrinsic is not evaluated for every element
+    C = B / SUM(B(1:10))
+    ! A single masked assignment
+    WHERE (B > 50.0) B = 50.0
+    ! Rank 2, distributed over the second dimension
+    P = M * 2.0 + 1.0
+    !$OMP END WORKSHARE
+    !$OMP END PARALLEL
+
+    DO I = 1, N
+        IF (ABS(A(I) - (SQRT(REAL(I)) + REAL(I))) > 1.0E-4) STOP 1
+        IF (MOD(I, 2) == 0) THEN
+            IF (ABS(C(I) - REAL(2 * I) / 85.0) > 1.0E-4) STOP 2
+            IF (B(I) /= MIN(REAL(2 * I), 50.0)) STOP 3
+        ELSE
+            IF (ABS(C(I) - REAL(I) / 85.0) > 1.0E-4) STOP 4
+            IF (B(I) /= MIN(REAL(I), 50.0)) STOP 5
+        END IF
+        DO J = 1, 10
+            IF (P(J, I) /= REAL(J + I) * 2.0 + 1.0) STOP 6
+        END DO
+    END DO
+END PROGRAM MAIN
@@ -0,0 +1,34 @@
+! <testinfo>
+! test_generator=config/mercurium-ompss
+! </testinfo>
+PROGRAM MAIN
+    IMPLICIT NONE
+    INTEGER, ALLOCATABLE :: A(:), B(:, :), C(:)
+    INTEGER :: I, J
+
+    ALLOCATE(A(2:11), B(3, 0:4), C(10))
+    A = 0
+    B = 0
+    C = 0
+
+    ! A and B only use their elements and bounds so they are passed by
+    ! their base address, C is queried so it keeps its descriptor
+    !$OMP TASK SHARED(A, B, C)
+    DO I = LBOUND(A, 1), UBOUND(A, 1)
+        A(I) = I
+    END DO
+    DO J = LBOUND(B, 2), UBOUND(B, 2)
+        B(:, J) = J
+    END DO
+    IF (ALLOCATED(C)) C = SIZE(A) + SIZE(B)
+    !$OMP END TASK
+    !$OMP TASKWAIT
+
+    DO I = 2, 11
+        IF (A(I) /= I) STOP 1
+    END DO
+    DO J = 0, 4
+        IF (ANY(B(:, J) /= J)) STOP 2
+    END DO
+    IF (ANY(C /= 25)) STOP 3
+END PROGRAM MAIN
@@ -0,0 +1,51 @@
+! <testinfo>
+! test_generator=(config/mercurium-ompss "config/mercurium-ompss-2 openmp-compatibility")
+! </testinfo>
+SUBROUTINE S(N, R, X, Y, A)
+    IMPLICIT NONE
+    INTEGER :: N, R
+    INTEGER, OPTIONAL :: X, Y
+    INTEGER, OPTIONAL :: A(:)
+
+    ! The optional dummies are only captured if they are present
+    !$OMP TASK SHARED(R, X) FIRSTPRIVATE(Y, A)
+    R = N
+    IF (PRESENT(X)) X = X + N
+    IF (PRESENT(Y)) R = R + Y
+    IF (PRESENT(A)) R = R + SUM(A) + LBOUND(A, 1) + UBOUND(A, 1)
+    !$OMP END TASK
+    !$OMP TASKWAIT
+END SUBROUTINE S
+
+PROGRAM MAIN
+    IMPLICIT NONE
+    INTERFACE
+        SUBROUTINE S(N, R, X, Y, A)
+            INTEGER :: N, R
+            INTEGER, OPTIONAL :: X, Y
+            INTEGER, OPTIONAL :: A(:)
+        END SUBROUTINE S
+    END INTERFACE
+    INTEGER :: R, X
+    INTEGER :: A(3)
+
+    A = (/ 1, 2, 3 /)
+    X = 1
+
+    CALL S(10, R)
+    IF (R /= 10) STOP 1
+
+    CALL S(10, R, X)
+    IF (R /= 10) STOP 2
+    IF (X /= 11) STOP 3
+
+    CALL S(10, R, Y=5)
+    IF (R /= 15) STOP 4
+
+    CALL S(10, R, A=A)
+    IF (R /= 10 + 6 + 1 + 3) STOP 5
+
+    CALL S(10, R, X, 5, A)
+    IF (R /= 10 + 5 + 6 + 1 + 3) STOP 6
+    IF (X /= 21) STOP 7
+END PROGRAM MAIN